@@ -25,12 +25,16 @@
 #include <librepcb/common/application.h>
 #include <librepcb/common/attributes/attributesubstitutor.h>
 #include <librepcb/common/debug.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/font/strokefontcache.h>
+#include <librepcb/common/profiler.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/boardgerberexport.h>
 #include <librepcb/project/erc/ercmsg.h>
 #include <librepcb/project/erc/ercmsglist.h>
 #include <librepcb/project/project.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -58,6 +62,9 @@ int CommandLineInterface::execute() noexcept {
       {"open-project",
        {tr("Open a project to execute project-related tasks."),
         tr("open-project [command_options]")}},
+      {"open-projects",
+       {tr("Open many projects in parallel to execute project-related tasks."),
+        tr("open-projects [command_options]")}},
   };
 
   // Add global options
@@ -67,6 +74,13 @@ int CommandLineInterface::execute() noexcept {
   const QCommandLineOption versionOption = parser.addVersionOption();
   QCommandLineOption       verboseOption("verbose", tr("Verbose output."));
   parser.addOption(verboseOption);
+  QCommandLineOption profileOption(
+      "profile",
+      tr("Record timings and memory usage of all operations and write them "
+         "as Chrome trace JSON to the given file. Existing files will be "
+         "overwritten."),
+      tr("file"));
+  parser.addOption(profileOption);
   parser.addPositionalArgument("command", tr("The command to execute."));
 
   // Define options for "open-project"
@@ -95,6 +109,23 @@ int CommandLineInterface::execute() noexcept {
       "save",
       tr("Save project before closing it (useful to upgrade file format)."));
 
+  // Define additional options for "open-projects"
+  QCommandLineOption manifestOption(
+      "manifest",
+      tr("Text file containing paths or wildcard patterns of project files, "
+         "one per line. Relative paths are relative to the manifest file."),
+      tr("file"));
+  QCommandLineOption jobsOption(
+      "jobs",
+      tr("Maximum number of projects processed in parallel. Defaults to the "
+         "number of CPU cores."),
+      tr("count"));
+  QCommandLineOption reportOption(
+      "report",
+      tr("Write the results and timings of all projects as JSON to the given "
+         "file. Existing files will be overwritten."),
+      tr("file"));
+
   // First parse to get the supplied command (ignoring errors because the parser
   // does not yet know the command-dependent options).
   parser.parse(mApp.arguments());
@@ -117,6 +148,21 @@ int CommandLineInterface::execute() noexcept {
     parser.addOption(exportPcbFabricationDataOption);
     parser.addOption(boardOption);
     parser.addOption(saveOption);
+  } else if (command == "open-projects") {
+    parser.clearPositionalArguments();
+    parser.addPositionalArgument(command, commands[command].first,
+                                 commands[command].second);
+    parser.addPositionalArgument(
+        "projects",
+        tr("Paths or wildcard patterns of project files (*.lpp)."),
+        tr("[projects...]"));
+    parser.addOption(ercOption);
+    parser.addOption(exportPcbFabricationDataOption);
+    parser.addOption(boardOption);
+    parser.addOption(saveOption);
+    parser.addOption(manifestOption);
+    parser.addOption(jobsOption);
+    parser.addOption(reportOption);
   } else if (!command.isEmpty()) {
     printErr(QString(tr("Unknown command '%1'.")).arg(command), 2);
     print(parser.helpText(), 0);
@@ -159,6 +205,11 @@ int CommandLineInterface::execute() noexcept {
     Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::All);
   }
 
+  // --profile
+  if (parser.isSet(profileOption)) {
+    Profiler::instance().setEnabled(true);
+  }
+
   // Execute command
   bool cmdSuccess = false;
   if (command == "open-project") {
@@ -176,9 +227,56 @@ int CommandLineInterface::execute() noexcept {
         parser.values(boardOption),           // boards
         parser.isSet(saveOption)              // save project
     );
+  } else if (command == "open-projects") {
+    // Note: Options with values were not known yet when parsing the
+    // positional arguments above, so take them from the final parser state.
+    QStringList projectPatterns = parser.positionalArguments().mid(1);
+    if (projectPatterns.isEmpty() && (!parser.isSet(manifestOption))) {
+      printErr(tr("Wrong argument count."), 2);
+      print(parser.helpText(), 0);
+      return 1;
+    }
+    bool jobsValid = true;
+    int  jobs      = QThread::idealThreadCount();
+    if (parser.isSet(jobsOption)) {
+      jobs = parser.value(jobsOption).toInt(&jobsValid);
+    }
+    if ((!jobsValid) || (jobs < 1)) {
+      printErr(QString(tr("Invalid number of jobs: '%1'"))
+                   .arg(parser.value(jobsOption)),
+               2);
+      print(parser.helpText(), 0);
+      return 1;
+    }
+    cmdSuccess = openProjects(
+        projectPatterns,               // project filepaths or patterns
+        parser.value(manifestOption),  // manifest filepath
+        parser.isSet(ercOption),       // run ERC
+        parser.isSet(
+            exportPcbFabricationDataOption),  // export PCB fabrication data
+        parser.values(boardOption),           // boards
+        parser.isSet(saveOption),             // save project
+        jobs,                                 // max. parallel jobs
+        parser.value(reportOption)            // report filepath
+    );
   } else {
     printErr(tr("Internal failure."));
   }
+
+  // Write profile
+  if (parser.isSet(profileOption)) {
+    QString profileFile = parser.value(profileOption);
+    try {
+      FilePath profileFp(QFileInfo(profileFile).absoluteFilePath());
+      print(QString(tr("Write profile to '%1'..."))
+                .arg(prettyPath(profileFp, profileFile)));
+      Profiler::instance().saveChromeTrace(profileFp);  // can throw
+    } catch (const Exception& e) {
+      printErr(QString(tr("ERROR: %1")).arg(e.getMsg()));
+      cmdSuccess = false;
+    }
+  }
+
   if (cmdSuccess) {
     print(tr("SUCCESS"));
     return 0;
@@ -204,7 +302,10 @@ bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
     FilePath projectFp(QFileInfo(projectFile).absoluteFilePath());
     print(QString(tr("Open project '%1'..."))
               .arg(prettyPath(projectFp, projectFile)));
-    Project project(projectFp, !save, false);  // can throw
+    // Graphics items are only needed to render schematics, so skip creating
+    // them otherwise to speed up loading the project.
+    bool    headless = exportSchematicsFiles.isEmpty();
+    Project project(projectFp, !save, false, headless);  // can throw
 
     // ERC
     if (runErc) {
@@ -216,17 +317,7 @@ bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
         if (msg->isIgnored()) {
           ++approvedMsgCount;
         } else {
-          QString severity;
-          switch (msg->getMsgType()) {
-            case ErcMsg::ErcMsgType_t::CircuitWarning:
-            case ErcMsg::ErcMsgType_t::SchematicWarning:
-            case ErcMsg::ErcMsgType_t::BoardWarning:
-              severity = tr("WARNING");
-              break;
-            default:
-              severity = tr("ERROR");
-              break;
-          }
+          QString severity = isErcWarning(*msg) ? tr("WARNING") : tr("ERROR");
           messages.append(
               QString("    - [%1] %2").arg(severity, msg->getMsg()));
         }
@@ -317,6 +408,280 @@ bool CommandLineInterface::openProject(const QString& projectFile, bool runErc,
   }
 }
 
+bool CommandLineInterface::openProjects(const QStringList& projectFiles,
+                                        const QString&     manifestFile,
+                                        bool               runErc,
+                                        bool exportPcbFabricationData,
+                                        const QStringList& boards, bool save,
+                                        int            jobs,
+                                        const QString& reportFile) const
+    noexcept {
+  QElapsedTimer timer;
+  timer.start();
+  bool success = true;
+
+  // Collect all project files (with the style to print their paths)
+  QList<QPair<QString, FilePath>> patterns;  // pattern, base directory
+  FilePath                        currentDir(QDir::currentPath());
+  foreach (const QString& pattern, projectFiles) {
+    patterns.append(qMakePair(pattern, currentDir));
+  }
+  if (!manifestFile.isEmpty()) {
+    try {
+      FilePath manifestFp(QFileInfo(manifestFile).absoluteFilePath());
+      QString  content =
+          QString::fromUtf8(FileUtils::readFile(manifestFp));  // can throw
+      foreach (QString line, content.split('\n')) {
+        line = line.trimmed();
+        if ((!line.isEmpty()) && (!line.startsWith('#'))) {
+          patterns.append(qMakePair(line, manifestFp.getParentDir()));
+        }
+      }
+    } catch (const Exception& e) {
+      printErr(QString(tr("ERROR: %1")).arg(e.getMsg()));
+      return false;
+    }
+  }
+  QList<FilePath>          projectFps;
+  QHash<FilePath, QString> projectFpStyles;
+  for (auto it = patterns.constBegin(); it != patterns.constEnd(); ++it) {
+    QList<FilePath> fps;
+    try {
+      fps = findProjectFiles(it->first, it->second);  // can throw
+    } catch (const Exception& e) {
+      printErr(QString(tr("ERROR: %1")).arg(e.getMsg()));
+    }
+    if (fps.isEmpty()) {
+      printErr(QString(tr("ERROR: No project files found for '%1'."))
+                   .arg(it->first));
+      success = false;
+    }
+    foreach (const FilePath& fp, fps) {
+      if (!projectFpStyles.contains(fp)) {
+        projectFps.append(fp);
+        projectFpStyles.insert(fp, it->first);
+      }
+    }
+  }
+
+  // Process all projects in parallel. A dedicated thread pool is used since
+  // projects run parallel jobs in the global thread pool and wait for them,
+  // which could dead-lock if all threads of the global pool were busy with
+  // processing projects.
+  print(QString(tr("Process %1 project(s) with up to %2 parallel job(s)..."))
+            .arg(projectFps.count())
+            .arg(jobs));
+  // Projects usually contain the same stroke fonts, so they are loaded only
+  // once for all projects.
+  StrokeFontCache             fontCache;
+  QThreadPool                 pool;
+  QList<QFuture<BatchResult>> futures;
+  pool.setMaxThreadCount(jobs);
+  foreach (const FilePath& fp, projectFps) {
+    futures.append(QtConcurrent::run(&pool, [=, &fontCache]() {
+      return processProject(fp, runErc, exportPcbFabricationData, boards, save,
+                            fontCache);
+    }));
+  }
+
+  // Print the results in the order of the projects, as soon as available
+  QJsonArray projectsJson;
+  int        successfulProjects = 0;
+  foreach (const QFuture<BatchResult>& future, futures) {
+    const BatchResult result = future.result();
+    const QString&    style  = projectFpStyles.value(result.projectFile);
+    print(QString(tr("Project '%1':"))
+              .arg(prettyPath(result.projectFile, style)));
+    QJsonArray ercJson;
+    if (runErc) {
+      print("  " % QString(tr("Approved messages: %1"))
+                       .arg(result.approvedErcMsgCount));
+      print("  " % QString(tr("Non-approved messages: %1"))
+                       .arg(result.ercMessages.count()));
+      for (const auto& msg : result.ercMessages) {
+        QString severity = msg.first ? tr("WARNING") : tr("ERROR");
+        printErr(QString("    - [%1] %2").arg(severity, msg.second));
+        QJsonObject msgJson;
+        msgJson["severity"] = msg.first ? "warning" : "error";
+        msgJson["message"]  = msg.second;
+        ercJson.append(msgJson);
+      }
+    }
+    QJsonArray filesJson;
+    foreach (const FilePath& fp, result.writtenFiles) {
+      print(QString("  => '%1'").arg(prettyPath(fp, style)));
+      filesJson.append(fp.toStr());
+    }
+    foreach (const QString& error, result.errors) {
+      printErr("  " % QString(tr("ERROR: %1")).arg(error));
+    }
+    print("  " % QString(tr("Finished in %1 ms.")).arg(result.totalTimeMs));
+    if (result.isSuccessful()) {
+      ++successfulProjects;
+    } else {
+      success = false;
+    }
+
+    QJsonObject timesJson;
+    timesJson["load"]   = result.loadTimeMs;
+    timesJson["erc"]    = result.ercTimeMs;
+    timesJson["export"] = result.exportTimeMs;
+    timesJson["save"]   = result.saveTimeMs;
+    timesJson["total"]  = result.totalTimeMs;
+    QJsonObject projectJson;
+    projectJson["project"]               = result.projectFile.toStr();
+    projectJson["success"]               = result.isSuccessful();
+    projectJson["errors"]                = QJsonArray::fromStringList(
+        result.errors);
+    projectJson["approved_erc_messages"] = result.approvedErcMsgCount;
+    projectJson["erc_messages"]          = ercJson;
+    projectJson["written_files"]         = filesJson;
+    projectJson["times_ms"]              = timesJson;
+    projectsJson.append(projectJson);
+  }
+  print(QString(tr("%1 of %2 project(s) succeeded in %3 ms."))
+            .arg(successfulProjects)
+            .arg(projectFps.count())
+            .arg(timer.elapsed()));
+
+  // Write report
+  if (!reportFile.isEmpty()) {
+    QJsonObject reportJson;
+    reportJson["success"]  = success;
+    reportJson["jobs"]     = jobs;
+    reportJson["time_ms"]  = timer.elapsed();
+    reportJson["projects"] = projectsJson;
+    try {
+      FilePath reportFp(QFileInfo(reportFile).absoluteFilePath());
+      print(QString(tr("Write report to '%1'..."))
+                .arg(prettyPath(reportFp, reportFile)));
+      FileUtils::writeFile(reportFp,
+                           QJsonDocument(reportJson).toJson());  // can throw
+    } catch (const Exception& e) {
+      printErr(QString(tr("ERROR: %1")).arg(e.getMsg()));
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+CommandLineInterface::BatchResult CommandLineInterface::processProject(
+    const FilePath& projectFp, bool runErc, bool exportPcbFabricationData,
+    const QStringList& boards, bool save, StrokeFontCache& fontCache) noexcept {
+  // Note: This method is called in a worker thread!
+  BatchResult result;
+  result.projectFile         = projectFp;
+  result.approvedErcMsgCount = 0;
+  result.loadTimeMs          = 0;
+  result.ercTimeMs           = 0;
+  result.exportTimeMs        = 0;
+  result.saveTimeMs          = 0;
+  QElapsedTimer totalTimer;
+  totalTimer.start();
+  try {
+    // Open project (without graphics since nothing needs to be rendered)
+    QElapsedTimer timer;
+    timer.start();
+    Project project(projectFp, !save, false, true, &fontCache);  // can throw
+    result.loadTimeMs = timer.elapsed();
+
+    // ERC
+    if (runErc) {
+      timer.start();
+      foreach (const ErcMsg* msg, project.getErcMsgList().getItems()) {
+        if (!msg->isVisible()) continue;
+        if (msg->isIgnored()) {
+          ++result.approvedErcMsgCount;
+        } else {
+          result.ercMessages.append(
+              qMakePair(isErcWarning(*msg), msg->getMsg()));
+        }
+      }
+      std::sort(result.ercMessages.begin(), result.ercMessages.end());
+      result.ercTimeMs = timer.elapsed();
+    }
+
+    // Export PCB fabrication data
+    if (exportPcbFabricationData) {
+      timer.start();
+      QList<Board*> boardList;
+      if (boards.isEmpty()) {
+        boardList = project.getBoards();
+      } else {
+        foreach (const QString& boardName, boards) {
+          Board* board = project.getBoardByName(boardName);
+          if (board) {
+            boardList.append(board);
+          } else {
+            result.errors.append(
+                QString(tr("No board with the name '%1' found."))
+                    .arg(boardName));
+          }
+        }
+      }
+      foreach (const Board* board, boardList) {
+        BoardGerberExport grbExport(*board);
+        grbExport.exportAllLayers();  // can throw
+        foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
+          if (result.writtenFiles.contains(fp)) {
+            result.errors.append(
+                QString(tr("The file '%1' was written multiple times. Please "
+                           "make sure that every board uses a different "
+                           "fabrication output path."))
+                    .arg(fp.toNative()));
+          } else {
+            result.writtenFiles.append(fp);
+          }
+        }
+      }
+      result.exportTimeMs = timer.elapsed();
+    }
+
+    // Save project
+    if (save) {
+      timer.start();
+      project.save(false);  // can throw
+      project.save(true);   // can throw
+      result.saveTimeMs = timer.elapsed();
+    }
+  } catch (const Exception& e) {
+    result.errors.append(e.getMsg());
+  }
+  result.totalTimeMs = totalTimer.elapsed();
+  return result;
+}
+
+QList<FilePath> CommandLineInterface::findProjectFiles(
+    const QString& pattern, const FilePath& baseDir) {
+  // Wildcards are supported in the filename only, not in directory names
+  FilePath fp(QFileInfo(QDir(baseDir.toStr()), pattern).absoluteFilePath());
+  if (!pattern.contains(QRegularExpression("[*?\\[]"))) {
+    return fp.isExistingFile() ? QList<FilePath>{fp} : QList<FilePath>();
+  }
+  FilePath dir = fp.getParentDir();
+  if (!dir.isExistingDir()) {
+    return QList<FilePath>();
+  }
+  QList<FilePath> fps = FileUtils::getFilesInDirectory(
+      dir, {fp.getFilename()});  // can throw
+  std::sort(fps.begin(), fps.end(), [](const FilePath& a, const FilePath& b) {
+    return a.toStr() < b.toStr();
+  });
+  return fps;
+}
+
+bool CommandLineInterface::isErcWarning(const ErcMsg& msg) noexcept {
+  switch (msg.getMsgType()) {
+    case ErcMsg::ErcMsgType_t::CircuitWarning:
+    case ErcMsg::ErcMsgType_t::SchematicWarning:
+    case ErcMsg::ErcMsgType_t::BoardWarning:
+      return true;
+    default:
+      return false;
+  }
+}
+
 QString CommandLineInterface::prettyPath(const FilePath& path,
                                          const QString&  style) noexcept {
   return QFileInfo(style).isRelative()
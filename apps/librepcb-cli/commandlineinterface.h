@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/common/fileio/filepath.h>
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -31,7 +33,11 @@
 namespace librepcb {
 
 class Application;
-class FilePath;
+class StrokeFontCache;
+
+namespace project {
+class ErcMsg;
+}
 
 namespace cli {
 
@@ -54,11 +60,42 @@ public:
   // General Methods
   int execute() noexcept;
 
+private:  // Types
+  /// Result of processing a single project in batch mode
+  struct BatchResult {
+    FilePath                    projectFile;
+    QStringList                 errors;  ///< Translated error messages
+    int                         approvedErcMsgCount;
+    QList<QPair<bool, QString>> ercMessages;  ///< Non-approved (bool: warning)
+    QList<FilePath>             writtenFiles;
+    qint64                      loadTimeMs;    ///< Opening the project
+    qint64                      ercTimeMs;     ///< Running the ERC
+    qint64                      exportTimeMs;  ///< Exporting fabrication data
+    qint64                      saveTimeMs;    ///< Saving the project
+    qint64                      totalTimeMs;   ///< Until the project was closed
+
+    bool isSuccessful() const noexcept {
+      return errors.isEmpty() && ercMessages.isEmpty();
+    }
+  };
+
 private:  // Methods
   bool           openProject(const QString& projectFile, bool runErc,
                              const QStringList& exportSchematicsFiles,
                              bool exportPcbFabricationData, const QStringList& boards,
                              bool save) const noexcept;
+  bool openProjects(const QStringList& projectFiles,
+                    const QString& manifestFile, bool runErc,
+                    bool exportPcbFabricationData, const QStringList& boards,
+                    bool save, int jobs, const QString& reportFile) const
+      noexcept;
+  static BatchResult processProject(const FilePath& projectFp, bool runErc,
+                                    bool               exportPcbFabricationData,
+                                    const QStringList& boards, bool save,
+                                    StrokeFontCache&   fontCache) noexcept;
+  static QList<FilePath> findProjectFiles(const QString&  pattern,
+                                          const FilePath& baseDir);
+  static bool    isErcWarning(const project::ErcMsg& msg) noexcept;
   static QString prettyPath(const FilePath& path,
                             const QString&  style) noexcept;
   static void    print(const QString& str, int newlines = 1) noexcept;
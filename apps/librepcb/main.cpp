@@ -27,6 +27,7 @@
 #include <librepcb/common/debug.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/network/networkaccessmanager.h>
+#include <librepcb/common/profiler.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/workspace.h>
 
@@ -48,6 +49,8 @@ using namespace librepcb::application;
 static void     setApplicationMetadata() noexcept;
 static void     configureApplicationSettings() noexcept;
 static void     writeLogHeader() noexcept;
+static FilePath startProfiler() noexcept;
+static void     writeProfile(const FilePath& filepath) noexcept;
 static void     installTranslations() noexcept;
 static void     init3rdPartyLibs() noexcept;
 static void     cleanup3rdPartyLibs() noexcept;
@@ -81,6 +84,9 @@ int main(int argc, char* argv[]) {
   // Write some information about the application instance to the log.
   writeLogHeader();
 
+  // Start recording timings if requested by the environment
+  FilePath profileFilePath = startProfiler();
+
   // Install translation files. This must be done before any widget is shown.
   installTranslations();
 
@@ -122,6 +128,9 @@ int main(int argc, char* argv[]) {
   // Cleanup all 3rd party libraries
   cleanup3rdPartyLibs();
 
+  // Write recorded timings, if any
+  writeProfile(profileFilePath);
+
   qDebug() << "Exit application with code" << retval;
   return retval;
 }
@@ -182,6 +191,36 @@ static void writeLogHeader() noexcept {
                  .arg(FilePath(QSettings().fileName()).toNative());
 }
 
+/*******************************************************************************
+ *  startProfiler() / writeProfile()
+ ******************************************************************************/
+
+static FilePath startProfiler() noexcept {
+  // Record timings and memory usage of expensive operations if the environment
+  // variable "LIBREPCB_PROFILE" is set to the output file path. The file can
+  // be viewed with "chrome://tracing" or https://ui.perfetto.dev/.
+  QString profileFile = qgetenv("LIBREPCB_PROFILE");
+  if (profileFile.isEmpty()) {
+    return FilePath();
+  }
+  FilePath filepath(QFileInfo(profileFile).absoluteFilePath());
+  Profiler::instance().setEnabled(true);
+  qInfo() << "Recording profile to" << filepath.toNative();
+  return filepath;
+}
+
+static void writeProfile(const FilePath& filepath) noexcept {
+  if (!filepath.isValid()) {
+    return;
+  }
+  try {
+    Profiler::instance().saveChromeTrace(filepath);  // can throw
+    qInfo() << "Wrote profile to" << filepath.toNative();
+  } catch (const Exception& e) {
+    qCritical() << "Could not write profile:" << e.getMsg();
+  }
+}
+
 /*******************************************************************************
  *  installTranslations()
  ******************************************************************************/
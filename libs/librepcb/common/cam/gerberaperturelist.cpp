@@ -49,9 +49,8 @@ QString GerberApertureList::generateString() const noexcept {
   foreach (const QString& macro, mApertureMacros) {
     str.append(QString("%AM%1*%\n").arg(macro));
   }
-  foreach (int number, mApertures.keys()) {
-    str.append(
-        QString("%ADD%1%2*%\n").arg(number).arg(mApertures.value(number)));
+  for (int i = 0; i < mApertures.count(); ++i) {
+    str.append(QString("%ADD%1%2*%\n").arg(i + 10).arg(mApertures.at(i)));
   }
   str.append("G04 --- APERTURE LIST END --- *\n");
   return str;
@@ -121,6 +120,7 @@ int GerberApertureList::setRegularPolygon(const UnsignedLength& dia, int n,
 void GerberApertureList::reset() noexcept {
   // mApertureMacros.clear();
   mApertures.clear();
+  mApertureNumbers.clear();
 }
 
 /*******************************************************************************
@@ -128,12 +128,13 @@ void GerberApertureList::reset() noexcept {
  ******************************************************************************/
 
 int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept {
-  int number = mApertures.key(aperture, -1);
-  if (number < 0) {
-    number = mApertures.count() + 10;  // 10 is the number of the first aperture
-    Q_ASSERT(!mApertures.contains(number));
-    mApertures.insert(number, aperture);
+  auto it = mApertureNumbers.constFind(aperture);
+  if (it != mApertureNumbers.constEnd()) {
+    return it.value();
   }
+  int number = mApertures.count() + 10;  // 10 is the first aperture number
+  mApertures.append(aperture);
+  mApertureNumbers.insert(aperture, number);
   return number;
 }
 
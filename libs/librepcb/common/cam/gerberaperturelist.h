@@ -100,8 +100,9 @@ private:
                                         const UnsignedLength& hole) noexcept;
 
   QList<QString> mApertureMacros;
-  QMap<int, QString>
-      mApertures;  ///< key: aperture number (>= 10); value: aperture definition
+  QList<QString> mApertures;  ///< index: aperture number - 10
+  QHash<QString, int>
+      mApertureNumbers;  ///< key: aperture definition; value: aperture number
 };
 
 /*******************************************************************************
@@ -48,12 +48,32 @@ GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
     mContent(),
     mApertureList(new GerberApertureList()),
     mCurrentApertureNumber(-1),
-    mMultiQuadrantArcModeOn(false) {
+    mMultiQuadrantArcModeOn(false),
+    mContentFile(),
+    mContentFileError(false) {
 }
 
 GerberGenerator::~GerberGenerator() noexcept {
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void GerberGenerator::enableStreaming() {
+  if (mContentFile) {
+    return;
+  }
+  QScopedPointer<QTemporaryFile> file(new QTemporaryFile());
+  if (!file->open()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString(tr("Could not create temporary file: %1"))
+                           .arg(file->errorString()));
+  }
+  mContentFile.reset(file.take());
+  flushContent();  // move already plotted content into the file
+}
+
 /*******************************************************************************
  *  Plot Methods
  ******************************************************************************/
@@ -61,10 +81,10 @@ GerberGenerator::~GerberGenerator() noexcept {
 void GerberGenerator::setLayerPolarity(LayerPolarity p) noexcept {
   switch (p) {
     case LayerPolarity::Positive:
-      mContent.append("%LPD*%\n");
+      appendContent("%LPD*%\n");
       break;
     case LayerPolarity::Negative:
-      mContent.append("%LPC*%\n");
+      appendContent("%LPC*%\n");
       break;
     default:
       qCritical() << "Invalid Layer Polarity:" << static_cast<int>(p);
@@ -197,73 +217,118 @@ void GerberGenerator::reset() noexcept {
   mContent.clear();
   mApertureList->reset();
   mCurrentApertureNumber = -1;
+  if (mContentFile) {
+    mContentFile->resize(0);
+    mContentFile->seek(0);
+    mContentFileError = false;
+  }
 }
 
 void GerberGenerator::generate() {
   mOutput.clear();
   printHeader();
   printApertureList();
-  printContent();
-  printFooter();
+  if (mContentFile) {
+    // the content and the footer will be written by saveToFile()
+    flushContent();
+    if (mContentFileError) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          QString(tr("Could not write to temporary file \"%1\": %2"))
+              .arg(mContentFile->fileName(), mContentFile->errorString()));
+    }
+  } else {
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    writeOutput(buffer);  // can't fail, writes into memory
+    mOutput = QString::fromLatin1(buffer.data());
+  }
 }
 
 void GerberGenerator::saveToFile(const FilePath& filepath) const {
-  FileUtils::writeFile(filepath, mOutput.toLatin1());  // can throw
+  if (mContentFile) {
+    FileUtils::writeFile(filepath, [&](QIODevice& device) {
+      if (!writeOutput(device)) {
+        throw RuntimeError(__FILE__, __LINE__,
+                           QString(tr("Could not write to file \"%1\": %2"))
+                               .arg(filepath.toNative(), device.errorString()));
+      }
+    });  // can throw
+  } else {
+    FileUtils::writeFile(filepath, mOutput.toLatin1());  // can throw
+  }
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+void GerberGenerator::appendContent(const QString& str) noexcept {
+  mContent.append(str);
+  if (mContentFile && (mContent.size() >= sContentBufferSize)) {
+    flushContent();
+  }
+}
+
+void GerberGenerator::flushContent() noexcept {
+  if (mContentFile && (!mContent.isEmpty())) {
+    QByteArray data = mContent.toLatin1();
+    if (mContentFile->write(data) != data.size()) {
+      mContentFileError = true;
+    }
+    mContent.resize(0);  // keeps the allocated memory for the next chunk
+  }
+}
+
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    appendContent(QString("D%1*\n").arg(number));
     mCurrentApertureNumber = number;
   }
 }
 
 void GerberGenerator::setRegionModeOn() noexcept {
-  mContent.append("G36*\n");
+  appendContent("G36*\n");
 }
 
 void GerberGenerator::setRegionModeOff() noexcept {
-  mContent.append("G37*\n");
+  appendContent("G37*\n");
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOn() noexcept {
   if (!mMultiQuadrantArcModeOn) {
-    mContent.append("G75*\n");
+    appendContent("G75*\n");
     mMultiQuadrantArcModeOn = true;
   }
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOff() noexcept {
   if (mMultiQuadrantArcModeOn) {
-    mContent.append("G74*\n");
+    appendContent("G74*\n");
     mMultiQuadrantArcModeOn = false;
   }
 }
 
 void GerberGenerator::switchToLinearInterpolationModeG01() noexcept {
-  mContent.append("G01*\n");
+  appendContent("G01*\n");
 }
 
 void GerberGenerator::switchToCircularCwInterpolationModeG02() noexcept {
-  mContent.append("G02*\n");
+  appendContent("G02*\n");
 }
 
 void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
-  mContent.append("G03*\n");
+  appendContent("G03*\n");
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D02*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D01*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
@@ -273,14 +338,14 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start,
   if (!mMultiQuadrantArcModeOn) {
     diff.makeAbs();  // no sign allowed in single quadrant mode!
   }
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  appendContent(QString("X%1Y%2I%3J%4D01*\n")
+                    .arg(end.getX().toNmString(), end.getY().toNmString(),
+                         diff.getX().toNmString(), diff.getY().toNmString()));
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D03*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
 void GerberGenerator::printHeader() noexcept {
@@ -323,26 +388,32 @@ void GerberGenerator::printApertureList() noexcept {
   mOutput.append(mApertureList->generateString());
 }
 
-void GerberGenerator::printContent() noexcept {
-  mOutput.append("G04 --- BOARD BEGIN --- *\n");
-  mOutput.append(mContent);
-  mOutput.append("G04 --- BOARD END --- *\n");
-}
-
-void GerberGenerator::printFooter() noexcept {
-  // MD5 checksum over content
-  mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
-
-  // end of file
-  mOutput.append("M02*\n");
-}
+bool GerberGenerator::writeOutput(QIODevice& device) const noexcept {
+  // header and aperture list (already in #mOutput), content and footer are
+  // written in chunks while the MD5 checksum is calculated on the fly
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  bool               success =
+      writeChunk(device, &hash, mOutput % "G04 --- BOARD BEGIN --- *\n");
+  if (mContentFile) {
+    mContentFile->seek(0);
+    while (success && (!mContentFile->atEnd())) {
+      QByteArray chunk = mContentFile->read(sContentBufferSize);
+      if (chunk.isEmpty()) {
+        success = false;  // read error
+      } else {
+        success = writeChunk(device, &hash, QString::fromLatin1(chunk));
+      }
+    }
+    mContentFile->seek(mContentFile->size());  // allow to continue plotting
+  } else {
+    success = success && writeChunk(device, &hash, mContent);
+  }
+  success = success && writeChunk(device, &hash, "G04 --- BOARD END --- *\n");
 
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
-  // according to the RS-274C standard, linebreaks are not included in the
-  // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  // footer: MD5 checksum over everything above, and end of file
+  QString md5 = QString(hash.result().toHex());
+  return success &&
+         writeChunk(device, nullptr, QString("%TF.MD5,%1*%\nM02*\n").arg(md5));
 }
 
 /*******************************************************************************
@@ -363,6 +434,17 @@ QString GerberGenerator::escapeString(const QString& str) noexcept {
   return ret;
 }
 
+bool GerberGenerator::writeChunk(QIODevice& device, QCryptographicHash* hash,
+                                 const QString& data) noexcept {
+  // according to the RS-274C standard, linebreaks are not included in the
+  // checksum
+  QByteArray latin1 = data.toLatin1();
+  if (hash) {
+    hash->addData(QByteArray(latin1).replace('\n', QByteArray()));
+  }
+  return device.write(latin1) == latin1.size();
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -46,6 +46,15 @@ class GerberApertureList;
 /**
  * @brief The GerberGenerator class
  *
+ * By default, the whole output is kept in memory. For large layers (e.g. big
+ * copper pours or dense pad layers) #enableStreaming() should be called before
+ * plotting anything. Then the plotted content is written to a buffered
+ * temporary file while it is generated, and #saveToFile() copies it into the
+ * output file in chunks while calculating the MD5 checksum on the fly. Both
+ * modes use the same code to write the content and the footer, so the
+ * resulting file is identical to the file written without streaming. But
+ * #toStr() then returns only the header and the aperture list.
+ *
  * @todo Remove/Escape illegal characters in #mProjectId and #mProjectRevision!
  * @todo Use file/aperture attributes
  *
@@ -70,6 +79,10 @@ public:
 
   // Getters
   const QString& toStr() const noexcept { return mOutput; }
+  bool isStreamingEnabled() const noexcept { return !mContentFile.isNull(); }
+
+  // Setters
+  void enableStreaming();
 
   // Plot Methods
   void setLayerPolarity(LayerPolarity p) noexcept;
@@ -102,6 +115,8 @@ public:
 
 private:
   // Private Methods
+  void    appendContent(const QString& str) noexcept;
+  void    flushContent() noexcept;
   void    setCurrentAperture(int number) noexcept;
   void    setRegionModeOn() noexcept;
   void    setRegionModeOff() noexcept;
@@ -117,12 +132,12 @@ private:
   void    flashAtPosition(const Point& pos) noexcept;
   void    printHeader() noexcept;
   void    printApertureList() noexcept;
-  void    printContent() noexcept;
-  void    printFooter() noexcept;
-  QString calcOutputMd5Checksum() const noexcept;
+  bool    writeOutput(QIODevice& device) const noexcept;
 
   // Static Methods
   static QString escapeString(const QString& str) noexcept;
+  static bool    writeChunk(QIODevice& device, QCryptographicHash* hash,
+                            const QString& data) noexcept;
 
   // Metadata
   QString mProjectId;
@@ -135,6 +150,13 @@ private:
   QScopedPointer<GerberApertureList> mApertureList;
   int                                mCurrentApertureNumber;
   bool                               mMultiQuadrantArcModeOn;
+
+  // Streaming
+  QScopedPointer<QTemporaryFile> mContentFile;  ///< Only set if streaming
+  bool mContentFileError;  ///< Whether writing to #mContentFile failed
+
+  /// Number of characters buffered in #mContent before written to the file
+  static const int sContentBufferSize = 1024 * 1024;
 };
 
 /*******************************************************************************
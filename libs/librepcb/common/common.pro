@@ -68,6 +68,7 @@ SOURCES += \
     fileio/smartversionfile.cpp \
     fileio/versionfile.cpp \
     font/strokefont.cpp \
+    font/strokefontcache.cpp \
     font/strokefontpool.cpp \
     geometry/circle.cpp \
     geometry/cmd/cmdcircleedit.cpp \
@@ -101,6 +102,7 @@ SOURCES += \
     network/networkrequest.cpp \
     network/networkrequestbase.cpp \
     network/repository.cpp \
+    profiler.cpp \
     signalrole.cpp \
     sqlitedatabase.cpp \
     systeminfo.cpp \
@@ -182,6 +184,7 @@ HEADERS += \
     fileio/smartversionfile.h \
     fileio/versionfile.h \
     font/strokefont.h \
+    font/strokefontcache.h \
     font/strokefontpool.h \
     geometry/circle.h \
     geometry/cmd/cmdcircleedit.h \
@@ -217,6 +220,7 @@ HEADERS += \
     network/networkrequest.h \
     network/networkrequestbase.h \
     network/repository.h \
+    profiler.h \
     scopeguard.h \
     scopeguardlist.h \
     signalrole.h \
@@ -237,6 +241,7 @@ HEADERS += \
     utils/graphicslayerstackappearancesettings.h \
     utils/toolbarproxy.h \
     utils/undostackactiongroup.h \
+    utils/unionfind.h \
     uuid.h \
     version.h \
     widgets/alignmentselector.h \
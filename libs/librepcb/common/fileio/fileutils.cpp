@@ -52,6 +52,20 @@ QByteArray FileUtils::readFile(const FilePath& filepath) {
 }
 
 void FileUtils::writeFile(const FilePath& filepath, const QByteArray& content) {
+  writeFile(filepath, [&](QIODevice& device) {
+    qint64 written = device.write(content);
+    if (written != content.size()) {
+      qDebug() << "only" << written << "of" << content.size()
+               << "bytes written";
+      throw RuntimeError(__FILE__, __LINE__,
+                         QString(tr("Could not write to file \"%1\": %2"))
+                             .arg(filepath.toNative(), device.errorString()));
+    }
+  });  // can throw
+}
+
+void FileUtils::writeFile(const FilePath&                        filepath,
+                          const std::function<void(QIODevice&)>& writer) {
   makePath(filepath.getParentDir());  // can throw
   QSaveFile file(filepath.toStr());
   if (!file.open(QIODevice::WriteOnly)) {
@@ -59,13 +73,7 @@ void FileUtils::writeFile(const FilePath& filepath, const QByteArray& content) {
                        QString(tr("Could not open or create file \"%1\": %2"))
                            .arg(filepath.toNative(), file.errorString()));
   }
-  qint64 written = file.write(content);
-  if (written != content.size()) {
-    qDebug() << "only" << written << "of" << content.size() << "bytes written";
-    throw RuntimeError(__FILE__, __LINE__,
-                       QString(tr("Could not write to file \"%1\": %2"))
-                           .arg(filepath.toNative(), file.errorString()));
-  }
+  writer(file);  // can throw
   if (!file.commit()) {
     throw RuntimeError(__FILE__, __LINE__,
                        QString(tr("Could not write to "
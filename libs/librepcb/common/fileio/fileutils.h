@@ -27,6 +27,8 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -79,6 +81,22 @@ public:
    */
   static void writeFile(const FilePath& filepath, const QByteArray& content);
 
+  /**
+   * @brief Write the content of a file with a callback
+   *
+   * Same as #writeFile(const FilePath&, const QByteArray&), but the content is
+   * streamed into the file by the passed callback instead of building it in
+   * memory first. The file is only replaced if the callback does not throw.
+   *
+   * @param filepath      The file to (over)write
+   * @param writer        Callback which writes the content to the passed
+   *                      device
+   *
+   * @throws Exception    If an error occurs.
+   */
+  static void writeFile(const FilePath&                        filepath,
+                        const std::function<void(QIODevice&)>& writer);
+
   /**
    * @brief Copy a single file
    *
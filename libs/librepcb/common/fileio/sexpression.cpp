@@ -26,11 +26,266 @@
 
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Class SExpression::Parser
+ ******************************************************************************/
+
+/**
+ * @brief Single-pass parser working directly on the UTF-8 encoded content
+ *
+ * List names and tokens are highly repetitive (e.g. thousands of `position`
+ * nodes), so they are interned per document to share their string data
+ * instead of allocating a new QString for every node.
+ */
+struct SExpression::Parser {
+  Parser(const QByteArray& content, const FilePath& filePath) noexcept
+    : begin(content.constData()),
+      pos(begin),
+      end(begin + content.size()),
+      filePath(filePath) {}
+
+  bool atEnd() const noexcept { return pos >= end; }
+
+  static bool isWhitespace(char c) noexcept {
+    return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t') ||
+           (c == '\f') || (c == '\v');
+  }
+
+  static bool isDelimiter(char c) noexcept {
+    return isWhitespace(c) || (c == '(') || (c == ')') || (c == '"');
+  }
+
+  int getLine() const noexcept { return std::count(begin, pos, '\n') + 1; }
+
+  int getColumn() const noexcept {
+    const char* lineBegin = pos;
+    while ((lineBegin > begin) && (*(lineBegin - 1) != '\n')) {
+      --lineBegin;
+    }
+    return (pos - lineBegin) + 1;
+  }
+
+  void skipWhitespaceAndComments() noexcept {
+    while (pos < end) {
+      if (isWhitespace(*pos)) {
+        ++pos;
+      } else if (*pos == ';') {  // comment until end of line
+        while ((pos < end) && (*pos != '\n')) {
+          ++pos;
+        }
+      } else {
+        break;
+      }
+    }
+  }
+
+  const QString& intern(const char* data, int size) noexcept {
+    // Note: The key refers to the content without copying it, which is fine
+    // since the content outlives the parser.
+    QByteArray key = QByteArray::fromRawData(data, size);
+    auto       it  = atoms.find(key);
+    if (it == atoms.end()) {
+      it = atoms.insert(key, QString::fromUtf8(data, size));
+    }
+    return *it;
+  }
+
+  SExpression parseList() {
+    Q_ASSERT(*pos == '(');
+    ++pos;
+    skipWhitespaceAndComments();
+    const char* nameBegin = pos;
+    while ((pos < end) && (!isDelimiter(*pos))) {
+      ++pos;
+    }
+    if (pos == nameBegin) {
+      throw FileParseError(__FILE__, __LINE__, filePath, getLine(),
+                           getColumn(), QString(),
+                           SExpression::tr("List does not have a name."));
+    }
+    SExpression list(Type::List, intern(nameBegin, pos - nameBegin));
+    list.mFilePath = filePath;
+    while (true) {
+      skipWhitespaceAndComments();
+      if (pos >= end) {
+        throw FileParseError(__FILE__, __LINE__, filePath, getLine(),
+                             getColumn(), QString(),
+                             SExpression::tr("List is not closed."));
+      } else if (*pos == ')') {
+        ++pos;
+        list.updateChildIndex();
+        return list;
+      } else if (*pos == '(') {
+        list.mChildren.append(parseList());  // can throw
+      } else if (*pos == '"') {
+        list.mChildren.append(parseString());  // can throw
+      } else {
+        list.mChildren.append(parseToken());
+      }
+    }
+  }
+
+  SExpression parseToken() noexcept {
+    const char* tokenBegin = pos;
+    while ((pos < end) && (!isDelimiter(*pos))) {
+      ++pos;
+    }
+    SExpression token(Type::Token, intern(tokenBegin, pos - tokenBegin));
+    token.mFilePath = filePath;
+    return token;
+  }
+
+  SExpression parseString() {
+    Q_ASSERT(*pos == '"');
+    const char* stringBegin = ++pos;
+    bool        escaped     = false;
+    while ((pos < end) && (*pos != '"')) {
+      if (*pos == '\\') {
+        escaped = true;
+        ++pos;
+      }
+      ++pos;
+    }
+    if (pos >= end) {
+      pos = stringBegin - 1;
+      throw FileParseError(__FILE__, __LINE__, filePath, getLine(),
+                           getColumn(), QString(),
+                           SExpression::tr("String is not terminated."));
+    }
+    const char* stringEnd = pos++;
+    SExpression string(Type::String, QString());
+    string.mFilePath = filePath;
+    if (escaped) {
+      string.mValue = unescape(stringBegin, stringEnd);  // can throw
+    } else {
+      string.mValue = QString::fromUtf8(stringBegin, stringEnd - stringBegin);
+    }
+    return string;
+  }
+
+  QString unescape(const char* stringBegin, const char* stringEnd) {
+    QByteArray str;
+    str.reserve(stringEnd - stringBegin);
+    for (const char* c = stringBegin; c < stringEnd; ++c) {
+      if (*c != '\\') {
+        str.append(*c);
+        continue;
+      }
+      switch (*(++c)) {
+        case '\'':
+          str.append('\'');
+          break;
+        case '"':
+          str.append('"');
+          break;
+        case '?':
+          str.append('?');
+          break;
+        case '\\':
+          str.append('\\');
+          break;
+        case 'a':
+          str.append('\a');
+          break;
+        case 'b':
+          str.append('\b');
+          break;
+        case 'f':
+          str.append('\f');
+          break;
+        case 'n':
+          str.append('\n');
+          break;
+        case 'r':
+          str.append('\r');
+          break;
+        case 't':
+          str.append('\t');
+          break;
+        case 'v':
+          str.append('\v');
+          break;
+        default:
+          pos = c;
+          throw FileParseError(
+              __FILE__, __LINE__, filePath, getLine(), getColumn(), QString(),
+              QString(SExpression::tr("Invalid escape sequence: \\%1"))
+                  .arg(QChar(*c)));
+      }
+    }
+    return QString::fromUtf8(str);
+  }
+
+  const char*                begin;
+  const char*                pos;
+  const char*                end;
+  const FilePath&            filePath;
+  QHash<QByteArray, QString> atoms;  ///< Interned list names and tokens
+};
+
+/*******************************************************************************
+ *  Class SExpression::Writer
+ ******************************************************************************/
+
+/**
+ * @brief Buffered output of UTF-8 encoded S-Expressions to a QIODevice
+ *
+ * Every value is encoded only once and appended to a buffer which is written
+ * to the device in large chunks, so no string of the whole document is
+ * created.
+ */
+struct SExpression::Writer {
+  explicit Writer(QIODevice& device) noexcept : device(device), last('\n') {
+    buffer.reserve(sBufferSize);
+  }
+
+  void write(char c) {
+    buffer.append(c);
+    last = c;
+    if (buffer.size() >= sBufferSize) {
+      flush();  // can throw
+    }
+  }
+
+  void write(const QString& str) {
+    if (!str.isEmpty()) {
+      buffer.append(str.toUtf8());
+      last = buffer.at(buffer.size() - 1);
+      if (buffer.size() >= sBufferSize) {
+        flush();  // can throw
+      }
+    }
+  }
+
+  void writeIndent(int indent) {
+    for (int i = 0; i < indent; ++i) {
+      write(' ');
+    }
+  }
+
+  void flush() {
+    if (device.write(buffer) != buffer.size()) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          QString(SExpression::tr("Failed to write S-Expression: %1"))
+              .arg(device.errorString()));
+    }
+    buffer.clear();
+  }
+
+  static const int sBufferSize = 64 * 1024;
+  QIODevice&       device;
+  QByteArray       buffer;
+  char             last;  ///< The last written character
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -46,31 +301,8 @@ SExpression::SExpression(const SExpression& other) noexcept
   : mType(other.mType),
     mValue(other.mValue),
     mChildren(other.mChildren),
-    mFilePath(other.mFilePath) {
-}
-
-SExpression::SExpression(sexpresso::Sexp& sexp, const FilePath& filePath)
-  : mType(Type::List), mValue(), mFilePath(filePath) {
-  if (sexp.childCount() < 1) {
-    throw RuntimeError(__FILE__, __LINE__);
-  }
-
-  if (sexp.isSexp()) {
-    sexpresso::Sexp& first = sexp.getChild(0);
-    if (!first.isString()) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    mValue = QString::fromStdString(first.getString());
-    for (auto&& arg : sexp.arguments()) {
-      mChildren.append(SExpression(arg, filePath));
-    }
-  } else if (sexp.isString()) {
-    mValue = QString::fromStdString(sexp.getString());
-    mType  = Type::String;
-  } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                         tr("Unknown node type."));
-  }
+    mFilePath(other.mFilePath),
+    mChildIndex(other.mChildIndex) {
 }
 
 SExpression::~SExpression() noexcept {
@@ -113,9 +345,15 @@ const QString& SExpression::getStringOrToken(bool throwIfEmpty) const {
 QList<SExpression> SExpression::getChildren(const QString& name) const
     noexcept {
   QList<SExpression> children;
-  foreach (const SExpression& child, mChildren) {
-    if (child.isList() && (child.mValue == name)) {
-      children.append(child);
+  if (hasChildIndex()) {
+    foreach (int index, mChildIndex.value(name)) {
+      children.append(mChildren.at(index));
+    }
+  } else {
+    foreach (const SExpression& child, mChildren) {
+      if (child.isList() && (child.mValue == name)) {
+        children.append(child);
+      }
     }
   }
   return children;
@@ -133,16 +371,11 @@ const SExpression* SExpression::tryGetChildByPath(const QString& path) const
     noexcept {
   const SExpression* child = this;
   foreach (const QString& name, path.split('/')) {
-    bool found = false;
-    foreach (const SExpression& childchild, child->mChildren) {
-      if (childchild.isList() && (childchild.mValue == name)) {
-        child = &childchild;
-        found = true;
-      }
-    }
-    if (!found) {
+    int index = child->indexOfLastChild(name);
+    if (index < 0) {
       return nullptr;
     }
+    child = &child->mChildren.at(index);
   }
   return child;
 }
@@ -163,6 +396,7 @@ const SExpression& SExpression::getChildByPath(const QString& path) const {
 
 SExpression& SExpression::appendLineBreak() {
   mChildren.append(createLineBreak());
+  childAppended();
   return *this;
 }
 
@@ -175,6 +409,7 @@ SExpression& SExpression::appendChild(const SExpression& child,
   if (mType == Type::List) {
     if (linebreak) appendLineBreak();
     mChildren.append(child);
+    childAppended();
     return mChildren.last();
   } else {
     throw LogicError(__FILE__, __LINE__);
@@ -187,12 +422,22 @@ void SExpression::removeLineBreaks() noexcept {
       mChildren.removeAt(i);
     }
   }
+  updateChildIndex();
+}
+
+void SExpression::writeTo(QIODevice& device) const {
+  Writer writer(device);
+  write(writer, 0);    // can throw
+  writer.write('\n');  // newline at end of file
+  writer.flush();      // can throw
 }
 
 QByteArray SExpression::toByteArray() const {
-  QString str = toString(0);  // can throw
-  str += '\n';                // newline at end of file
-  return str.toUtf8();
+  QByteArray content;
+  QBuffer    buffer(&content);
+  buffer.open(QIODevice::WriteOnly);
+  writeTo(buffer);  // can throw
+  return content;
 }
 
 /*******************************************************************************
@@ -200,10 +445,11 @@ QByteArray SExpression::toByteArray() const {
  ******************************************************************************/
 
 SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
-  mType     = rhs.mType;
-  mValue    = rhs.mValue;
-  mChildren = rhs.mChildren;
-  mFilePath = rhs.mFilePath;
+  mType       = rhs.mType;
+  mValue      = rhs.mValue;
+  mChildren   = rhs.mChildren;
+  mFilePath   = rhs.mFilePath;
+  mChildIndex = rhs.mChildIndex;
   return *this;
 }
 
@@ -212,6 +458,18 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
  ******************************************************************************/
 
 QString SExpression::escapeString(const QString& string) const noexcept {
+  // Most strings do not contain any character which might need to be escaped,
+  // so avoid the expensive conversion to std::string for them.
+  bool needsEscaping = false;
+  foreach (const QChar& c, string) {
+    if ((c < ' ') || (c == '"') || (c == '\\') || (c == '\'') || (c == '?')) {
+      needsEscaping = true;
+      break;
+    }
+  }
+  if (!needsEscaping) {
+    return string;
+  }
   return QString::fromStdString(sexpresso::escape(string.toStdString()));
 }
 
@@ -223,18 +481,20 @@ bool SExpression::isValidToken(const QString& token) const noexcept {
   return QRegExp("[a-zA-Z0-9\\.:_-]+").exactMatch(token);
 }
 
-QString SExpression::toString(int indent) const {
+void SExpression::write(Writer& writer, int indent) const {
   if (mType == Type::List) {
     if (!isValidListName(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression list name: %1")).arg(mValue));
     }
-    QString str = '(' + mValue;
+    writer.write('(');
+    writer.write(mValue);
     for (int i = 0; i < mChildren.count(); ++i) {
       const SExpression& child = mChildren.at(i);
-      if ((!str.at(str.length() - 1).isSpace()) && (!child.isLineBreak())) {
-        str += ' ';
+      bool afterSpace = (writer.last == ' ') || (writer.last == '\n');
+      if ((!afterSpace) && (!child.isLineBreak())) {
+        writer.write(' ');
       }
       bool nextChildIsLineBreak = (i < mChildren.count() - 1)
                                       ? mChildren.at(i + 1).isLineBreak()
@@ -243,32 +503,75 @@ QString SExpression::toString(int indent) const {
         if ((i > 0) && mChildren.at(i - 1).isLineBreak()) {
           // too many line breaks ;)
         } else {
-          str += '\n';
+          writer.write('\n');
         }
       } else {
-        str += child.toString(indent + 1);
+        child.write(writer, indent + 1);  // can throw
       }
     }
     if (isMultiLineList()) {
-      str += '\n' + QString(' ').repeated(indent);
+      writer.write('\n');
+      writer.writeIndent(indent);
     }
-    return str + ')';
+    writer.write(')');
   } else if (mType == Type::Token) {
     if (!isValidToken(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString(tr("Invalid S-Expression token: %1")).arg(mValue));
     }
-    return mValue;
+    writer.write(mValue);
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    writer.write('"');
+    writer.write(escapeString(mValue));
+    writer.write('"');
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    writer.write('\n');
+    writer.writeIndent(indent);
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
 }
 
+bool SExpression::hasChildIndex() const noexcept {
+  return mChildren.count() >= sChildIndexThreshold;
+}
+
+int SExpression::indexOfLastChild(const QString& name) const noexcept {
+  if (hasChildIndex()) {
+    auto it = mChildIndex.constFind(name);
+    return (it != mChildIndex.constEnd()) ? it->last() : -1;
+  }
+  for (int i = mChildren.count() - 1; i >= 0; --i) {
+    const SExpression& child = mChildren.at(i);
+    if (child.isList() && (child.mValue == name)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void SExpression::childAppended() noexcept {
+  int index = mChildren.count() - 1;
+  if (mChildren.count() == sChildIndexThreshold) {
+    updateChildIndex();  // index not built yet
+  } else if (hasChildIndex() && mChildren.at(index).isList()) {
+    mChildIndex[mChildren.at(index).mValue].append(index);
+  }
+}
+
+void SExpression::updateChildIndex() noexcept {
+  mChildIndex.clear();
+  if (hasChildIndex()) {
+    for (int i = 0; i < mChildren.count(); ++i) {
+      const SExpression& child = mChildren.at(i);
+      if (child.isList()) {
+        mChildIndex[child.mValue].append(i);
+      }
+    }
+  }
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -291,20 +594,21 @@ SExpression SExpression::createLineBreak() {
 
 SExpression SExpression::parse(const QByteArray& content,
                                const FilePath&   filePath) {
-  std::string     error;
-  QString         str  = QString::fromUtf8(content);
-  sexpresso::Sexp tree = sexpresso::parse(str.toStdString(), error);
-  if (error.empty()) {
-    if (tree.childCount() == 1) {
-      return SExpression(tree.getChild(0), filePath);
-    } else {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                           tr("File does not have exactly one root node."));
-    }
-  } else {
-    throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                         QString::fromStdString(error));
+  Parser parser(content, filePath);
+  parser.skipWhitespaceAndComments();
+  if (parser.atEnd() || (*parser.pos != '(')) {
+    throw FileParseError(__FILE__, __LINE__, filePath, parser.getLine(),
+                         parser.getColumn(), QString(),
+                         tr("File does not have exactly one root node."));
+  }
+  SExpression root = parser.parseList();  // can throw
+  parser.skipWhitespaceAndComments();
+  if (!parser.atEnd()) {
+    throw FileParseError(__FILE__, __LINE__, filePath, parser.getLine(),
+                         parser.getColumn(), QString(),
+                         tr("File does not have exactly one root node."));
   }
+  return root;
 }
 
 /*******************************************************************************
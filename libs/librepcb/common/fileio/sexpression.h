@@ -32,10 +32,6 @@
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
-namespace sexpresso {
-struct Sexp;
-}
-
 namespace librepcb {
 
 class SExpression;
@@ -129,6 +125,7 @@ public:
     return appendList(child, linebreak).appendChild(obj);
   }
   void       removeLineBreaks() noexcept;
+  void       writeTo(QIODevice& device) const;
   QByteArray toByteArray() const;
 
   // Operator Overloadings
@@ -141,20 +138,32 @@ public:
   static SExpression createLineBreak();
   static SExpression parse(const QByteArray& content, const FilePath& filePath);
 
+private:  // Types
+  struct Parser;
+  struct Writer;
+
 private:  // Methods
   SExpression(Type type, const QString& value);
-  SExpression(sexpresso::Sexp& sexp, const FilePath& filePath);
 
   QString escapeString(const QString& string) const noexcept;
   bool    isValidListName(const QString& name) const noexcept;
   bool    isValidToken(const QString& token) const noexcept;
-  QString toString(int indent) const;
+  void    write(Writer& writer, int indent) const;
+  bool    hasChildIndex() const noexcept;
+  int     indexOfLastChild(const QString& name) const noexcept;
+  void    childAppended() noexcept;
+  void    updateChildIndex() noexcept;
 
 private:  // Data
   Type               mType;
   QString            mValue;  ///< either a list name, a token or a string
   QList<SExpression> mChildren;
   FilePath           mFilePath;
+
+  /// Indices of all list children by name, only used for lists with many
+  /// children (see #hasChildIndex()) to speed up finding children by name
+  QHash<QString, QVector<int>> mChildIndex;
+  static const int             sChildIndexThreshold = 16;
 };
 
 /*******************************************************************************
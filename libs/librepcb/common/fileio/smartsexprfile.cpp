@@ -55,7 +55,13 @@ SExpression SmartSExprFile::parseFileAndBuildDomTree() const {
 
 void SmartSExprFile::save(const SExpression& domDocument, bool toOriginal) {
   FilePath filepath = prepareSaveAndReturnFilePath(toOriginal);  // can throw
-  FileUtils::writeFile(filepath, domDocument.toByteArray());     // can throw
+
+  // stream the document directly into the file to avoid building the whole
+  // file content in memory
+  FileUtils::writeFile(filepath, [&](QIODevice& device) {
+    domDocument.writeTo(device);  // can throw
+  });
+
   updateMembersAfterSaving(toOriginal);
 }
 
@@ -23,6 +23,7 @@
 #include "strokefont.h"
 
 #include "../fileio/fileutils.h"
+#include "strokefontcache.h"
 
 #include <fontobene/font.h>
 #include <fontobene/glyphlistaccessor.h>
@@ -41,12 +42,11 @@ namespace fb = fontobene;
  *  Constructors / Destructor
  ******************************************************************************/
 
-StrokeFont::StrokeFont(const FilePath& fontFilePath) noexcept
-  : QObject(nullptr), mFilePath(fontFilePath) {
-  // load the font in another thread because it takes some time to load it
-  qDebug() << "Start loading font" << mFilePath.toNative();
-  mFuture = QtConcurrent::run(
-      [fontFilePath]() { return fb::Font(fontFilePath.toStr()); });
+StrokeFont::StrokeFont(const FilePath& fontFilePath,
+                       StrokeFontCache* cache) noexcept
+  : QObject(nullptr),
+    mFilePath(fontFilePath),
+    mFuture(cache ? cache->load(fontFilePath) : load(fontFilePath)) {
   connect(&mWatcher, &QFutureWatcher<fb::Font>::finished, this,
           &StrokeFont::fontLoaded);
   mWatcher.setFuture(mFuture);
@@ -192,6 +192,17 @@ QVector<Path> StrokeFont::strokeGlyph(const QChar&          glyph,
   }
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QFuture<fb::Font> StrokeFont::load(const FilePath& fontFilePath) noexcept {
+  // load the font in another thread because it takes some time to load it
+  qDebug() << "Start loading font" << fontFilePath.toNative();
+  return QtConcurrent::run(
+      [fontFilePath]() { return fb::Font(fontFilePath.toStr()); });
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
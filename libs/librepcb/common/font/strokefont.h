@@ -42,6 +42,8 @@ class GlyphListAccessor;
 
 namespace librepcb {
 
+class StrokeFontCache;
+
 /*******************************************************************************
  *  Class StrokeFont
  ******************************************************************************/
@@ -54,7 +56,8 @@ class StrokeFont final : public QObject {
 
 public:
   // Constructors / Destructor
-  StrokeFont(const FilePath& fontFilePath) noexcept;
+  StrokeFont(const FilePath& fontFilePath,
+             StrokeFontCache* cache = nullptr) noexcept;
   StrokeFont(const StrokeFont& other) = delete;
   ~StrokeFont() noexcept;
 
@@ -76,10 +79,22 @@ public:
   QVector<Path> strokeGlyph(const QChar& glyph, const PositiveLength& height,
                             Length& spacing) const noexcept;
 
+  // Static Methods
+
+  /**
+   * @brief Start loading a font file in another thread, without any caching
+   *
+   * @param fontFilePath  Path to the font file (*.bene)
+   *
+   * @return The future of the loaded font
+   */
+  static QFuture<fontobene::Font> load(const FilePath& fontFilePath) noexcept;
+
   // Operator Overloadings
   StrokeFont& operator=(const StrokeFont& rhs) = delete;
 
 private:
+
   void                                fontLoaded() noexcept;
   const fontobene::GlyphListAccessor& accessor() const noexcept;
   static QVector<Path>                polylines2paths(
@@ -0,0 +1,74 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "strokefontcache.h"
+
+#include "../fileio/fileutils.h"
+#include "strokefont.h"
+
+#include <fontobene/font.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+StrokeFontCache::StrokeFontCache() noexcept {
+}
+
+StrokeFontCache::~StrokeFontCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QFuture<fontobene::Font> StrokeFontCache::load(
+    const FilePath& fontFilePath) noexcept {
+  QByteArray key;
+  try {
+    key = QCryptographicHash::hash(FileUtils::readFile(fontFilePath),
+                                   QCryptographicHash::Sha256);  // can throw
+  } catch (const Exception&) {
+    // ignore the error here, it will be reported by the loader
+    return StrokeFont::load(fontFilePath);
+  }
+
+  QMutexLocker lock(&mMutex);
+  auto         it = mFonts.find(key);
+  if (it == mFonts.end()) {
+    it = mFonts.insert(key, StrokeFont::load(fontFilePath));
+  }
+  return *it;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
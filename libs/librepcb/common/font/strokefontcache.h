@@ -0,0 +1,91 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_STROKEFONTCACHE_H
+#define LIBREPCB_STROKEFONTCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../fileio/filepath.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace fontobene {
+struct Font;
+}  // namespace fontobene
+
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class StrokeFontCache
+ ******************************************************************************/
+
+/**
+ * @brief Shares loaded stroke fonts between several ::librepcb::StrokeFont
+ *        objects
+ *
+ * Many projects contain exactly the same fonts, so when opening lots of
+ * projects (e.g. in batch mode of the command line interface), each font file
+ * should be loaded only once. Fonts are identified by the SHA-256 hash of
+ * their file content, not by their file path.
+ *
+ * The loaded fonts are kept until the cache is destroyed, so create it only
+ * for the time the fonts should be shared (e.g. for one CLI run), and pass it
+ * to the ::librepcb::StrokeFontPool of each project. The cache itself may be
+ * destroyed before the fonts loaded through it.
+ *
+ * @note This class is thread-safe.
+ */
+class StrokeFontCache final {
+public:
+  // Constructors / Destructor
+  StrokeFontCache() noexcept;
+  StrokeFontCache(const StrokeFontCache& other) = delete;
+  ~StrokeFontCache() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Get a font from the cache, or start loading it if not cached yet
+   *
+   * @param fontFilePath  Path to the font file (*.bene)
+   *
+   * @return The (maybe not yet finished) font loaded in another thread
+   */
+  QFuture<fontobene::Font> load(const FilePath& fontFilePath) noexcept;
+
+  // Operator Overloadings
+  StrokeFontCache& operator=(const StrokeFontCache& rhs) = delete;
+
+private:  // Data
+  QMutex                                      mMutex;
+  QHash<QByteArray, QFuture<fontobene::Font>> mFonts;  ///< Key: SHA-256 hash
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_STROKEFONTCACHE_H
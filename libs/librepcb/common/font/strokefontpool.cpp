@@ -35,14 +35,15 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-StrokeFontPool::StrokeFontPool(const FilePath& directory) noexcept {
+StrokeFontPool::StrokeFontPool(const FilePath& directory,
+                               StrokeFontCache* cache) noexcept {
   try {
     foreach (const FilePath& fp,
              FileUtils::getFilesInDirectory(directory, {"*.bene"})) {
       try {
         qDebug() << "Load stroke font:" << fp.getFilename();
         mFonts.insert(fp.getFilename(),
-                      std::make_shared<StrokeFont>(fp));  // can throw
+                      std::make_shared<StrokeFont>(fp, cache));  // can throw
       } catch (const Exception& e) {
         qCritical() << "Failed to load stroke font" << fp.toNative() << ":"
                     << e.getMsg();
@@ -34,6 +34,8 @@
  ******************************************************************************/
 namespace librepcb {
 
+class StrokeFontCache;
+
 /*******************************************************************************
  *  Class StrokeFontPool
  ******************************************************************************/
@@ -46,7 +48,15 @@ class StrokeFontPool final {
 
 public:
   // Constructors / Destructor
-  StrokeFontPool(const FilePath& directory) noexcept;
+  /**
+   * @brief Constructor which loads all fonts of a directory
+   *
+   * @param directory   Directory containing the font files (*.bene)
+   * @param cache       If not nullptr, fonts are loaded through this cache to
+   *                    share them with other pools using the same cache
+   */
+  StrokeFontPool(const FilePath& directory,
+                 StrokeFontCache* cache = nullptr) noexcept;
   StrokeFontPool(const StrokeFontPool& other) = delete;
   ~StrokeFontPool() noexcept;
 
@@ -36,7 +36,9 @@ namespace librepcb {
  ******************************************************************************/
 
 Path::Path(const Path& other) noexcept
-  : mVertices(other.mVertices), mPainterPathPx(other.mPainterPathPx) {
+  : mVertices(other.mVertices),
+    mPainterPathPx(other.mPainterPathPx),
+    mFlattenedPoints(other.mFlattenedPoints) {
 }
 
 Path::Path(const SExpression& node) {
@@ -57,6 +59,41 @@ bool Path::isClosed() const noexcept {
   }
 }
 
+bool Path::hasArcs() const noexcept {
+  for (int i = 0; i < mVertices.count() - 1; ++i) {  // ignore last vertex
+    if (mVertices.at(i).getAngle() != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const QVector<Point>& Path::getFlattenedPoints(
+    const PositiveLength& maxArcTolerance) const noexcept {
+  auto it = mFlattenedPoints.find(maxArcTolerance->toNm());
+  if (it == mFlattenedPoints.end()) {
+    QVector<Point> points;
+    points.reserve(mVertices.count());
+    for (int i = 0; i < mVertices.count(); ++i) {
+      const Vertex& v  = mVertices.at(i);
+      const Vertex& v0 = mVertices.at(qMax(i - 1, 0));
+      if ((i == 0) || (v0.getAngle() == 0)) {
+        points.append(v.getPos());
+      } else {
+        // approximate arcs by many short straight line segments
+        Path arc =
+            flatArc(v0.getPos(), v.getPos(), v0.getAngle(), maxArcTolerance);
+        // skip first point as it is would be a duplicate
+        for (int k = 1; k < arc.getVertices().count(); ++k) {
+          points.append(arc.getVertices().at(k).getPos());
+        }
+      }
+    }
+    it = mFlattenedPoints.insert(maxArcTolerance->toNm(), points);
+  }
+  return it.value();
+}
+
 const QPainterPath& Path::toQPainterPathPx(bool close) const noexcept {
   if (mPainterPathPx.isEmpty()) {
     int count = mVertices.count();
@@ -99,7 +136,7 @@ Path& Path::translate(const Point& offset) noexcept {
   for (Vertex& vertex : mVertices) {
     vertex.setPos(vertex.getPos() + offset);
   }
-  invalidatePainterPath();
+  invalidateCaches();
   return *this;
 }
 
@@ -111,7 +148,7 @@ Path& Path::rotate(const Angle& angle, const Point& center) noexcept {
   for (Vertex& vertex : mVertices) {
     vertex.setPos(vertex.getPos().rotated(angle, center));
   }
-  invalidatePainterPath();
+  invalidateCaches();
   return *this;
 }
 
@@ -124,7 +161,7 @@ Path& Path::mirror(Qt::Orientation orientation, const Point& center) noexcept {
     vertex.setPos(vertex.getPos().mirrored(orientation, center));
     vertex.setAngle(-vertex.getAngle());
   }
-  invalidatePainterPath();
+  invalidateCaches();
   return *this;
 }
 
@@ -139,7 +176,7 @@ Path Path::mirrored(Qt::Orientation orientation, const Point& center) const
 
 void Path::addVertex(const Vertex& vertex) noexcept {
   mVertices.append(vertex);
-  invalidatePainterPath();
+  invalidateCaches();
 }
 
 void Path::addVertex(const Point& pos, const Angle& angle) noexcept {
@@ -148,7 +185,7 @@ void Path::addVertex(const Point& pos, const Angle& angle) noexcept {
 
 void Path::insertVertex(int index, const Vertex& vertex) noexcept {
   mVertices.insert(index, vertex);
-  invalidatePainterPath();
+  invalidateCaches();
 }
 
 void Path::insertVertex(int index, const Point& pos,
@@ -175,8 +212,9 @@ void Path::serialize(SExpression& root) const {
  ******************************************************************************/
 
 Path& Path::operator=(const Path& rhs) noexcept {
-  mVertices      = rhs.mVertices;
-  mPainterPathPx = rhs.mPainterPathPx;
+  mVertices        = rhs.mVertices;
+  mPainterPathPx   = rhs.mPainterPathPx;
+  mFlattenedPoints = rhs.mFlattenedPoints;
   return *this;
 }
 
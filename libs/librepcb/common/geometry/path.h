@@ -49,11 +49,16 @@ namespace librepcb {
  *
  * For a valid path, minimum two vertices are required. Paths with less than two
  * vertices are useless and thus considered as invalid.
+ *
+ * The QPainterPath and the flattened points (arcs approximated by straight
+ * line segments, see #getFlattenedPoints()) are cached until the path is
+ * modified. Since these caches are filled lazily, const methods of the same
+ * object must not be called from multiple threads at the same time.
  */
 class Path final : public SerializableObject {
 public:
   // Constructors / Destructor
-  Path() noexcept : mVertices(), mPainterPathPx() {}
+  Path() noexcept : mVertices(), mPainterPathPx(), mFlattenedPoints() {}
   Path(const Path& other) noexcept;
   explicit Path(const QVector<Vertex>& vertices) noexcept
     : mVertices(vertices) {}
@@ -63,10 +68,13 @@ public:
   // Getters
   bool             isClosed() const noexcept;
   QVector<Vertex>& getVertices() noexcept {
-    invalidatePainterPath();
+    invalidateCaches();
     return mVertices;
   }
   const QVector<Vertex>& getVertices() const noexcept { return mVertices; }
+  bool                   hasArcs() const noexcept;
+  const QVector<Point>&  getFlattenedPoints(
+      const PositiveLength& maxArcTolerance) const noexcept;
   const QPainterPath&    toQPainterPathPx(bool close = false) const noexcept;
 
   // Transformations
@@ -116,13 +124,17 @@ public:
   static QPainterPath toQPainterPathPx(const QVector<Path>& paths) noexcept;
 
 private:  // Methods
-  void invalidatePainterPath() const noexcept {
+  void invalidateCaches() const noexcept {
     mPainterPathPx = QPainterPath();
+    mFlattenedPoints.clear();
   }
 
 private:  // Data
   QVector<Vertex>      mVertices;
   mutable QPainterPath mPainterPathPx;  // cached path for #toQPainterPathPx()
+
+  /// Cached points for #getFlattenedPoints(), key: max. arc tolerance in nm
+  mutable QHash<qint64, QVector<Point>> mFlattenedPoints;
 };
 
 /*******************************************************************************
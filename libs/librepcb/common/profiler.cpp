@@ -0,0 +1,211 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "profiler.h"
+
+#include "fileio/fileutils.h"
+#include "systeminfo.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class Profiler
+ ******************************************************************************/
+
+Profiler::Profiler() noexcept : mEnabled(0) {
+}
+
+Profiler::~Profiler() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QList<Profiler::Event> Profiler::getEvents() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mEvents;
+}
+
+QByteArray Profiler::toChromeTraceJson() const noexcept {
+  // See the "Trace Event Format" specification of the Chromium project.
+  qint64     pid = QCoreApplication::applicationPid();
+  QJsonArray traceEvents;
+  foreach (const Event& event, getEvents()) {
+    QJsonObject obj;
+    obj["name"] = QString(event.name);
+    obj["cat"]  = QString(event.category);
+    obj["pid"]  = pid;
+    obj["tid"]  = event.threadIndex;
+    if (event.durationUs >= 0) {
+      QJsonObject args;
+      if (!event.details.isEmpty()) {
+        args["details"] = event.details;
+      }
+      bool hasMemory = (event.memoryBefore >= 0) && (event.memoryAfter >= 0);
+      if (hasMemory) {
+        args["memory_before_kb"] = event.memoryBefore / 1024;
+        args["memory_after_kb"]  = event.memoryAfter / 1024;
+      }
+      obj["ph"]   = QString("X");
+      obj["ts"]   = event.startUs;
+      obj["dur"]  = event.durationUs;
+      obj["args"] = args;
+      traceEvents.append(obj);
+      if (hasMemory) {
+        // track the resident memory as a separate counter graph
+        QJsonObject memoryArgs;
+        memoryArgs["resident_kb"] = event.memoryAfter / 1024;
+        QJsonObject counter;
+        counter["name"] = QString("Memory");
+        counter["ph"]   = QString("C");
+        counter["ts"]   = event.startUs + event.durationUs;
+        counter["pid"]  = pid;
+        counter["args"] = memoryArgs;
+        traceEvents.append(counter);
+      }
+    } else {
+      QJsonObject args;
+      args["value"] = event.memoryBefore;
+      obj["ph"]     = QString("C");
+      obj["ts"]     = event.startUs;
+      obj["args"]   = args;
+      traceEvents.append(obj);
+    }
+  }
+  QJsonObject root;
+  root["traceEvents"]     = traceEvents;
+  root["displayTimeUnit"] = QString("ms");
+  return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void Profiler::setEnabled(bool enabled) noexcept {
+  QMutexLocker lock(&mMutex);
+  if (enabled && (!mTimer.isValid())) {
+    mTimer.start();
+  }
+  mEnabled.store(enabled ? 1 : 0);
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void Profiler::addCounter(const char* category, const char* name,
+                          qint64 value) noexcept {
+  if (isEnabled()) {
+    Event event;
+    event.category     = category;
+    event.name         = name;
+    event.threadIndex  = 0;
+    event.startUs      = getElapsedUs();
+    event.durationUs   = -1;
+    event.memoryBefore = value;
+    event.memoryAfter  = -1;
+    addEvent(event);
+  }
+}
+
+void Profiler::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mEvents.clear();
+}
+
+void Profiler::saveChromeTrace(const FilePath& filepath) const {
+  FileUtils::writeFile(filepath, toChromeTraceJson());  // can throw
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+Profiler& Profiler::instance() noexcept {
+  static Profiler profiler;
+  return profiler;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+qint64 Profiler::getElapsedUs() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mTimer.isValid() ? (mTimer.nsecsElapsed() / 1000) : 0;
+}
+
+void Profiler::addEvent(const Event& event) noexcept {
+  QMutexLocker lock(&mMutex);
+  mEvents.append(event);
+  mEvents.last().threadIndex = getThreadIndex();
+}
+
+int Profiler::getThreadIndex() noexcept {
+  Qt::HANDLE thread = QThread::currentThreadId();
+  auto       it     = mThreadIndices.find(thread);
+  if (it == mThreadIndices.end()) {
+    it = mThreadIndices.insert(thread, mThreadIndices.count());
+  }
+  return *it;
+}
+
+/*******************************************************************************
+ *  Class ProfilerScope
+ ******************************************************************************/
+
+ProfilerScope::ProfilerScope(const char* category, const char* name,
+                             const QString& details) noexcept
+  : mActive(Profiler::instance().isEnabled()) {
+  if (mActive) {
+    mEvent.category     = category;
+    mEvent.name         = name;
+    mEvent.details      = details;
+    mEvent.threadIndex  = 0;
+    mEvent.memoryBefore = SystemInfo::getResidentMemoryUsage();
+    mEvent.memoryAfter  = -1;
+    mEvent.durationUs   = 0;
+    mEvent.startUs      = Profiler::instance().getElapsedUs();
+  }
+}
+
+ProfilerScope::~ProfilerScope() noexcept {
+  if (mActive) {
+    Profiler& profiler = Profiler::instance();
+    mEvent.durationUs  = profiler.getElapsedUs() - mEvent.startUs;
+    mEvent.memoryAfter = SystemInfo::getResidentMemoryUsage();
+    profiler.addEvent(mEvent);
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
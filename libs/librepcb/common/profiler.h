@@ -0,0 +1,168 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROFILER_H
+#define LIBREPCB_PROFILER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+/*******************************************************************************
+ *  Class Profiler
+ ******************************************************************************/
+
+/**
+ * @brief The Profiler class collects timings and memory usage of expensive
+ *        operations
+ *
+ * Operations are measured with librepcb::ProfilerScope objects. As long as the
+ * profiler is disabled (the default), these only check an atomic flag, so
+ * they are cheap enough to be placed in performance critical code. Once
+ * enabled with #setEnabled(), every measured operation is recorded as an
+ * event with its start time, duration, thread and the resident memory of the
+ * process before and after the operation. Additionally, arbitrary counters
+ * can be recorded with #addCounter().
+ *
+ * The recorded events can be exported in the Chrome trace event format with
+ * #toChromeTraceJson() or #saveChromeTrace(). Such files can be viewed with
+ * "chrome://tracing" or https://ui.perfetto.dev/.
+ *
+ * This class is a singleton, use #instance() to get it.
+ *
+ * @note All methods of this class are thread-safe.
+ */
+class Profiler final {
+  Q_DECLARE_TR_FUNCTIONS(Profiler)
+
+public:
+  // Types
+  struct Event {
+    const char* category;      ///< Category of the event (e.g. "board")
+    const char* name;          ///< Name of the event (e.g. "Load board")
+    QString     details;       ///< Optional details (e.g. the board name)
+    int         threadIndex;   ///< Sequential number of the thread
+    qint64      startUs;       ///< Start time since the profiler was enabled
+    qint64      durationUs;    ///< Duration, or -1 for counters
+    qint64      memoryBefore;  ///< Resident memory [bytes], or counter value
+    qint64      memoryAfter;   ///< Resident memory [bytes], or -1
+  };
+
+  // Constructors / Destructor
+  Profiler(const Profiler& other) = delete;
+  ~Profiler() noexcept;
+
+  // Getters
+  bool         isEnabled() const noexcept { return mEnabled.load() != 0; }
+  QList<Event> getEvents() const noexcept;
+  QByteArray   toChromeTraceJson() const noexcept;
+
+  // Setters
+  void setEnabled(bool enabled) noexcept;
+
+  // General Methods
+  void addCounter(const char* category, const char* name,
+                  qint64 value) noexcept;
+  void clear() noexcept;
+
+  /**
+   * @brief Save all recorded events as a Chrome trace JSON file
+   *
+   * @param filepath  The file to write. If it exists already, it will be
+   *                  overwritten.
+   *
+   * @throw Exception If the file could not be written
+   */
+  void saveChromeTrace(const FilePath& filepath) const;
+
+  // Operator Overloadings
+  Profiler& operator=(const Profiler& rhs) = delete;
+
+  // Static Methods
+  static Profiler& instance() noexcept;
+
+private:  // Methods
+  Profiler() noexcept;
+
+  qint64 getElapsedUs() const noexcept;
+  void   addEvent(const Event& event) noexcept;
+  int    getThreadIndex() noexcept;  // requires mMutex to be locked
+
+  friend class ProfilerScope;
+
+private:  // Data
+  QAtomicInt             mEnabled;
+  QElapsedTimer          mTimer;
+  mutable QMutex         mMutex;
+  QList<Event>           mEvents;
+  QHash<Qt::HANDLE, int> mThreadIndices;  ///< Key: QThread::currentThreadId()
+};
+
+/*******************************************************************************
+ *  Class ProfilerScope
+ ******************************************************************************/
+
+/**
+ * @brief Measures the execution time of the scope it is declared in
+ *
+ * Example:
+ *
+ * @code
+ * void Board::rebuildAllPlanes() noexcept {
+ *   ProfilerScope profilerScope("board", "Rebuild all planes", *mName);
+ *   ...
+ * }
+ * @endcode
+ *
+ * The category and name must be string literals (they are not copied). The
+ * event is only recorded if librepcb::Profiler was enabled when entering the
+ * scope.
+ */
+class ProfilerScope final {
+public:
+  // Constructors / Destructor
+  ProfilerScope()                           = delete;
+  ProfilerScope(const ProfilerScope& other) = delete;
+  ProfilerScope(const char* category, const char* name,
+                const QString& details = QString()) noexcept;
+  ~ProfilerScope() noexcept;
+
+  // Operator Overloadings
+  ProfilerScope& operator=(const ProfilerScope& rhs) = delete;
+
+private:  // Data
+  bool            mActive;
+  Profiler::Event mEvent;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROFILER_H
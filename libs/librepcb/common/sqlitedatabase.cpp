@@ -60,7 +60,8 @@ SQLiteDatabase::TransactionScopeGuard::~TransactionScopeGuard() noexcept {
  ******************************************************************************/
 
 SQLiteDatabase::SQLiteDatabase(const FilePath& filepath)
-  : QObject(nullptr)  //, mNestedTransactionCount(0)
+  : QObject(nullptr),
+    mQueryCache(sMaxCachedQueries)  //, mNestedTransactionCount(0)
 {
   // create database (use random UUID as connection name)
   mDb = QSqlDatabase::addDatabase("QSQLITE", Uuid::createRandom().toStr());
@@ -93,9 +94,74 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath)
 }
 
 SQLiteDatabase::~SQLiteDatabase() noexcept {
+  mQueryCache.clear();  // queries must be released before closing
   mDb.close();
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+bool SQLiteDatabase::isFts5Available() {
+  return getSqliteCompileOptions().contains("ENABLE_FTS5");  // can throw
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void SQLiteDatabase::setJournalMode(JournalMode mode) {
+  QString name;
+  switch (mode) {
+    case JournalMode::Delete:
+      name = "delete";
+      break;
+    case JournalMode::Truncate:
+      name = "truncate";
+      break;
+    case JournalMode::Persist:
+      name = "persist";
+      break;
+    case JournalMode::Memory:
+      name = "memory";
+      break;
+    case JournalMode::Wal:
+      name = "wal";
+      break;
+    case JournalMode::Off:
+      name = "off";
+      break;
+    default:
+      throw LogicError(__FILE__, __LINE__);
+  }
+  QSqlQuery query("PRAGMA journal_mode=" % name, mDb);
+  exec(query);  // can throw
+  bool    success = query.first();
+  QString result  = query.value(0).toString();
+  if ((!success) || (result != name)) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        QString(tr("Could not set SQLite journal mode to \"%1\": \"%2\""))
+            .arg(name, result));
+  }
+}
+
+void SQLiteDatabase::setSynchronous(Synchronous synchronous) {
+  switch (synchronous) {
+    case Synchronous::Off:
+      exec("PRAGMA synchronous=OFF");  // can throw
+      break;
+    case Synchronous::Normal:
+      exec("PRAGMA synchronous=NORMAL");  // can throw
+      break;
+    case Synchronous::Full:
+      exec("PRAGMA synchronous=FULL");  // can throw
+      break;
+    default:
+      throw LogicError(__FILE__, __LINE__);
+  }
+}
+
 /*******************************************************************************
  *  SQL Commands
  ******************************************************************************/
@@ -160,6 +226,56 @@ QSqlQuery SQLiteDatabase::prepareQuery(const QString& query) const {
   return q;
 }
 
+QSqlQuery& SQLiteDatabase::prepareCachedQuery(const QString& query) {
+  QSqlQuery* q = mQueryCache.object(query);  // marks it as recently used
+  if (!q) {
+    q = new QSqlQuery(prepareQuery(query));  // can throw
+    mQueryCache.insert(query, q);  // might discard the least recently used
+  } else {
+    q->finish();
+  }
+  return *q;
+}
+
+void SQLiteDatabase::insertRows(const QString&             table,
+                                const QStringList&         columns,
+                                const QList<QVariantList>& rows) {
+  Q_ASSERT(!columns.isEmpty());
+  QStringList valuePlaceholders;
+  for (int i = 0; i < columns.count(); ++i) {
+    valuePlaceholders.append("?");
+  }
+  QString rowPlaceholders = "(" % valuePlaceholders.join(", ") % ")";
+  int     maxRowsPerQuery = qMax(sMaxBoundValues / columns.count(), 1);
+  for (int first = 0; first < rows.count(); first += maxRowsPerQuery) {
+    int         count = qMin(rows.count() - first, maxRowsPerQuery);
+    QStringList placeholders;
+    for (int i = 0; i < count; ++i) {
+      placeholders.append(rowPlaceholders);
+    }
+    QString sql = "INSERT INTO " % table % " (" % columns.join(", ") %
+                  ") VALUES " % placeholders.join(", ");
+    // Only the query for full chunks is cached since it is used for all but
+    // the last chunk. The remaining rows have a different count every time.
+    QSqlQuery  remainder;
+    QSqlQuery* query = &remainder;
+    if (count == maxRowsPerQuery) {
+      query = &prepareCachedQuery(sql);  // can throw
+    } else {
+      remainder = prepareQuery(sql);  // can throw
+    }
+    int index = 0;
+    for (int i = first; i < first + count; ++i) {
+      const QVariantList& row = rows.at(i);
+      Q_ASSERT(row.count() == columns.count());
+      foreach (const QVariant& value, row) {
+        query->bindValue(index++, value);
+      }
+    }
+    exec(*query);  // can throw
+  }
+}
+
 int SQLiteDatabase::insert(QSqlQuery& query) {
   exec(query);  // can throw
 
@@ -194,15 +310,11 @@ void SQLiteDatabase::exec(const QString& query) {
  ******************************************************************************/
 
 void SQLiteDatabase::enableSqliteWriteAheadLogging() {
-  QSqlQuery query("PRAGMA journal_mode=WAL", mDb);
-  exec(query);  // can throw
-  bool    success = query.first();
-  QString result  = query.value(0).toString();
-  if ((!success) || (result != "wal")) {
-    throw LogicError(
-        __FILE__, __LINE__,
-        QString(tr("Could not enable SQLite Write-Ahead Logging: \"%1\""))
-            .arg(result));
+  try {
+    setJournalMode(JournalMode::Wal);  // can throw
+  } catch (const Exception& e) {
+    // LibrePCB does not work without WAL, thus it's considered as a bug
+    throw LogicError(__FILE__, __LINE__, e.getMsg());
   }
 }
 
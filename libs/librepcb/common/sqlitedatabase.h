@@ -49,6 +49,9 @@ class SQLiteDatabase final : public QObject {
 
 public:
   // Types
+  enum class JournalMode { Delete, Truncate, Persist, Memory, Wal, Off };
+  enum class Synchronous { Off, Normal, Full };
+
   class TransactionScopeGuard final {
   public:
     TransactionScopeGuard()                                   = delete;
@@ -69,6 +72,42 @@ public:
   SQLiteDatabase(const FilePath& filepath);
   ~SQLiteDatabase() noexcept;
 
+  // Getters
+
+  /**
+   * @brief Check whether the SQLite full-text search extension FTS5 is
+   *        available
+   *
+   * @see https://sqlite.org/fts5.html
+   */
+  bool isFts5Available();
+
+  // Setters
+
+  /**
+   * @brief Set the journal mode of the database
+   *
+   * @note The constructor enables JournalMode::Wal since LibrePCB requires it
+   *       to avoid blocking readers by writers (see
+   *       #enableSqliteWriteAheadLogging()). Only change it if the database
+   *       is not accessed concurrently.
+   *
+   * @see https://sqlite.org/pragma.html#pragma_journal_mode
+   */
+  void setJournalMode(JournalMode mode);
+
+  /**
+   * @brief Set how often SQLite waits for data to be written to disk
+   *
+   * With JournalMode::Wal, Synchronous::Normal is still safe against database
+   * corruption, but a committed transaction might be rolled back after a
+   * power loss. This is much faster than the default Synchronous::Full, so
+   * it is a good choice for databases which can be rebuilt anyway.
+   *
+   * @see https://sqlite.org/pragma.html#pragma_synchronous
+   */
+  void setSynchronous(Synchronous synchronous);
+
   // SQL Commands
   void beginTransaction();
   void commitTransaction();
@@ -77,9 +116,45 @@ public:
 
   // General Methods
   QSqlQuery prepareQuery(const QString& query) const;
-  int       insert(QSqlQuery& query);
-  void      exec(QSqlQuery& query);
-  void      exec(const QString& query);
+
+  /**
+   * @brief Get a prepared query from the statement cache
+   *
+   * The query is prepared only when it is requested for the first time, later
+   * calls with the same SQL text return the same query object again. This
+   * avoids the overhead of preparing queries which are executed many times.
+   * At most #sMaxCachedQueries queries are cached, the least recently used
+   * ones are discarded.
+   *
+   * @warning The returned query is reused by the next call with the same SQL
+   *          text, so finish using it (i.e. reading its results) before. It
+   *          is also deleted after #sMaxCachedQueries other queries were
+   *          requested, so don't keep the reference for long.
+   *
+   * @param query   The SQL text of the query
+   *
+   * @return The prepared query (with its results reset, but bound values kept)
+   */
+  QSqlQuery& prepareCachedQuery(const QString& query);
+
+  /**
+   * @brief Insert many rows into a table with as few queries as possible
+   *
+   * Multiple rows are inserted with a single "INSERT ... VALUES (...), (...)"
+   * query, limited by the maximum number of bound values per query. Only the
+   * query for this maximum number of rows is cached, not the one for the
+   * remaining rows.
+   *
+   * @param table     Name of the table
+   * @param columns   Names of the columns to insert
+   * @param rows      Values of all rows, in the same order as the columns
+   */
+  void insertRows(const QString& table, const QStringList& columns,
+                  const QList<QVariantList>& rows);
+
+  int  insert(QSqlQuery& query);
+  void exec(QSqlQuery& query);
+  void exec(const QString& query);
 
   // Operator Overloadings
   SQLiteDatabase& operator=(const SQLiteDatabase& rhs) = delete;
@@ -106,7 +181,15 @@ private:  // Methods
   QHash<QString, QString> getSqliteCompileOptions();
 
 private:  // Data
-  QSqlDatabase mDb;
+  QSqlDatabase               mDb;
+  QCache<QString, QSqlQuery> mQueryCache;  ///< Key: SQL text
+
+  /// Maximum number of prepared queries in #mQueryCache
+  static const int sMaxCachedQueries = 100;
+
+  /// Maximum number of bound values per query (SQLITE_MAX_VARIABLE_NUMBER of
+  /// older SQLite versions)
+  static const int sMaxBoundValues = 999;
   // int mNestedTransactionCount;
 };
 
@@ -33,6 +33,7 @@
 
 #include <cerrno>
 #include <libproc.h>
+#include <mach/mach.h>
 #include <signal.h>
 #elif defined(Q_OS_UNIX)  // UNIX/Linux
 #include <sys/types.h>
@@ -51,7 +52,10 @@
 #endif
 #define WINVER 0x0600
 #define _WIN32_WINNT 0x0600
+#define PSAPI_VERSION 2
 #include <windows.h>
+
+#include <psapi.h>
 #else
 #error "Unknown operating system!"
 #endif
@@ -298,6 +302,37 @@ QString SystemInfo::getProcessNameByPid(qint64 pid) {
   return processName;
 }
 
+qint64 SystemInfo::getResidentMemoryUsage() noexcept {
+#if defined(Q_OS_OSX)  // Mac OS X
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t      count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+    return static_cast<qint64>(info.resident_size);
+  }
+#elif defined(Q_OS_LINUX)
+  // The second field of /proc/self/statm is the resident set size in pages.
+  QFile file("/proc/self/statm");
+  if (file.open(QIODevice::ReadOnly)) {
+    QList<QByteArray> fields   = file.readLine().simplified().split(' ');
+    long              pageSize = sysconf(_SC_PAGESIZE);
+    bool              ok       = false;
+    if ((fields.count() > 1) && (pageSize > 0)) {
+      qint64 pages = fields.at(1).toLongLong(&ok);
+      if (ok) {
+        return pages * pageSize;
+      }
+    }
+  }
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64)  // Windows
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return static_cast<qint64>(counters.WorkingSetSize);
+  }
+#endif
+  return -1;  // not supported or failed
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
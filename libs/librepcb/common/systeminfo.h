@@ -104,6 +104,13 @@ public:
    */
   static QString getProcessNameByPid(qint64 pid);
 
+  /**
+   * @brief Get the resident memory (working set) of the current process
+   *
+   * @return  The resident memory in bytes, or -1 if it could not be determined
+   */
+  static qint64 getResidentMemoryUsage() noexcept;
+
 private:
   // Cached Data
   static QString sUsername;
@@ -105,19 +105,17 @@ ClipperLib::Paths ClipperHelpers::convert(
 ClipperLib::Path ClipperHelpers::convert(
     const Path& path, const PositiveLength& maxArcTolerance) noexcept {
   ClipperLib::Path p;
-  for (int i = 0; i < path.getVertices().count(); ++i) {
-    const Vertex& v  = path.getVertices().at(i);
-    const Vertex& v0 = path.getVertices().at(qMax(i - 1, 0));
-    if ((i == 0) || (v0.getAngle() == 0)) {
-      p.push_back(convert(v.getPos()));
-    } else {
-      // approximate arcs by many short straight line segments
-      Path arc = Path::flatArc(v0.getPos(), v.getPos(), v0.getAngle(),
-                               maxArcTolerance);
-      // skip first point as it is would be a duplicate
-      for (int k = 1; k < arc.getVertices().count(); ++k) {
-        p.push_back(convert(arc.getVertices().at(k).getPos()));
-      }
+  if (path.hasArcs()) {
+    // flattening arcs is expensive, so use the points cached in the path
+    const QVector<Point>& points = path.getFlattenedPoints(maxArcTolerance);
+    p.reserve(points.count());
+    foreach (const Point& point, points) {
+      p.push_back(convert(point));
+    }
+  } else {
+    p.reserve(path.getVertices().count());
+    foreach (const Vertex& vertex, path.getVertices()) {
+      p.push_back(convert(vertex.getPos()));
     }
   }
   // make sure all paths have the same orientation, otherwise we get strange
@@ -0,0 +1,129 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_UNIONFIND_H
+#define LIBREPCB_UNIONFIND_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <utility>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class UnionFind
+ ******************************************************************************/
+
+/**
+ * @brief Disjoint-set data structure to keep track of connected items
+ *
+ * Items are added implicitly when they are used the first time. Connecting
+ * two items with #unite() and checking whether two items are connected with
+ * #isConnected() both take nearly constant time (path compression and union
+ * by size).
+ *
+ * Items can't be disconnected again. To handle removed connections, #clear()
+ * the structure and unite all remaining connections again.
+ *
+ * @tparam T  Type of the items, must be usable as key of QHash (typically a
+ *            pointer)
+ */
+template <typename T>
+class UnionFind final {
+public:
+  // Constructors / Destructor
+  UnionFind() noexcept {}
+  UnionFind(const UnionFind& other) = default;
+  ~UnionFind() noexcept {}
+
+  // Getters
+  bool isEmpty() const noexcept { return mIndices.isEmpty(); }
+  int  getItemCount() const noexcept { return mIndices.count(); }
+  int  getSetCount() const noexcept { return mSetCount; }
+  bool contains(const T& item) const noexcept {
+    return mIndices.contains(item);
+  }
+  bool isConnected(const T& a, const T& b) noexcept {
+    return findRoot(getIndex(a)) == findRoot(getIndex(b));
+  }
+
+  // General Methods
+  void add(const T& item) noexcept { getIndex(item); }
+  void unite(const T& a, const T& b) noexcept {
+    int rootA = findRoot(getIndex(a));
+    int rootB = findRoot(getIndex(b));
+    if (rootA != rootB) {
+      if (mSizes.at(rootA) < mSizes.at(rootB)) {
+        std::swap(rootA, rootB);
+      }
+      mParents[rootB] = rootA;
+      mSizes[rootA] += mSizes.at(rootB);
+      --mSetCount;
+    }
+  }
+  void clear() noexcept {
+    mIndices.clear();
+    mParents.clear();
+    mSizes.clear();
+    mSetCount = 0;
+  }
+
+  // Operator Overloadings
+  UnionFind& operator=(const UnionFind& rhs) = default;
+
+private:  // Methods
+  int getIndex(const T& item) noexcept {
+    auto it = mIndices.find(item);
+    if (it == mIndices.end()) {
+      it = mIndices.insert(item, mParents.count());
+      mParents.append(*it);
+      mSizes.append(1);
+      ++mSetCount;
+    }
+    return *it;
+  }
+
+  int findRoot(int index) noexcept {
+    while (mParents.at(index) != index) {
+      mParents[index] = mParents.at(mParents.at(index));  // path halving
+      index           = mParents.at(index);
+    }
+    return index;
+  }
+
+private:  // Data
+  QHash<T, int> mIndices;       ///< Index of each item in the vectors below
+  QVector<int>  mParents;       ///< Parent index of each item
+  QVector<int>  mSizes;         ///< Size of each set (only valid for roots)
+  int           mSetCount = 0;  ///< Number of disjoint sets
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_UNIONFIND_H
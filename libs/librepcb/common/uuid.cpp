@@ -22,7 +22,6 @@
  ******************************************************************************/
 #include "uuid.h"
 
-#include <QRegularExpressionValidator>
 #include <QtCore>
 
 /*******************************************************************************
@@ -30,39 +29,55 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QString Uuid::toStr() const noexcept {
+  static const char hexDigits[] = "0123456789abcdef";
+  QString           str(36, Qt::Uninitialized);
+  QChar*            out   = str.data();
+  int               shift = 60;
+  for (int i = 0; i < 36; ++i) {
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      out[i] = QLatin1Char('-');
+    } else {
+      quint64 value = (i < 19) ? mHigh : mLow;
+      out[i]        = QLatin1Char(hexDigits[(value >> shift) & 0xF]);
+      shift         = (shift > 0) ? (shift - 4) : 60;
+    }
+  }
+  return str;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
 
 bool Uuid::isValid(const QString& str) noexcept {
-  // check format of string (only accept EXACT matches!)
-  QRegularExpression re(
-      "^[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$");
-  QRegularExpressionMatch match =
-      re.match(str, 0, QRegularExpression::PartialPreferCompleteMatch);
-  if (!match.hasMatch()) return false;
-
-  // check type of uuid
-  QUuid quuid(str);
-  if (quuid.isNull()) return false;
-  if (quuid.variant() != QUuid::DCE) return false;
-  if (quuid.version() != QUuid::Random) return false;
-  return true;
+  quint64 high, low;
+  return parse(str, high, low);
 }
 
 Uuid Uuid::createRandom() noexcept {
-  QString str =
-      QUuid::createUuid().toString().remove("{").remove("}").toLower();
-  if (isValid(str)) {
-    return Uuid(str);
-  } else {
+  QUuid quuid = QUuid::createUuid();
+  if ((quuid.variant() != QUuid::DCE) || (quuid.version() != QUuid::Random)) {
     qFatal("Not able to generate valid random UUID!");  // calls abort()!
   }
+  quint64 high = (static_cast<quint64>(quuid.data1) << 32) |
+                 (static_cast<quint64>(quuid.data2) << 16) |
+                 static_cast<quint64>(quuid.data3);
+  quint64 low = 0;
+  for (int i = 0; i < 8; ++i) {
+    low = (low << 8) | quuid.data4[i];
+  }
+  return Uuid(high, low);
 }
 
 Uuid Uuid::fromString(const QString& str) {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     throw RuntimeError(
         __FILE__, __LINE__,
@@ -71,13 +86,53 @@ Uuid Uuid::fromString(const QString& str) {
 }
 
 tl::optional<Uuid> Uuid::tryFromString(const QString& str) noexcept {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     return tl::nullopt;
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool Uuid::parse(const QString& str, quint64& high, quint64& low) noexcept {
+  // check format of string (only accept EXACT matches of lowercase UUIDs!)
+  if (str.length() != 36) return false;
+  quint64 values[2] = {0, 0};
+  int     digits    = 0;
+  for (int i = 0; i < 36; ++i) {
+    ushort c = str.at(i).unicode();
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      if (c != '-') return false;
+      continue;
+    }
+    quint64 nibble;
+    if ((c >= '0') && (c <= '9')) {
+      nibble = c - '0';
+    } else if ((c >= 'a') && (c <= 'f')) {
+      nibble = c - 'a' + 10;
+    } else {
+      return false;
+    }
+    quint64& value = values[digits / 16];
+    value          = (value << 4) | nibble;
+    ++digits;
+  }
+
+  // check type of uuid (only DCE variant in version 4 is accepted)
+  if ((str.at(14) != QLatin1Char('4')) ||
+      (((values[1] >> 62) & 0x3) != 0x2)) {
+    return false;
+  }
+
+  high = values[0];
+  low  = values[1];
+  return true;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -48,6 +48,12 @@ namespace librepcb {
  *
  * A valid UUID looks like this: "d79d354b-62bd-4866-996a-78941c575e78"
  *
+ * Internally, the UUID is stored as a 128-bit value (two 64-bit integers in
+ * big-endian order), so copying, comparing and hashing UUIDs does not need any
+ * heap allocations or string operations. Since the string representation is
+ * lowercase hexadecimal with dashes at fixed positions, comparing the 128-bit
+ * values leads to the same order as comparing the strings.
+ *
  * @note This class guarantees that only Uuid objects representing a valid UUID
  * can be created (in opposite to QUuid which allows "Null UUIDs")! If you need
  * a nullable UUID, use tl::optional<librepcb::Uuid> instead.
@@ -71,7 +77,7 @@ public:
    *
    * @param other     Another #Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept : mHigh(other.mHigh), mLow(other.mLow) {}
 
   /**
    * @brief Destructor
@@ -85,7 +91,18 @@ public:
    *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
+
+  /**
+   * @brief Get a hash value of the UUID
+   *
+   * @param seed      Seed for the hash function
+   *
+   * @return The hash value
+   */
+  uint hash(uint seed = 0) const noexcept {
+    return ::qHash(mHigh ^ mLow, seed);
+  }
 
   //@{
   /**
@@ -93,18 +110,23 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (same as comparing them as strings)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow  = rhs.mLow;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
   // Static Methods
@@ -150,14 +172,28 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its 128-bit value
+   *
+   * @param high      The upper 64 bits of the UUID
+   * @param low       The lower 64 bits of the UUID
+   */
+  Uuid(quint64 high, quint64 low) noexcept : mHigh(high), mLow(low) {}
+
+  /**
+   * @brief Parse a UUID string into its 128-bit value
+   *
+   * @param str       The string to parse
+   * @param high      Receives the upper 64 bits of the UUID
+   * @param low       Receives the lower 64 bits of the UUID
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @retval true     If str is a valid UUID
+   * @retval false    If str is not a valid UUID
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  static bool parse(const QString& str, quint64& high, quint64& low) noexcept;
 
 private:          // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  quint64 mHigh;  ///< Upper 64 bits, guaranteed to be a valid UUID
+  quint64 mLow;   ///< Lower 64 bits, guaranteed to be a valid UUID
 };
 
 /*******************************************************************************
@@ -206,7 +242,7 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  return key.hash(seed);
 }
 
 /*******************************************************************************
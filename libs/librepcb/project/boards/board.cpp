@@ -30,7 +30,10 @@
 #include "boardairwiresbuilder.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardlayerstack.h"
+#include "boardplanecache.h"
+#include "boardplanerebuildscheduler.h"
 #include "boardselectionquery.h"
+#include "boardspatialindex.h"
 #include "boardusersettings.h"
 #include "items/bi_airwire.h"
 #include "items/bi_device.h"
@@ -53,19 +56,49 @@
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/profiler.h>
 #include <librepcb/common/scopeguardlist.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/pkg/footprint.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 namespace project {
 
+/**
+ * @brief Sort vias, netpoints or netlines like the board's netsegment list and
+ *        the item lists of each netsegment
+ *
+ * The spatial index returns items in the order they were inserted, which
+ * changes e.g. when adding items to an existing netsegment or on undo/redo.
+ * This restores the (persistent) order used as selection priority.
+ */
+template <typename T>
+static void sortByNetSegmentOrder(
+    QList<T*>& items, const QList<BI_NetSegment*>& netsegments,
+    const QList<T*>& (BI_NetSegment::*getItems)() const) noexcept {
+  if (items.count() < 2) {
+    return;
+  }
+  QHash<const T*, QPair<int, int>> keys;
+  foreach (T* item, items) {
+    BI_NetSegment& netsegment = item->getNetSegment();
+    keys.insert(item, qMakePair(netsegments.indexOf(&netsegment),
+                                (netsegment.*getItems)().indexOf(item)));
+  }
+  std::sort(items.begin(), items.end(), [&keys](const T* a, const T* b) {
+    return keys.value(a) < keys.value(b);
+  });
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -80,7 +113,22 @@ Board::Board(const Board& other, const FilePath& filepath,
     mName(name),
     mDefaultFontFileName(other.mDefaultFontFileName) {
   try {
-    mGraphicsScene.reset(new GraphicsScene());
+    if (!mProject.isHeadless()) {
+      mGraphicsScene.reset(new GraphicsScene());
+    }
+    mSpatialIndex.reset(new BoardSpatialIndex());
+    mPlaneCache.reset(new BoardPlaneCache(*this));
+    mPlaneRebuildScheduler.reset(new BoardPlaneRebuildScheduler(*this));
+    connect(mPlaneRebuildScheduler.data(),
+            &BoardPlaneRebuildScheduler::finished, this,
+            &Board::triggerAirWiresRebuild);
+    mAirWiresRebuildTimer.setSingleShot(true);
+    mAirWiresRebuildTimer.setInterval(50);
+    connect(&mAirWiresRebuildTimer, &QTimer::timeout, this,
+            &Board::triggerAirWiresRebuild);
+    connect(mPlaneRebuildScheduler.data(),
+            &BoardPlaneRebuildScheduler::planesOutdatedChanged, this,
+            &Board::planesOutdatedChanged);
 
     // copy the other board
     mFile.reset(SmartSExprFile::create(mFilePath));
@@ -180,21 +228,48 @@ Board::Board(const Board& other, const FilePath& filepath,
     mGridProperties.reset();
     mLayerStack.reset();
     mFile.reset();
+    mPlaneRebuildScheduler.reset();
+    mPlaneCache.reset();
+    mSpatialIndex.reset();
     mGraphicsScene.reset();
     throw;  // ...and rethrow the exception
   }
 }
 
+Board::Board(Project& project, std::unique_ptr<SmartSExprFile> file,
+             const SExpression& root)
+  : Board(project, file->getFilepath(), file->isRestored(), file->isReadOnly(),
+          false, QString(), &file, &root) {
+}
+
 Board::Board(Project& project, const FilePath& filepath, bool restore,
-             bool readOnly, bool create, const QString& newName)
+             bool readOnly, bool create, const QString& newName,
+             std::unique_ptr<SmartSExprFile>* file, const SExpression* dom)
   : QObject(&project),
     mProject(project),
     mFilePath(filepath),
+    mFile(file ? file->release() : nullptr),
     mIsAddedToProject(false),
     mUuid(Uuid::createRandom()),
     mName("New Board") {
+  ProfilerScope profilerScope("board", "Load board", filepath.toNative());
   try {
-    mGraphicsScene.reset(new GraphicsScene());
+    if (!mProject.isHeadless()) {
+      mGraphicsScene.reset(new GraphicsScene());
+    }
+    mSpatialIndex.reset(new BoardSpatialIndex());
+    mPlaneCache.reset(new BoardPlaneCache(*this));
+    mPlaneRebuildScheduler.reset(new BoardPlaneRebuildScheduler(*this));
+    connect(mPlaneRebuildScheduler.data(),
+            &BoardPlaneRebuildScheduler::finished, this,
+            &Board::triggerAirWiresRebuild);
+    mAirWiresRebuildTimer.setSingleShot(true);
+    mAirWiresRebuildTimer.setInterval(50);
+    connect(&mAirWiresRebuildTimer, &QTimer::timeout, this,
+            &Board::triggerAirWiresRebuild);
+    connect(mPlaneRebuildScheduler.data(),
+            &BoardPlaneRebuildScheduler::planesOutdatedChanged, this,
+            &Board::planesOutdatedChanged);
 
     // try to open/create the board file
     if (create) {
@@ -230,8 +305,12 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
                       Path::rect(Point(0, 0), Point(100000000, 80000000)));
       mPolygons.append(new BI_Polygon(*this, polygon));
     } else {
-      mFile.reset(new SmartSExprFile(mFilePath, restore, readOnly));
-      SExpression root = mFile->parseFileAndBuildDomTree();
+      if (!mFile) {
+        mFile.reset(new SmartSExprFile(mFilePath, restore, readOnly));
+      }
+      SExpression parsedRoot =
+          dom ? SExpression() : mFile->parseFileAndBuildDomTree();
+      const SExpression& root = dom ? *dom : parsedRoot;
 
       // the board seems to be ready to open, so we will create all needed
       // objects
@@ -350,6 +429,9 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
     mGridProperties.reset();
     mLayerStack.reset();
     mFile.reset();
+    mPlaneRebuildScheduler.reset();
+    mPlaneCache.reset();
+    mSpatialIndex.reset();
     mGraphicsScene.reset();
     throw;  // ...and rethrow the exception
   }
@@ -358,6 +440,9 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
 Board::~Board() noexcept {
   Q_ASSERT(!mIsAddedToProject);
 
+  // wait until running plane rebuilds are finished
+  mPlaneRebuildScheduler.reset();
+
   qDeleteAll(mErcMsgListUnplacedComponentInstances);
   mErcMsgListUnplacedComponentInstances.clear();
 
@@ -383,6 +468,8 @@ Board::~Board() noexcept {
   mGridProperties.reset();
   mLayerStack.reset();
   mFile.reset();
+  mPlaneCache.reset();
+  mSpatialIndex.reset();
   mGraphicsScene.reset();
 }
 
@@ -412,19 +499,43 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
   foreach (BI_NetLine* netline, getNetLinesAtScenePos(pos, nullptr, nullptr)) {
     list.append(netline);
   }
+  // all other items, fetched from the spatial index and added in the order of
+  // the board's item lists (not in the order of the index) to get a stable
+  // selection priority
+  QSet<BI_Base*>            candidates;
+  QMap<Uuid, BI_Footprint*> footprints;  // sorted like devices
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    candidates.insert(item);
+    BI_Footprint* footprint = nullptr;
+    switch (item->getType()) {
+      case BI_Base::Type_t::Footprint:
+        footprint = static_cast<BI_Footprint*>(item);
+        break;
+      case BI_Base::Type_t::FootprintPad:
+        footprint = &static_cast<BI_FootprintPad*>(item)->getFootprint();
+        break;
+      case BI_Base::Type_t::StrokeText:
+        footprint = static_cast<BI_StrokeText*>(item)->getFootprint();
+        break;
+      default:
+        break;
+    }
+    if (footprint) {
+      footprints.insert(footprint->getComponentInstanceUuid(), footprint);
+    }
+  }
   // footprints & pads
-  foreach (BI_Device* device, mDeviceInstances) {
-    BI_Footprint& footprint = device->getFootprint();
-    if (footprint.isSelectable() &&
-        footprint.getGrabAreaScenePx().contains(scenePosPx)) {
-      if (footprint.getIsMirrored()) {
-        list.append(&footprint);
+  foreach (BI_Footprint* footprint, footprints) {
+    if (candidates.contains(footprint) && footprint->isSelectable() &&
+        footprint->getGrabAreaScenePx().contains(scenePosPx)) {
+      if (footprint->getIsMirrored()) {
+        list.append(footprint);
       } else {
-        list.prepend(&footprint);
+        list.prepend(footprint);
       }
     }
-    foreach (BI_FootprintPad* pad, footprint.getPads()) {
-      if (pad->isSelectable() &&
+    foreach (BI_FootprintPad* pad, footprint->getPads()) {
+      if (candidates.contains(pad) && pad->isSelectable() &&
           pad->getGrabAreaScenePx().contains(scenePosPx)) {
         if (pad->getIsMirrored()) {
           list.append(pad);
@@ -433,8 +544,8 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
         }
       }
     }
-    foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
-      if (text->isSelectable() &&
+    foreach (BI_StrokeText* text, footprint->getStrokeTexts()) {
+      if (candidates.contains(text) && text->isSelectable() &&
           text->getGrabAreaScenePx().contains(scenePosPx)) {
         if (GraphicsLayer::isTopLayer(*text->getText().getLayerName())) {
           list.prepend(text);
@@ -445,29 +556,29 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
     }
   }
   // planes
-  foreach (BI_Plane* planes, mPlanes) {
-    if (planes->isSelectable() &&
-        planes->getGrabAreaScenePx().contains(scenePosPx)) {
-      list.append(planes);
+  foreach (BI_Plane* plane, mPlanes) {
+    if (candidates.contains(plane) && plane->isSelectable() &&
+        plane->getGrabAreaScenePx().contains(scenePosPx)) {
+      list.append(plane);
     }
   }
   // polygons
   foreach (BI_Polygon* polygon, mPolygons) {
-    if (polygon->isSelectable() &&
+    if (candidates.contains(polygon) && polygon->isSelectable() &&
         polygon->getGrabAreaScenePx().contains(scenePosPx)) {
       list.append(polygon);
     }
   }
   // texts
   foreach (BI_StrokeText* text, mStrokeTexts) {
-    if (text->isSelectable() &&
+    if (candidates.contains(text) && text->isSelectable() &&
         text->getGrabAreaScenePx().contains(scenePosPx)) {
       list.append(text);
     }
   }
   // holes
   foreach (BI_Hole* hole, mHoles) {
-    if (hole->isSelectable() &&
+    if (candidates.contains(hole) && hole->isSelectable() &&
         hole->getGrabAreaScenePx().contains(scenePosPx)) {
       list.append(hole);
     }
@@ -478,51 +589,73 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
 QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
                                         const NetSignal* netsignal) const
     noexcept {
+  QPointF        scenePosPx = pos.toPxQPointF();
   QList<BI_Via*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getViasAtScenePos(pos, list);
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if (item->getType() != BI_Base::Type_t::Via) continue;
+    BI_Via* via = static_cast<BI_Via*>(item);
+    if (via->isSelectable() &&
+        via->getGrabAreaScenePx().contains(scenePosPx) &&
+        ((!netsignal) || (&via->getNetSignalOfNetSegment() == netsignal))) {
+      list.append(via);
     }
   }
+  sortByNetSegmentOrder(list, mNetSegments, &BI_NetSegment::getVias);
   return list;
 }
 
 QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF             scenePosPx = pos.toPxQPointF();
   QList<BI_NetPoint*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetPointsAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if (item->getType() != BI_Base::Type_t::NetPoint) continue;
+    BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+    if (netpoint->isSelectable() &&
+        netpoint->getGrabAreaScenePx().contains(scenePosPx) &&
+        ((!layer) || (netpoint->getLayerOfLines() == layer)) &&
+        ((!netsignal) ||
+         (&netpoint->getNetSignalOfNetSegment() == netsignal))) {
+      list.append(netpoint);
     }
   }
+  sortByNetSegmentOrder(list, mNetSegments, &BI_NetSegment::getNetPoints);
   return list;
 }
 
 QList<BI_NetLine*> Board::getNetLinesAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF            scenePosPx = pos.toPxQPointF();
   QList<BI_NetLine*> list;
-  foreach (BI_NetSegment* segment, mNetSegments) {
-    if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetLinesAtScenePos(pos, layer, list);
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if (item->getType() != BI_Base::Type_t::NetLine) continue;
+    BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+    if (netline->isSelectable() &&
+        netline->getGrabAreaScenePx().contains(scenePosPx) &&
+        ((!layer) || (&netline->getLayer() == layer)) &&
+        ((!netsignal) ||
+         (&netline->getNetSignalOfNetSegment() == netsignal))) {
+      list.append(netline);
     }
   }
+  sortByNetSegmentOrder(list, mNetSegments, &BI_NetSegment::getNetLines);
   return list;
 }
 
 QList<BI_FootprintPad*> Board::getPadsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QPointF                 scenePosPx = pos.toPxQPointF();
   QList<BI_FootprintPad*> list;
-  foreach (BI_Device* device, mDeviceInstances) {
-    foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
-      if (pad->isSelectable() &&
-          pad->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-          ((!layer) || (pad->isOnLayer(layer->getName()))) &&
-          ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))) {
-        list.append(pad);
-      }
+  foreach (BI_Base* item, mSpatialIndex->getItemsAt(scenePosPx)) {
+    if (item->getType() != BI_Base::Type_t::FootprintPad) continue;
+    BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+    if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(scenePosPx) &&
+        ((!layer) || (pad->isOnLayer(layer->getName()))) &&
+        ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))) {
+      list.append(pad);
     }
   }
   return list;
@@ -655,12 +788,27 @@ void Board::removePlane(BI_Plane& plane) {
 }
 
 void Board::rebuildAllPlanes() noexcept {
-  QList<BI_Plane*> planes = mPlanes;
-  qSort(planes.begin(), planes.end(),
-        [](const BI_Plane* p1, const BI_Plane* p2) {
-          return !(*p1 < *p2);
-        });  // sort by priority (highest priority first)
-  foreach (BI_Plane* plane, planes) { plane->rebuild(); }
+  ProfilerScope profilerScope("board", "Rebuild all planes", *mName);
+  mPlaneCache->invalidateAllPlanes();
+  rebuildDirtyPlanes();
+}
+
+void Board::rebuildDirtyPlanes() noexcept {
+  mPlaneRebuildScheduler->start();
+  mPlaneRebuildScheduler->waitForFinished();
+}
+
+void Board::startDirtyPlanesRebuild() noexcept {
+  mPlaneRebuildScheduler->start();
+}
+
+void Board::startAllPlanesRebuild() noexcept {
+  mPlaneCache->invalidateAllPlanes();
+  mPlaneRebuildScheduler->start();
+}
+
+bool Board::arePlanesOutdated() const noexcept {
+  return mPlaneRebuildScheduler->arePlanesOutdated();
 }
 
 /*******************************************************************************
@@ -731,44 +879,92 @@ void Board::removeHole(BI_Hole& hole) {
  ******************************************************************************/
 
 void Board::triggerAirWiresRebuild() noexcept {
+  mAirWiresRebuildTimer.stop();  // a deferred rebuild is not needed anymore
   if (!mIsAddedToProject) {
     return;
   }
 
+  struct Job {
+    NetSignal*                                  netsignal;
+    std::shared_ptr<BoardAirWiresBuilder>       builder;
+    std::shared_ptr<const BoardAirWiresBuilder> previous;
+    QVector<QPair<Point, Point>>                airwires;
+    QString                                     error;
+  };
+
   try {
+    // collect the input data of all modified net signals in the main thread
+    QVector<Job> jobs;
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
-      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
-        airWire->removeFromBoard();  // can throw
-        delete airWire;
-      }
-
+      Job job{netsignal, nullptr, nullptr, {}, QString()};
       if (netsignal && netsignal->isAddedToCircuit()) {
-        // calculate new airwires
-        BoardAirWiresBuilder         builder(*this, *netsignal);
-        QVector<QPair<Point, Point>> airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, points.first, points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.take());
+        job.builder = std::make_shared<BoardAirWiresBuilder>(*this, *netsignal);
+        job.previous = mAirWiresBuilders.value(netsignal);
+        if (job.previous && job.previous->hasSameInput(*job.builder)) {
+          continue;  // nothing has changed
         }
       }
+      jobs.append(job);
     }
     mScheduledNetSignalsForAirWireRebuild.clear();
+
+    // calculate the new airwires of all net signals in parallel
+    QtConcurrent::blockingMap(jobs, [](Job& job) {
+      try {
+        if (job.builder) {
+          // the previous triangulation is only updated around the changes
+          job.airwires = job.builder->buildAirWires(job.previous.get());
+        }
+      } catch (const std::exception& e) {
+        job.error = e.what();
+      }
+    });
+
+    // replace only the airwires which have actually changed
+    int triangulatedAnchors = 0;
+    foreach (const Job& job, jobs) {
+      if (job.error.isNull()) {
+        if (job.builder) {
+          triangulatedAnchors += job.builder->getTriangulatedAnchorCount();
+        }
+        updateAirWires(job.netsignal, job.airwires);  // can throw
+        mAirWiresBuilders.remove(job.netsignal);
+        if (job.builder) {
+          mAirWiresBuilders.insert(job.netsignal, job.builder);
+        }
+      } else {
+        qCritical() << "Failed to build airwires:" << job.error;
+      }
+    }
+    Profiler::instance().addCounter("board", "Triangulated airwire anchors",
+                                    triangulatedAnchors);
   } catch (const std::exception&
                e) {  // std::exception because of the many std containers...
     qCritical() << "Failed to build airwires:" << e.what();
   }
 }
 
+void Board::triggerAirWiresRebuildDeferred() noexcept {
+  // Do not restart an already running timer, otherwise the airwires would not
+  // be updated at all as long as the items are moved continuously.
+  if (!mAirWiresRebuildTimer.isActive()) {
+    mAirWiresRebuildTimer.start();
+  }
+}
+
 void Board::forceAirWiresRebuild() noexcept {
+  ProfilerScope profilerScope("board", "Rebuild all airwires", *mName);
+  QElapsedTimer timer;
+  timer.start();
+  mAirWiresBuilders.clear();
   mScheduledNetSignalsForAirWireRebuild.unite(
       mProject.getCircuit().getNetSignals().values().toSet());
   mScheduledNetSignalsForAirWireRebuild.unite(mAirWires.keys().toSet());
+  int count = mScheduledNetSignalsForAirWireRebuild.count();
   triggerAirWiresRebuild();
+  Profiler::instance().addCounter("board", "Airwires", mAirWires.count());
+  qDebug() << "Rebuilt airwires of" << count << "net signals in"
+           << timer.elapsed() << "ms.";
 }
 
 /*******************************************************************************
@@ -833,71 +1029,56 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept {
 }
 
 void Board::showInView(GraphicsView& view) noexcept {
+  Q_ASSERT(mGraphicsScene);  // not available in headless mode
   view.setScene(mGraphicsScene.data());
 }
 
 void Board::setSelectionRect(const Point& p1, const Point& p2,
                              bool updateItems) noexcept {
-  mGraphicsScene->setSelectionRect(p1, p2);
+  if (mGraphicsScene) {
+    mGraphicsScene->setSelectionRect(p1, p2);
+  }
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-    foreach (BI_Device* component, mDeviceInstances) {
-      BI_Footprint& footprint       = component->getFootprint();
-      bool          selectFootprint = footprint.isSelectable() &&
-                             footprint.getGrabAreaScenePx().intersects(rectPx);
-      footprint.setSelected(selectFootprint);
-      foreach (BI_FootprintPad* pad, footprint.getPads()) {
-        bool selectPad =
-            pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-        pad->setSelected(selectFootprint || selectPad);
-      }
-      foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
-        bool selectText = text->isSelectable() &&
-                          text->getGrabAreaScenePx().intersects(rectPx);
-        text->setSelected(selectFootprint || selectText);
+    // determine all items to be selected
+    QSet<BI_Base*> selection;
+    foreach (BI_Base* item, mSpatialIndex->getItemsInRect(rectPx)) {
+      if (item->isSelectable() &&
+          item->getGrabAreaScenePx().intersects(rectPx)) {
+        selection.insert(item);
+        if (item->getType() == BI_Base::Type_t::Footprint) {
+          // pads and texts are always selected together with their footprint
+          BI_Footprint* footprint = static_cast<BI_Footprint*>(item);
+          foreach (BI_FootprintPad* pad, footprint->getPads()) {
+            selection.insert(pad);
+          }
+          foreach (BI_StrokeText* text, footprint->getStrokeTexts()) {
+            selection.insert(text);
+          }
+        }
       }
     }
-    foreach (BI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
-    }
-    foreach (BI_Plane* plane, mPlanes) {
-      bool select = plane->isSelectable() &&
-                    plane->getGrabAreaScenePx().intersects(rectPx);
-      plane->setSelected(select);
-    }
-    foreach (BI_Polygon* polygon, mPolygons) {
-      bool select = polygon->isSelectable() &&
-                    polygon->getGrabAreaScenePx().intersects(rectPx);
-      polygon->setSelected(select);
-    }
-    foreach (BI_StrokeText* text, mStrokeTexts) {
-      bool select =
-          text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
-      text->setSelected(select);
-    }
-    foreach (BI_Hole* hole, mHoles) {
-      bool select =
-          hole->isSelectable() && hole->getGrabAreaScenePx().intersects(rectPx);
-      hole->setSelected(select);
+    // Note: Deselect items first since deselecting a footprint also deselects
+    // its pads and texts, which might be part of the new selection.
+    const QSet<BI_Base*> oldSelection = mSpatialIndex->getSelectedItems();
+    foreach (BI_Base* item, oldSelection) {
+      if (!selection.contains(item)) {
+        item->setSelected(false);
+      }
     }
+    foreach (BI_Base* item, selection) { item->setSelected(true); }
   }
 }
 
 void Board::clearSelection() const noexcept {
-  foreach (BI_Device* device, mDeviceInstances)
-    device->getFootprint().setSelected(false);
-  foreach (BI_NetSegment* segment, mNetSegments) { segment->clearSelection(); }
-  foreach (BI_Plane* plane, mPlanes) { plane->setSelected(false); }
-  foreach (BI_Polygon* polygon, mPolygons) { polygon->setSelected(false); }
-  foreach (BI_StrokeText* text, mStrokeTexts) { text->setSelected(false); }
-  foreach (BI_Hole* hole, mHoles) { hole->setSelected(false); }
+  const QSet<BI_Base*> selection = mSpatialIndex->getSelectedItems();
+  foreach (BI_Base* item, selection) { item->setSelected(false); }
 }
 
 std::unique_ptr<BoardSelectionQuery> Board::createSelectionQuery() const
     noexcept {
   return std::unique_ptr<BoardSelectionQuery>(new BoardSelectionQuery(
-      mDeviceInstances, mNetSegments, mPlanes, mPolygons, mStrokeTexts, mHoles,
-      const_cast<Board*>(this)));
+      mSpatialIndex->getSelectedItems(), const_cast<Board*>(this)));
 }
 
 /*******************************************************************************
@@ -922,6 +1103,9 @@ QVector<const AttributeProvider*> Board::getAttributeProviderParents() const
  ******************************************************************************/
 
 void Board::updateIcon() noexcept {
+  if (!mGraphicsScene) {
+    return;  // headless mode, nothing to render
+  }
   QRectF source =
       mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
   QRect target(0, 0, 297, 210);  // DIN A4 format :-)
@@ -959,6 +1143,8 @@ void Board::serialize(SExpression& root) const {
 }
 
 void Board::updateErcMessages() noexcept {
+  ProfilerScope profilerScope("board", "Update ERC messages", *mName);
+
   // type: UnplacedComponent (ComponentInstances without DeviceInstance)
   if (mIsAddedToProject) {
     const QMap<Uuid, ComponentInstance*>& componentInstances =
@@ -992,13 +1178,50 @@ void Board::updateErcMessages() noexcept {
   }
 }
 
+void Board::updateAirWires(NetSignal*                          netsignal,
+                           const QVector<QPair<Point, Point>>& airwires) {
+  // airwires have no direction, so use a unique order of their points
+  auto key = [](const Point& p1, const Point& p2) {
+    bool swap = (p2.getX() < p1.getX()) ||
+                ((p2.getX() == p1.getX()) && (p2.getY() < p1.getY()));
+    return swap ? qMakePair(p2, p1) : qMakePair(p1, p2);
+  };
+  QHash<QPair<Point, Point>, int> newAirWires;  // value: count
+  foreach (const auto& points, airwires) {
+    ++newAirWires[key(points.first, points.second)];
+  }
+
+  // remove obsolete airwires and keep all others
+  foreach (BI_AirWire* airWire, mAirWires.values(netsignal)) {
+    auto it = newAirWires.find(key(airWire->getP1(), airWire->getP2()));
+    if ((it != newAirWires.end()) && (it.value() > 0)) {
+      --it.value();
+    } else {
+      airWire->removeFromBoard();  // can throw
+      mAirWires.remove(netsignal, airWire);
+      delete airWire;
+    }
+  }
+
+  // add new airwires
+  for (auto it = newAirWires.constBegin(); it != newAirWires.constEnd(); ++it) {
+    for (int i = 0; i < it.value(); ++i) {
+      QScopedPointer<BI_AirWire> airWire(
+          new BI_AirWire(*this, *netsignal, it.key().first, it.key().second));
+      airWire->addToBoard();  // can throw
+      mAirWires.insertMulti(netsignal, airWire.take());
+    }
+  }
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
 
 Board* Board::create(Project& project, const FilePath& filepath,
                      const ElementName& name) {
-  return new Board(project, filepath, false, false, true, *name);
+  return new Board(project, filepath, false, false, true, *name, nullptr,
+                   nullptr);
 }
 
 /*******************************************************************************
@@ -66,10 +66,14 @@ class BI_StrokeText;
 class BI_Hole;
 class BI_Plane;
 class BI_AirWire;
+class BoardAirWiresBuilder;
 class BoardLayerStack;
 class BoardFabricationOutputSettings;
 class BoardUserSettings;
 class BoardSelectionQuery;
+class BoardSpatialIndex;
+class BoardPlaneCache;
+class BoardPlaneRebuildScheduler;
 
 /*******************************************************************************
  *  Class Board
@@ -123,7 +127,21 @@ public:
   Board(const Board& other) = delete;
   Board(const Board& other, const FilePath& filepath, const ElementName& name);
   Board(Project& project, const FilePath& filepath, bool restore, bool readOnly)
-    : Board(project, filepath, restore, readOnly, false, QString()) {}
+    : Board(project, filepath, restore, readOnly, false, QString(), nullptr,
+            nullptr) {}
+
+  /**
+   * @brief Load a board from an already opened and parsed file
+   *
+   * Allows to parse the files of several boards in parallel.
+   *
+   * @param project   The project the board belongs to
+   * @param file      The opened board file
+   * @param root      The parsed content of the file (must be kept alive
+   *                  until the constructor returns, it is not copied)
+   */
+  Board(Project& project, std::unique_ptr<SmartSExprFile> file,
+        const SExpression& root);
   ~Board() noexcept;
 
   // Getters: General
@@ -133,6 +151,10 @@ public:
     return *mGridProperties;
   }
   GraphicsScene&   getGraphicsScene() const noexcept { return *mGraphicsScene; }
+  BoardSpatialIndex& getSpatialIndex() const noexcept {
+    return *mSpatialIndex;
+  }
+  BoardPlaneCache& getPlaneCache() const noexcept { return *mPlaneCache; }
   BoardLayerStack& getLayerStack() noexcept { return *mLayerStack; }
   const BoardLayerStack& getLayerStack() const noexcept { return *mLayerStack; }
   BoardDesignRules&      getDesignRules() noexcept { return *mDesignRules; }
@@ -196,6 +218,10 @@ public:
   void                    addPlane(BI_Plane& plane);
   void                    removePlane(BI_Plane& plane);
   void                    rebuildAllPlanes() noexcept;
+  void                    rebuildDirtyPlanes() noexcept;
+  void                    startDirtyPlanesRebuild() noexcept;
+  void                    startAllPlanesRebuild() noexcept;
+  bool                    arePlanesOutdated() const noexcept;
 
   // Polygon Methods
   const QList<BI_Polygon*>& getPolygons() const noexcept { return mPolygons; }
@@ -219,6 +245,7 @@ public:
     mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
   }
   void triggerAirWiresRebuild() noexcept;
+  void triggerAirWiresRebuildDeferred() noexcept;
   void forceAirWiresRebuild() noexcept;
 
   // General Methods
@@ -256,12 +283,16 @@ signals:
 
   void deviceAdded(BI_Device& comp);
   void deviceRemoved(BI_Device& comp);
+  void planesOutdatedChanged(bool outdated);
 
 private:
   Board(Project& project, const FilePath& filepath, bool restore, bool readOnly,
-        bool create, const QString& newName);
+        bool create, const QString& newName,
+        std::unique_ptr<SmartSExprFile>* file, const SExpression* dom);
   void updateIcon() noexcept;
   void updateErcMessages() noexcept;
+  void updateAirWires(NetSignal*                          netsignal,
+                      const QVector<QPair<Point, Point>>& airwires);
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -273,6 +304,9 @@ private:
   bool                           mIsAddedToProject;
 
   QScopedPointer<GraphicsScene>                  mGraphicsScene;
+  QScopedPointer<BoardSpatialIndex>              mSpatialIndex;
+  QScopedPointer<BoardPlaneCache>                mPlaneCache;
+  QScopedPointer<BoardPlaneRebuildScheduler>     mPlaneRebuildScheduler;
   QScopedPointer<BoardLayerStack>                mLayerStack;
   QScopedPointer<GridProperties>                 mGridProperties;
   QScopedPointer<BoardDesignRules>               mDesignRules;
@@ -281,6 +315,12 @@ private:
   QRectF                                         mViewRect;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
 
+  /// The builders of the current airwires, to detect unchanged input data
+  QHash<NetSignal*, std::shared_ptr<BoardAirWiresBuilder>> mAirWiresBuilders;
+
+  /// Limits the airwire rebuild rate while items are dragged around
+  QTimer mAirWiresRebuildTimer;
+
   // Attributes
   Uuid        mUuid;
   ElementName mName;
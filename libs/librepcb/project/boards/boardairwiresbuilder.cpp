@@ -36,202 +36,434 @@
 
 #include <delaunay-triangulation/delaunay.h>
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/unionfind.h>
 #include <librepcb/library/pkg/footprintpad.h>
-#include <unordered_map>
 
 #include <QtCore>
 
+#include <algorithm>
+#include <tuple>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 namespace project {
 
-// adapted from horizon/kicad
+/**
+ * @brief Kruskal's algorithm with a union-find (disjoint set) data structure
+ *
+ * Edges with a negative weight are already connected, all other edges which
+ * end up in the minimum spanning tree are returned as airwires.
+ */
 static QVector<QPair<Point, Point>> kruskalMst(
-    std::vector<delaunay::Edge<qreal>>&    aEdges,
-    std::vector<delaunay::Vector2<qreal>>& aNodes) noexcept {
-  unsigned int nodeNumber      = aNodes.size();
-  unsigned int mstExpectedSize = nodeNumber - 1;
-  unsigned int mstSize         = 0;
-  bool         ratsnestLines   = false;
-
-  // printf("mst nodes : %d edges : %d\n", aNodes.size(), aEdges.size () );
-  // The output
+    std::vector<delaunay::Edge<qreal>>& edges, int nodeCount) noexcept {
+  // Kruskal algorithm requires edges to be sorted by their weight, this also
+  // processes all connected edges (weight < 0) before any airwire candidate
+  std::sort(edges.begin(), edges.end(),
+            [](const delaunay::Edge<qreal>& a, const delaunay::Edge<qreal>& b) {
+              return a.weight < b.weight;
+            });
+
+  // each node is a subtree on its own at the beginning
+  UnionFind<int> subtrees;
+  for (int i = 0; i < nodeCount; ++i) {
+    subtrees.add(i);
+  }
+
   QVector<QPair<Point, Point>> mst;
+  for (const auto& edge : edges) {
+    if (subtrees.getSetCount() <= 1) {
+      break;  // all nodes are connected
+    }
+    if (subtrees.isConnected(edge.p1.id, edge.p2.id)) {
+      continue;  // edge would create a cycle
+    }
+    subtrees.unite(edge.p1.id, edge.p2.id);
+    if (edge.weight >= 0) {
+      mst.append(
+          qMakePair(Point(edge.p1.x, edge.p1.y), Point(edge.p2.x, edge.p2.y)));
+    }
+  }
+  return mst;
+}
 
-  // Set tags for marking cycles
-  std::unordered_map<int, int> tags;
-  unsigned int                 tag = 0;
+/**
+ * @brief Determine the edges of the Delaunay triangulation of some points
+ *
+ * @return IDs of the connected points, each edge only once with the lower ID
+ *         first
+ */
+static QVector<QPair<int, int>> triangulate(
+    std::vector<delaunay::Vector2<qreal>> points) {
+  QSet<QPair<int, int>> edges;
+  std::sort(points.begin(), points.end(),
+            [](const delaunay::Vector2<qreal>& a,
+               const delaunay::Vector2<qreal>& b) {
+              return std::make_tuple(a.x, a.y, a.id) <
+                  std::make_tuple(b.x, b.y, b.id);
+            });
 
-  for (auto& node : aNodes) {
-    node.tag      = tag;
-    tags[node.id] = tag++;
+  // collinear points have no triangulation, so just connect them in a row
+  // (coordinates are integers in nanometers, so compare them exactly)
+  bool collinear = true;
+  if (!points.empty()) {
+    qint64 dx = qint64(points.back().x) - qint64(points.front().x);
+    qint64 dy = qint64(points.back().y) - qint64(points.front().y);
+    for (const auto& p : points) {
+      qint64 px = qint64(p.x) - qint64(points.front().x);
+      qint64 py = qint64(p.y) - qint64(points.front().y);
+      collinear = collinear && (dx * py == dy * px);
+    }
   }
 
-  // Lists of nodes connected together (subtrees) to detect cycles in the
-  // graph
-  std::vector<std::list<int>> cycles(nodeNumber);
+  if (collinear) {
+    for (std::size_t i = 1; i < points.size(); ++i) {
+      edges.insert(qMakePair(qMin(points[i - 1].id, points[i].id),
+                             qMax(points[i - 1].id, points[i].id)));
+    }
+  } else {
+    delaunay::Delaunay<qreal> del;
+    del.triangulate(points);
+    for (const auto& edge : del.getEdges()) {
+      edges.insert(qMakePair(qMin(edge.p1.id, edge.p2.id),
+                             qMax(edge.p1.id, edge.p2.id)));
+    }
+  }
+  QVector<QPair<int, int>> list = edges.toList().toVector();
+  std::sort(list.begin(), list.end());
+  return list;
+}
 
-  for (unsigned int i = 0; i < nodeNumber; ++i) cycles[i].push_back(i);
+/**
+ * @brief Check whether a point lies within the circumcircle of a triangle
+ *
+ * Points on the circle are considered as inside, with a tolerance for
+ * rounding errors. Degenerated triangles (collinear points) have no
+ * circumcircle.
+ */
+static bool isInCircumCircle(const delaunay::Vector2<qreal>& a,
+                             const delaunay::Vector2<qreal>& b,
+                             const delaunay::Vector2<qreal>& c,
+                             const delaunay::Vector2<qreal>& p) noexcept {
+  qreal orientation = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+  if (orientation == 0) {
+    return false;
+  }
+  qreal adx = a.x - p.x, ady = a.y - p.y;
+  qreal bdx = b.x - p.x, bdy = b.y - p.y;
+  qreal cdx = c.x - p.x, cdy = c.y - p.y;
+  qreal ta  = (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy);
+  qreal tb  = (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy);
+  qreal tc  = (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+  qreal det = ta + tb + tc;
+  qreal tolerance = 1e-9 * (qAbs(ta) + qAbs(tb) + qAbs(tc));
+  return (orientation > 0) ? (det >= -tolerance) : (det <= tolerance);
+}
 
-  // Kruskal algorithm requires edges to be sorted by their weight
-  std::sort(aEdges.begin(), aEdges.end(),
-            [](const delaunay::Edge<qreal>& a, const delaunay::Edge<qreal>& b) {
-              return a.weight > b.weight;
-            });
+/**
+ * @brief Check whether a point lies within a triangle or on its border
+ */
+static bool isInTriangle(const delaunay::Vector2<qreal>& a,
+                         const delaunay::Vector2<qreal>& b,
+                         const delaunay::Vector2<qreal>& c,
+                         const delaunay::Vector2<qreal>& p) noexcept {
+  auto side = [&p](const delaunay::Vector2<qreal>& v1,
+                   const delaunay::Vector2<qreal>& v2) {
+    return (v2.x - v1.x) * (p.y - v1.y) - (v2.y - v1.y) * (p.x - v1.x);
+  };
+  qreal s1 = side(a, b), s2 = side(b, c), s3 = side(c, a);
+  bool  hasNegative = (s1 < 0) || (s2 < 0) || (s3 < 0);
+  bool  hasPositive = (s1 > 0) || (s2 > 0) || (s3 > 0);
+  return !(hasNegative && hasPositive);
+}
 
-  while (mstSize < mstExpectedSize && !aEdges.empty()) {
-    auto& dt = aEdges.back();
-
-    int srcTag = tags[dt.p1.id];
-    int trgTag = tags[dt.p2.id];
-    // printf("mstSize %d %d %f %d<>%d\n", mstSize, mstExpectedSize,
-    // dt.weight, srcTag, trgTag);
-
-    // Check if by adding this edge we are going to join two different
-    // forests
-    if (srcTag != trgTag) {
-      // Because edges are sorted by their weight, first we always process
-      // connected
-      // items (weight == 0). Once we stumble upon an edge with non-zero
-      // weight,
-      // it means that the rest of the lines are ratsnest.
-      if (!ratsnestLines && dt.weight >= 0) ratsnestLines = true;
-
-      // Update tags
-      if (ratsnestLines) {
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[aNodes[*it].id] = srcTag;
-        }
+/**
+ * @brief Update a Delaunay triangulation after some points have changed
+ *
+ * Only the neighbourhood of the changed points is triangulated again, like
+ * in an incremental Delaunay triangulation:
+ *
+ *   - The hole of each group of adjacent removed points is filled with the
+ *     triangulation of the points around it.
+ *   - Each inserted point is connected to the points of all triangles whose
+ *     circumcircle contains it (the cavity of the Bowyer-Watson algorithm).
+ *
+ * In both cases, the existing edges between the points of the neighbourhood
+ * are replaced by the edges of its triangulation. For degenerated cases
+ * (e.g. cocircular points on a grid) this may keep a few edges which are not
+ * part of the exact triangulation, but it never misses one, so the minimum
+ * spanning tree built from these edges is still exact.
+ *
+ * @param points          All current points (ID = index)
+ * @param previousEdges   Edges of the previous triangulation (previous IDs)
+ * @param previousIds     Current ID of each previous point, or -1 if the
+ *                        point has been removed or moved
+ * @param insertedIds     IDs of the new or moved points
+ * @param edges           Returns the edges of the updated triangulation
+ *
+ * @return Number of points which have been triangulated again, or -1 if an
+ *         inserted point lies outside of the triangulation (then a full
+ *         triangulation is needed)
+ */
+static int updateTriangulation(
+    const std::vector<delaunay::Vector2<qreal>>& points,
+    const QVector<QPair<int, int>>&              previousEdges,
+    const QVector<int>& previousIds, const QVector<int>& insertedIds,
+    QVector<QPair<int, int>>& edges) {
+  QVector<QSet<int>> adjacency(points.size());
+  auto               connect = [&adjacency](int a, int b) {
+    adjacency[a].insert(b);
+    adjacency[b].insert(a);
+  };
+  auto retriangulate = [&points, &adjacency, &connect](const QSet<int>& ids) {
+    std::vector<delaunay::Vector2<qreal>> localPoints;
+    foreach (int id, ids) {
+      adjacency[id] -= ids;
+      localPoints.push_back(points[id]);
+    }
+    foreach (const auto& edge, triangulate(localPoints)) {
+      connect(edge.first, edge.second);
+    }
+    return ids.count();
+  };
+  int count = 0;
+
+  // keep the edges between unchanged points
+  QHash<int, QVector<int>> removedNeighbours;  // previous IDs
+  foreach (const auto& edge, previousEdges) {
+    int a = previousIds.at(edge.first);
+    int b = previousIds.at(edge.second);
+    if ((a >= 0) && (b >= 0)) {
+      connect(a, b);
+    }
+    if (a < 0) {
+      removedNeighbours[edge.first].append(edge.second);
+    }
+    if (b < 0) {
+      removedNeighbours[edge.second].append(edge.first);
+    }
+  }
 
-        // Do a copy of edge, but make it RN_EDGE_MST. In contrary to
-        // RN_EDGE,
-        // RN_EDGE_MST saves both source and target node and does not
-        // require any other
-        // edges to exist for getting source/target nodes
-        // CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(),
-        // dt.GetWeight() );
-
-        // assert( newEdge.GetSourceNode()->GetTag() !=
-        // newEdge.GetTargetNode()->GetTag() );
-        // assert(dt.p1.tag != dt.p2.tag);
-        mst.append(qMakePair(Point(dt.p1.x, dt.p1.y), Point(dt.p2.x, dt.p2.y)));
-        ++mstSize;
-      } else {
-        // for( it = cycles[trgTag].begin(), itEnd =
-        // cycles[trgTag].end(); it != itEnd; ++it )
-        // for( auto it : cycles[trgTag] )
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[aNodes[*it].id] = srcTag;
-          aNodes[*it].tag      = srcTag;
+  // fill the hole of each group of adjacent removed points
+  QSet<int> visited;
+  foreach (int removedId, removedNeighbours.keys()) {
+    if (visited.contains(removedId)) {
+      continue;
+    }
+    QSet<int>    hole;
+    QVector<int> stack = {removedId};
+    visited.insert(removedId);
+    while (!stack.isEmpty()) {
+      foreach (int neighbour, removedNeighbours.value(stack.takeLast())) {
+        if (previousIds.at(neighbour) >= 0) {
+          hole.insert(previousIds.at(neighbour));
+        } else if (!visited.contains(neighbour)) {
+          visited.insert(neighbour);
+          stack.append(neighbour);
         }
-
-        // Processing a connection, decrease the expected size of the
-        // ratsnest MST
-        --mstExpectedSize;
       }
+    }
+    count += retriangulate(hole);
+  }
 
-      // Move nodes that were marked with old tag to the list marked with
-      // the new tag
-      cycles[srcTag].splice(cycles[srcTag].end(), cycles[trgTag]);
+  // insert the new points
+  QVector<bool> isTriangulated(points.size(), true);
+  foreach (int id, insertedIds) {
+    isTriangulated[id] = false;
+  }
+  foreach (int id, insertedIds) {
+    const delaunay::Vector2<qreal>& p = points[id];
+
+    // the nearest point is always a neighbour of the inserted point
+    int   nearest     = -1;
+    qreal nearestDist = 0;
+    for (int i = 0; i < static_cast<int>(points.size()); ++i) {
+      qreal dist = points[i].dist2(p);
+      if (isTriangulated.at(i) && ((nearest < 0) || (dist < nearestDist))) {
+        nearest     = i;
+        nearestDist = dist;
+      }
+    }
+    if (nearest < 0) {
+      return -1;
     }
 
-    // Remove the edge that was just processed
-    aEdges.pop_back();
+    // collect the points of all triangles whose circumcircle contains the
+    // inserted point, starting at the triangles around the nearest point
+    QSet<int> cavity = {id, nearest};
+    if (nearestDist > 0) {
+      bool         enclosed = false;
+      QSet<int>    visitedPoints = {nearest};
+      QVector<int> stack         = {nearest};
+      while (!stack.isEmpty()) {
+        int              a          = stack.takeLast();
+        const QSet<int>& neighbours = adjacency.at(a);
+        foreach (int b, neighbours) {
+          foreach (int c, neighbours) {
+            if ((b < c) && adjacency.at(b).contains(c) &&
+                isInCircumCircle(points[a], points[b], points[c], p)) {
+              enclosed = enclosed ||
+                         isInTriangle(points[a], points[b], points[c], p);
+              for (int v : {b, c}) {
+                cavity.insert(v);
+                if (!visitedPoints.contains(v)) {
+                  visitedPoints.insert(v);
+                  stack.append(v);
+                }
+              }
+            }
+          }
+        }
+      }
+      if (!enclosed) {
+        return -1;  // the point lies outside of the triangulation
+      }
+    }
+    count += retriangulate(cavity);
+    isTriangulated[id] = true;
   }
 
-  return mst;
+  edges.clear();
+  for (int a = 0; a < adjacency.count(); ++a) {
+    foreach (int b, adjacency.at(a)) {
+      if (a < b) {
+        edges.append(qMakePair(a, b));
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return count;
 }
 
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardAirWiresBuilder::BoardAirWiresBuilder(const Board&     board,
-                                           const NetSignal& netsignal) noexcept
-  : mBoard(board), mNetSignal(netsignal) {
-}
-
-BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
-}
-
-/*******************************************************************************
- *  General Methods
- ******************************************************************************/
-
-QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
-  std::vector<delaunay::Vector2<qreal>> points;
-  QHash<const BI_NetLineAnchor*, int>   anchorMap;
-  QHash<int, QString>                   layerMap;
-  std::vector<delaunay::Edge<qreal>>    edges;
+BoardAirWiresBuilder::BoardAirWiresBuilder(
+    const Board& board, const NetSignal& netsignal) noexcept
+  : mTriangulatedAnchorCount(0) {
+  QHash<const BI_NetLineAnchor*, int> anchorMap;
 
   // pads
-  foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
+  foreach (ComponentSignalInstance* cmpSig, netsignal.getComponentSignals()) {
     Q_ASSERT(cmpSig);
     foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
-      if (&pad->getBoard() != &mBoard) continue;
-      int   id  = points.size();
-      Point pos = pad->getPosition();
-      points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-      anchorMap[pad] = id;
+      if (&pad->getBoard() != &board) continue;
+      anchorMap[pad] = mAnchors.count();
       if (pad->getLibPad().getBoardSide() ==
           library::FootprintPad::BoardSide::THT) {
-        layerMap[id] = QString();  // on all layers
+        mAnchors.append(
+            Anchor{pad, pad->getPosition(), QString()});  // all layers
       } else {
-        layerMap[id] = pad->getLayerName();
+        mAnchors.append(Anchor{pad, pad->getPosition(), pad->getLayerName()});
       }
     }
   }
 
   // vias, netpoints, netlines
-  foreach (const BI_NetSegment* netsegment, mNetSignal.getBoardNetSegments()) {
+  foreach (const BI_NetSegment* netsegment, netsignal.getBoardNetSegments()) {
     Q_ASSERT(netsegment);
-    if (&netsegment->getBoard() != &mBoard) continue;
+    if (&netsegment->getBoard() != &board) continue;
     foreach (const BI_Via* via, netsegment->getVias()) {
       Q_ASSERT(via);
-      int   id  = points.size();
-      Point pos = via->getPosition();
-      points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-      anchorMap[via] = id;
-      layerMap[id]   = QString();  // on all layers
+      anchorMap[via] = mAnchors.count();
+      mAnchors.append(
+          Anchor{via, via->getPosition(), QString()});  // all layers
     }
     foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
       Q_ASSERT(netpoint);
       if (const GraphicsLayer* layer = netpoint->getLayerOfLines()) {
-        int   id  = points.size();
-        Point pos = netpoint->getPosition();
-        points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), id);
-        anchorMap[netpoint] = id;
-        layerMap[id]        = layer->getName();
+        anchorMap[netpoint] = mAnchors.count();
+        mAnchors.append(
+            Anchor{netpoint, netpoint->getPosition(), layer->getName()});
       }
     }
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       Q_ASSERT(netline);
       Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
       Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      edges.emplace_back(points[anchorMap[&netline->getStartPoint()]],
-                         points[anchorMap[&netline->getEndPoint()]], -1);
+      mConnections.append(qMakePair(anchorMap[&netline->getStartPoint()],
+                                    anchorMap[&netline->getEndPoint()]));
     }
   }
 
-  // determine connections made by planes
-  foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
+  // planes
+  foreach (const BI_Plane* plane, netsignal.getBoardPlanes()) {
     Q_ASSERT(plane);
-    if (&plane->getBoard() != &mBoard) continue;
-    foreach (const Path& fragment, plane->getFragments()) {
-      int lastId = -1;
-      for (const auto& point : points) {
-        QString pointLayer = layerMap[point.id];
-        if (pointLayer.isNull() || (pointLayer == plane->getLayerName())) {
-          Point p(point.x, point.y);
-          if (fragment.toQPainterPathPx().contains(p.toPxQPointF())) {
+    if (&plane->getBoard() != &board) continue;
+    mPlaneAreas.append(
+        PlaneArea{*plane->getLayerName(), plane->getFragments()});
+  }
+}
+
+BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+bool BoardAirWiresBuilder::hasSameInput(
+    const BoardAirWiresBuilder& other) const noexcept {
+  return (mAnchors == other.mAnchors) && (mConnections == other.mConnections) &&
+         (mPlaneAreas == other.mPlaneAreas);
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires(
+    const BoardAirWiresBuilder* previous) {
+  std::vector<delaunay::Vector2<qreal>> points;
+  std::vector<delaunay::Edge<qreal>>    edges;
+
+  // anchors
+  points.reserve(mAnchors.count());
+  for (int i = 0; i < mAnchors.count(); ++i) {
+    const Point& pos = mAnchors.at(i).position;
+    points.emplace_back(pos.getX().toNm(), pos.getY().toNm(), i);
+  }
+
+  // Delaunay triangulation of the anchors, only updated around the changed
+  // anchors if there are just a few (a planar triangulation has less than
+  // three edges per point, more edges have accumulated by degenerated cases)
+  mTriangulatedAnchorCount = -1;
+  QVector<int> previousIds, insertedIds;
+  if (previous &&
+      (findChangedAnchors(*previous, previousIds, insertedIds) <=
+       mAnchors.count() / 4)) {
+    mTriangulatedAnchorCount =
+        updateTriangulation(points, previous->mTriangulation, previousIds,
+                            insertedIds, mTriangulation);
+  }
+  if ((mTriangulatedAnchorCount < 0) ||
+      (mTriangulation.count() >= 3 * mAnchors.count())) {
+    mTriangulation           = triangulate(points);
+    mTriangulatedAnchorCount = mAnchors.count();
+  }
+
+  // connections made by netlines
+  foreach (const auto& connection, mConnections) {
+    edges.emplace_back(points[connection.first], points[connection.second],
+                       -1);
+  }
+
+  // determine connections made by planes
+  foreach (const PlaneArea& plane, mPlaneAreas) {
+    foreach (const Path& fragment, plane.fragments) {
+      QPainterPath area   = fragment.toQPainterPathPx();
+      int          lastId = -1;
+      for (int i = 0; i < mAnchors.count(); ++i) {
+        const Anchor& anchor = mAnchors.at(i);
+        if (anchor.layerName.isNull() ||
+            (anchor.layerName == plane.layerName)) {
+          if (area.contains(anchor.position.toPxQPointF())) {
             if (lastId >= 0) {
-              edges.emplace_back(points[lastId], points[point.id], -1);
+              edges.emplace_back(points[lastId], points[i], -1);
             }
-            lastId = point.id;
+            lastId = i;
           }
         }
       }
@@ -241,13 +473,9 @@ QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
   // remember how many edges are already known as connected
   uint connectedEdges = edges.size();
 
-  // determine additional edges between found points (candidates for airwires)
-  if (points.size() >= 3) {  // minimum 3 points needed for triangulation
-    delaunay::Delaunay<qreal> del;
-    del.triangulate(points);
-    edges.insert(edges.end(), del.getEdges().begin(), del.getEdges().end());
-  } else if (points.size() == 2) {
-    edges.emplace_back(points[0], points[1], -1);
+  // the edges of the triangulation are the candidates for airwires
+  foreach (const auto& edge, mTriangulation) {
+    edges.emplace_back(points[edge.first], points[edge.second], -1);
   }
 
   // determine weights of these new edges
@@ -256,7 +484,43 @@ QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
   }
 
   // find airwires in list of edges
-  return kruskalMst(edges, points);
+  return kruskalMst(edges, points.size());
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+int BoardAirWiresBuilder::findChangedAnchors(
+    const BoardAirWiresBuilder& previous, QVector<int>& previousIds,
+    QVector<int>& insertedIds) const noexcept {
+  QHash<const BI_NetLineAnchor*, int> ids;
+  for (int i = 0; i < mAnchors.count(); ++i) {
+    ids.insert(mAnchors.at(i).item, i);
+  }
+
+  // anchors of the same item at the same position are unchanged, all others
+  // are removed and/or inserted
+  int           count = 0;
+  QVector<bool> isInserted(mAnchors.count(), true);
+  previousIds.fill(-1, previous.mAnchors.count());
+  for (int i = 0; i < previous.mAnchors.count(); ++i) {
+    const Anchor& anchor = previous.mAnchors.at(i);
+    int           id     = ids.value(anchor.item, -1);
+    if ((id >= 0) && (mAnchors.at(id).position == anchor.position)) {
+      previousIds[i] = id;
+      isInserted[id] = false;
+    } else {
+      ++count;
+    }
+  }
+  insertedIds.clear();
+  for (int i = 0; i < mAnchors.count(); ++i) {
+    if (isInserted.at(i)) {
+      insertedIds.append(i);
+    }
+  }
+  return count + insertedIds.count();
 }
 
 /*******************************************************************************
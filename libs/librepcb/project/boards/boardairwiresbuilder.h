@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
 #include <librepcb/common/units/point.h>
 
 #include <QtCore>
@@ -35,13 +36,29 @@ namespace project {
 
 class NetSignal;
 class Board;
+class BI_NetLineAnchor;
 
 /*******************************************************************************
  *  Class BoardAirWiresBuilder
  ******************************************************************************/
 
 /**
- * @brief The BoardAirWiresBuilder class
+ * @brief Determines the airwires of a net signal on a board
+ *
+ * The constructor collects all anchors (pads, vias, netpoints), the existing
+ * connections (netlines) and the plane fragments of the net signal, so
+ * #buildAirWires() works only on this snapshot and never accesses the board.
+ * Therefore it is safe to build the airwires of several net signals in
+ * parallel on worker threads.
+ *
+ * Since building the airwires of large nets is expensive (Delaunay
+ * triangulation and minimum spanning tree), the board keeps the builder of
+ * the last run for each net signal and compares its input data with a new
+ * builder (see #hasSameInput()) to skip the rebuild if nothing has changed.
+ * If only a few anchors have been moved, added or removed, the new builder
+ * updates the Delaunay triangulation of the previous builder only around
+ * these anchors instead of triangulating the whole net again (see
+ * #buildAirWires()).
  */
 class BoardAirWiresBuilder final {
 public:
@@ -51,15 +68,66 @@ public:
   BoardAirWiresBuilder(const Board& board, const NetSignal& netsignal) noexcept;
   ~BoardAirWiresBuilder() noexcept;
 
+  // Getters
+  bool hasSameInput(const BoardAirWiresBuilder& other) const noexcept;
+  int  getTriangulatedAnchorCount() const noexcept {
+    return mTriangulatedAnchorCount;
+  }
+
   // General Methods
-  QVector<QPair<Point, Point>> buildAirWires() const;
+
+  /**
+   * @brief Build the airwires
+   *
+   * @param previous  The builder of the last run for the same net signal, if
+   *                  any. Its triangulation is reused if only a few anchors
+   *                  have changed. It must not be modified concurrently.
+   *
+   * @return The airwires as pairs of their start and end points
+   */
+  QVector<QPair<Point, Point>> buildAirWires(
+      const BoardAirWiresBuilder* previous);
 
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
 
+private:  // Types
+  struct Anchor {
+    const BI_NetLineAnchor* item;  ///< Only to identify it, never accessed
+    Point                   position;
+    QString                 layerName;  ///< Null if on all copper layers
+
+    bool operator==(const Anchor& rhs) const noexcept {
+      return (position == rhs.position) && (layerName == rhs.layerName);
+    }
+  };
+
+  struct PlaneArea {
+    QString       layerName;
+    QVector<Path> fragments;
+
+    bool operator==(const PlaneArea& rhs) const noexcept {
+      return (layerName == rhs.layerName) && (fragments == rhs.fragments);
+    }
+  };
+
+private:  // Methods
+  int findChangedAnchors(const BoardAirWiresBuilder& previous,
+                         QVector<int>&               previousIds,
+                         QVector<int>&               insertedIds) const
+      noexcept;
+
 private:  // Data
-  const Board&     mBoard;
-  const NetSignal& mNetSignal;
+  QVector<Anchor>          mAnchors;
+  QVector<QPair<int, int>> mConnections;  ///< Indices of connected anchors
+  QVector<PlaneArea>       mPlaneAreas;
+
+  /// Edges of the Delaunay triangulation (indices of anchors), set by
+  /// #buildAirWires()
+  QVector<QPair<int, int>> mTriangulation;
+
+  /// Number of anchors triangulated by the last #buildAirWires() call
+  int mTriangulatedAnchorCount;
 };
 
 /*******************************************************************************
@@ -45,9 +45,11 @@
 #include <librepcb/common/cam/gerbergenerator.h>
 #include <librepcb/common/geometry/hole.h>
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/profiler.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -80,28 +82,43 @@ FilePath BoardGerberExport::getOutputDirectory() const noexcept {
  ******************************************************************************/
 
 void BoardGerberExport::exportAllLayers() const {
+  ProfilerScope profilerScope("gerber", "Export fabrication data",
+                              *mBoard.getName());
   mWrittenFiles.clear();
 
-  if (mBoard.getFabricationOutputSettings().getMergeDrillFiles()) {
-    exportDrills();
-  } else {
-    exportDrillsNpth();
-    exportDrillsPth();
-  }
-  exportLayerBoardOutlines();
-  exportLayerTopCopper();
-  exportLayerInnerCopper();
-  exportLayerBottomCopper();
-  exportLayerTopSolderMask();
-  exportLayerBottomSolderMask();
-  exportLayerTopSilkscreen();
-  exportLayerBottomSilkscreen();
-  if (mBoard.getFabricationOutputSettings().getEnableSolderPasteTop()) {
-    exportLayerTopSolderPaste();
-  }
-  if (mBoard.getFabricationOutputSettings().getEnableSolderPasteBot()) {
-    exportLayerBottomSolderPaste();
+  // sort all items only once for all layers
+  const SortedItems items = sortItems();
+
+  // generate all files in parallel
+  QList<Job>           jobs = createJobs(items);
+  QList<QFuture<bool>> futures;
+  foreach (const Job& job, jobs) {
+    futures.append(QtConcurrent::run([job]() {
+      ProfilerScope profilerScope("gerber", "Export file",
+                                  job.filepath.getFilename());
+      return job.function(job.filepath);
+    }));
+  }
+
+  // wait until all jobs are finished, even if some of them failed, since
+  // they access this object and the sorted items
+  foreach (QFuture<bool> future, futures) {
+    try {
+      future.waitForFinished();  // can throw
+    } catch (...) {
+      // will be rethrown below
+    }
   }
+
+  // collect written files in the same order as generated (throws the
+  // exception of the first failed job, if any)
+  for (int i = 0; i < jobs.count(); ++i) {
+    if (futures.at(i).result()) {  // can throw
+      mWrittenFiles.append(jobs.at(i).filepath);
+    }
+  }
+  Profiler::instance().addCounter("gerber", "Written files",
+                                  mWrittenFiles.count());
 }
 
 /*******************************************************************************
@@ -126,22 +143,102 @@ BoardGerberExport::getAttributeProviderParents() const noexcept {
  *  Private Methods
  ******************************************************************************/
 
-void BoardGerberExport::exportDrills() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrills());
+BoardGerberExport::SortedItems BoardGerberExport::sortItems() const noexcept {
+  SortedItems items;
+  foreach (const BI_NetSegment* netsegment,
+           sortedByUuid(mBoard.getNetSegments())) {
+    Q_ASSERT(netsegment);
+    items.vias += sortedByUuid(netsegment->getVias());
+    items.netLines += sortedByUuid(netsegment->getNetLines());
+  }
+  items.planes      = sortedByUuid(mBoard.getPlanes());
+  items.polygons    = sortedByUuid(mBoard.getPolygons());
+  items.strokeTexts = sortedByUuid(mBoard.getStrokeTexts());
+  return items;
+}
+
+QList<BoardGerberExport::Job> BoardGerberExport::createJobs(
+    const SortedItems& items) const {
+  // Note: The file paths need to be determined in this thread since they
+  // depend on mCurrentInnerCopperLayer.
+  const BoardFabricationOutputSettings& settings =
+      mBoard.getFabricationOutputSettings();
+  QList<Job> jobs;
+
+  auto addJob = [&](const QString&                       suffix,
+                    std::function<bool(const FilePath&)> function) {
+    jobs.append(Job{getOutputFilePath(suffix), function});
+  };
+  if (settings.getMergeDrillFiles()) {
+    addJob(settings.getSuffixDrills(), [this, &items](const FilePath& fp) {
+      return exportDrills(fp, items);
+    });
+  } else {
+    addJob(settings.getSuffixDrillsNpth(), [this, &items](const FilePath& fp) {
+      return exportDrillsNpth(fp, items);
+    });
+    addJob(settings.getSuffixDrillsPth(), [this, &items](const FilePath& fp) {
+      return exportDrillsPth(fp, items);
+    });
+  }
+  addJob(settings.getSuffixOutlines(), [this, &items](const FilePath& fp) {
+    return exportLayerBoardOutlines(fp, items);
+  });
+  addJob(settings.getSuffixCopperTop(), [this, &items](const FilePath& fp) {
+    return exportLayerTopCopper(fp, items);
+  });
+  for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
+    mCurrentInnerCopperLayer = i;  // used for attribute provider
+    addJob(settings.getSuffixCopperInner(),
+           [this, &items, i](const FilePath& fp) {
+             return exportLayerInnerCopper(fp, items, i);
+           });
+  }
+  mCurrentInnerCopperLayer = 0;
+  addJob(settings.getSuffixCopperBot(), [this, &items](const FilePath& fp) {
+    return exportLayerBottomCopper(fp, items);
+  });
+  addJob(settings.getSuffixSolderMaskTop(), [this, &items](const FilePath& fp) {
+    return exportLayerTopSolderMask(fp, items);
+  });
+  addJob(settings.getSuffixSolderMaskBot(), [this, &items](const FilePath& fp) {
+    return exportLayerBottomSolderMask(fp, items);
+  });
+  addJob(settings.getSuffixSilkscreenTop(), [this, &items](const FilePath& fp) {
+    return exportLayerTopSilkscreen(fp, items);
+  });
+  addJob(settings.getSuffixSilkscreenBot(), [this, &items](const FilePath& fp) {
+    return exportLayerBottomSilkscreen(fp, items);
+  });
+  if (settings.getEnableSolderPasteTop()) {
+    addJob(settings.getSuffixSolderPasteTop(),
+           [this, &items](const FilePath& fp) {
+             return exportLayerTopSolderPaste(fp, items);
+           });
+  }
+  if (settings.getEnableSolderPasteBot()) {
+    addJob(settings.getSuffixSolderPasteBot(),
+           [this, &items](const FilePath& fp) {
+             return exportLayerBottomSolderPaste(fp, items);
+           });
+  }
+  return jobs;
+}
+
+bool BoardGerberExport::exportDrills(const FilePath&    fp,
+                                     const SortedItems& items) const {
   ExcellonGenerator gen;
-  drawPthDrills(gen);
-  drawNpthDrills(gen);
+  drawPthDrills(gen, items);
+  drawNpthDrills(gen, items);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportDrillsNpth() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrillsNpth());
+bool BoardGerberExport::exportDrillsNpth(const FilePath&    fp,
+                                         const SortedItems& items) const {
   ExcellonGenerator gen;
-  int               count = drawNpthDrills(gen);
+  int               count = drawNpthDrills(gen, items);
   if (count > 0) {
     // Some PCB manufacturers don't like to have separate drill files for PTH
     // and NPTH. As many boards don't have non-plated holes anyway, we create
@@ -149,159 +246,159 @@ void BoardGerberExport::exportDrillsNpth() const {
     // issues with manufacturers...
     gen.generate();
     gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+    return true;
   }
+  return false;
 }
 
-void BoardGerberExport::exportDrillsPth() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixDrillsPth());
+bool BoardGerberExport::exportDrillsPth(const FilePath&    fp,
+                                        const SortedItems& items) const {
   ExcellonGenerator gen;
-  drawPthDrills(gen);
+  drawPthDrills(gen, items);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerBoardOutlines() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixOutlines());
+bool BoardGerberExport::exportLayerBoardOutlines(
+    const FilePath& fp, const SortedItems& items) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBoardOutlines);
+  gen.enableStreaming();  // can throw
+  drawLayer(gen, items, GraphicsLayer::sBoardOutlines);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerTopCopper() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixCopperTop());
+bool BoardGerberExport::exportLayerTopCopper(const FilePath&    fp,
+                                             const SortedItems& items) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopCopper);
+  gen.enableStreaming();  // can throw
+  drawLayer(gen, items, GraphicsLayer::sTopCopper);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerBottomCopper() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixCopperBot());
+bool BoardGerberExport::exportLayerBottomCopper(
+    const FilePath& fp, const SortedItems& items) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotCopper);
+  gen.enableStreaming();  // can throw
+  drawLayer(gen, items, GraphicsLayer::sBotCopper);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerInnerCopper() const {
-  for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
-    mCurrentInnerCopperLayer = i;  // used for attribute provider
-    FilePath fp              = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixCopperInner());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::getInnerLayerName(i));
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
-  mCurrentInnerCopperLayer = 0;
+bool BoardGerberExport::exportLayerInnerCopper(const FilePath&    fp,
+                                               const SortedItems& items,
+                                               int                layer) const {
+  GerberGenerator gen(
+      mProject.getMetadata().getName() % " - " % mBoard.getName(),
+      mBoard.getUuid(), mProject.getMetadata().getVersion());
+  gen.enableStreaming();  // can throw
+  drawLayer(gen, items, GraphicsLayer::getInnerLayerName(layer));
+  gen.generate();
+  gen.saveToFile(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerTopSolderMask() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderMaskTop());
+bool BoardGerberExport::exportLayerTopSolderMask(
+    const FilePath& fp, const SortedItems& items) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopStopMask);
+  gen.enableStreaming();  // can throw
+  drawLayer(gen, items, GraphicsLayer::sTopStopMask);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerBottomSolderMask() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderMaskBot());
+bool BoardGerberExport::exportLayerBottomSolderMask(
+    const FilePath& fp, const SortedItems& items) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotStopMask);
+  gen.enableStreaming();  // can throw
+  drawLayer(gen, items, GraphicsLayer::sBotStopMask);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerTopSilkscreen() const {
+bool BoardGerberExport::exportLayerTopSilkscreen(
+    const FilePath& fp, const SortedItems& items) const {
   QStringList layers =
       mBoard.getFabricationOutputSettings().getSilkscreenLayersTop();
   if (layers.count() >
       0) {  // don't create silkscreen file if no layers selected
-    FilePath fp = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixSilkscreenTop());
     GerberGenerator gen(
         mProject.getMetadata().getName() % " - " % mBoard.getName(),
         mBoard.getUuid(), mProject.getMetadata().getVersion());
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
+    gen.enableStreaming();  // can throw
+    foreach (const QString& layer, layers) { drawLayer(gen, items, layer); }
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sTopStopMask);
+    drawLayer(gen, items, GraphicsLayer::sTopStopMask);
     gen.generate();
     gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+    return true;
   }
+  return false;
 }
 
-void BoardGerberExport::exportLayerBottomSilkscreen() const {
+bool BoardGerberExport::exportLayerBottomSilkscreen(
+    const FilePath& fp, const SortedItems& items) const {
   QStringList layers =
       mBoard.getFabricationOutputSettings().getSilkscreenLayersBot();
   if (layers.count() >
       0) {  // don't create silkscreen file if no layers selected
-    FilePath fp = getOutputFilePath(
-        mBoard.getFabricationOutputSettings().getSuffixSilkscreenBot());
     GerberGenerator gen(
         mProject.getMetadata().getName() % " - " % mBoard.getName(),
         mBoard.getUuid(), mProject.getMetadata().getVersion());
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
+    gen.enableStreaming();  // can throw
+    foreach (const QString& layer, layers) { drawLayer(gen, items, layer); }
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sBotStopMask);
+    drawLayer(gen, items, GraphicsLayer::sBotStopMask);
     gen.generate();
     gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+    return true;
   }
+  return false;
 }
 
-void BoardGerberExport::exportLayerTopSolderPaste() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderPasteTop());
+bool BoardGerberExport::exportLayerTopSolderPaste(
+    const FilePath& fp, const SortedItems& items) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopSolderPaste);
+  gen.enableStreaming();  // can throw
+  drawLayer(gen, items, GraphicsLayer::sTopSolderPaste);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-void BoardGerberExport::exportLayerBottomSolderPaste() const {
-  FilePath fp = getOutputFilePath(
-      mBoard.getFabricationOutputSettings().getSuffixSolderPasteBot());
+bool BoardGerberExport::exportLayerBottomSolderPaste(
+    const FilePath& fp, const SortedItems& items) const {
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotSolderPaste);
+  gen.enableStreaming();  // can throw
+  drawLayer(gen, items, GraphicsLayer::sBotSolderPaste);
   gen.generate();
   gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return true;
 }
 
-int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
+int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen,
+                                      const SortedItems& items) const {
   int count = 0;
 
   // footprint holes
@@ -322,7 +419,8 @@ int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
   return count;
 }
 
-int BoardGerberExport::drawPthDrills(ExcellonGenerator& gen) const {
+int BoardGerberExport::drawPthDrills(ExcellonGenerator& gen,
+                                     const SortedItems& items) const {
   int count = 0;
 
   // footprint pads
@@ -339,19 +437,17 @@ int BoardGerberExport::drawPthDrills(ExcellonGenerator& gen) const {
   }
 
   // vias
-  foreach (const BI_NetSegment* netsegment,
-           sortedByUuid(mBoard.getNetSegments())) {
-    foreach (const BI_Via* via, sortedByUuid(netsegment->getVias())) {
-      gen.drill(via->getPosition(), via->getDrillDiameter());
-      ++count;
-    }
+  foreach (const BI_Via* via, items.vias) {
+    gen.drill(via->getPosition(), via->getDrillDiameter());
+    ++count;
   }
 
   return count;
 }
 
-void BoardGerberExport::drawLayer(GerberGenerator& gen,
-                                  const QString&   layerName) const {
+void BoardGerberExport::drawLayer(GerberGenerator&   gen,
+                                  const SortedItems& items,
+                                  const QString&     layerName) const {
   // draw footprints incl. pads
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
     Q_ASSERT(device);
@@ -359,32 +455,23 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen,
   }
 
   // draw vias
-  foreach (const BI_NetSegment* netsegment,
-           sortedByUuid(mBoard.getNetSegments())) {
-    Q_ASSERT(netsegment);
-    foreach (const BI_Via* via, sortedByUuid(netsegment->getVias())) {
-      Q_ASSERT(via);
-      drawVia(gen, *via, layerName);
-    }
+  foreach (const BI_Via* via, items.vias) {
+    Q_ASSERT(via);
+    drawVia(gen, *via, layerName);
   }
 
   // draw traces
-  foreach (const BI_NetSegment* netsegment,
-           sortedByUuid(mBoard.getNetSegments())) {
-    Q_ASSERT(netsegment);
-    foreach (const BI_NetLine* netline,
-             sortedByUuid(netsegment->getNetLines())) {
-      Q_ASSERT(netline);
-      if (netline->getLayer().getName() == layerName) {
-        gen.drawLine(netline->getStartPoint().getPosition(),
-                     netline->getEndPoint().getPosition(),
-                     positiveToUnsigned(netline->getWidth()));
-      }
+  foreach (const BI_NetLine* netline, items.netLines) {
+    Q_ASSERT(netline);
+    if (netline->getLayer().getName() == layerName) {
+      gen.drawLine(netline->getStartPoint().getPosition(),
+                   netline->getEndPoint().getPosition(),
+                   positiveToUnsigned(netline->getWidth()));
     }
   }
 
   // draw planes
-  foreach (const BI_Plane* plane, sortedByUuid(mBoard.getPlanes())) {
+  foreach (const BI_Plane* plane, items.planes) {
     Q_ASSERT(plane);
     if (plane->getLayerName() == layerName) {
       foreach (const Path& fragment, plane->getFragments()) {
@@ -394,7 +481,7 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen,
   }
 
   // draw polygons
-  foreach (const BI_Polygon* polygon, sortedByUuid(mBoard.getPolygons())) {
+  foreach (const BI_Polygon* polygon, items.polygons) {
     Q_ASSERT(polygon);
     if (layerName == polygon->getPolygon().getLayerName()) {
       UnsignedLength lineWidth =
@@ -404,7 +491,7 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen,
   }
 
   // draw stroke texts
-  foreach (const BI_StrokeText* text, sortedByUuid(mBoard.getStrokeTexts())) {
+  foreach (const BI_StrokeText* text, items.strokeTexts) {
     Q_ASSERT(text);
     if (layerName == text->getText().getLayerName()) {
       UnsignedLength lineWidth =
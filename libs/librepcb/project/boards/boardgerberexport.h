@@ -29,6 +29,8 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -44,6 +46,10 @@ namespace project {
 class Project;
 class Board;
 class BI_Via;
+class BI_NetLine;
+class BI_Plane;
+class BI_Polygon;
+class BI_StrokeText;
 class BI_Footprint;
 class BI_FootprintPad;
 
@@ -54,6 +60,12 @@ class BI_FootprintPad;
 /**
  * @brief The BoardGerberExport class
  *
+ * All files are generated at the same time in the global thread pool. The
+ * board items are sorted only once before (by UUID, to get reproducible
+ * files) and passed to all jobs by const reference. Since neither the board
+ * nor this object are modified during the export, all threads read from the
+ * same data. The generated files are identical to a serial export.
+ *
  * @author ubruhin
  * @date 2016-01-10
  */
@@ -90,24 +102,49 @@ signals:
   void attributesChanged() override;
 
 private:
+  // Types
+  struct Job {
+    FilePath                             filepath;
+    std::function<bool(const FilePath&)> function;  ///< false if not written
+  };
+  struct SortedItems {
+    QList<BI_Via*>        vias;      ///< Sorted by net segment, then by via
+    QList<BI_NetLine*>    netLines;  ///< Sorted by net segment, then by line
+    QList<BI_Plane*>      planes;
+    QList<BI_Polygon*>    polygons;
+    QList<BI_StrokeText*> strokeTexts;
+  };
+
   // Private Methods
-  void exportDrills() const;
-  void exportDrillsNpth() const;
-  void exportDrillsPth() const;
-  void exportLayerBoardOutlines() const;
-  void exportLayerTopCopper() const;
-  void exportLayerInnerCopper() const;
-  void exportLayerBottomCopper() const;
-  void exportLayerTopSolderMask() const;
-  void exportLayerBottomSolderMask() const;
-  void exportLayerTopSilkscreen() const;
-  void exportLayerBottomSilkscreen() const;
-  void exportLayerTopSolderPaste() const;
-  void exportLayerBottomSolderPaste() const;
-
-  int  drawNpthDrills(ExcellonGenerator& gen) const;
-  int  drawPthDrills(ExcellonGenerator& gen) const;
-  void drawLayer(GerberGenerator& gen, const QString& layerName) const;
+  SortedItems sortItems() const noexcept;
+  QList<Job>  createJobs(const SortedItems& items) const;
+  bool exportDrills(const FilePath& fp, const SortedItems& items) const;
+  bool exportDrillsNpth(const FilePath& fp, const SortedItems& items) const;
+  bool exportDrillsPth(const FilePath& fp, const SortedItems& items) const;
+  bool exportLayerBoardOutlines(const FilePath&    fp,
+                                const SortedItems& items) const;
+  bool exportLayerTopCopper(const FilePath& fp, const SortedItems& items) const;
+  bool exportLayerInnerCopper(const FilePath& fp, const SortedItems& items,
+                              int layer) const;
+  bool exportLayerBottomCopper(const FilePath&    fp,
+                               const SortedItems& items) const;
+  bool exportLayerTopSolderMask(const FilePath&    fp,
+                                const SortedItems& items) const;
+  bool exportLayerBottomSolderMask(const FilePath&    fp,
+                                   const SortedItems& items) const;
+  bool exportLayerTopSilkscreen(const FilePath&    fp,
+                                const SortedItems& items) const;
+  bool exportLayerBottomSilkscreen(const FilePath&    fp,
+                                   const SortedItems& items) const;
+  bool exportLayerTopSolderPaste(const FilePath&    fp,
+                                 const SortedItems& items) const;
+  bool exportLayerBottomSolderPaste(const FilePath&    fp,
+                                    const SortedItems& items) const;
+
+  int  drawNpthDrills(ExcellonGenerator& gen, const SortedItems& items) const;
+  int  drawPthDrills(ExcellonGenerator& gen, const SortedItems& items) const;
+  void drawLayer(GerberGenerator& gen, const SortedItems& items,
+                 const QString& layerName) const;
   void drawVia(GerberGenerator& gen, const BI_Via& via,
                const QString& layerName) const;
   void drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint,
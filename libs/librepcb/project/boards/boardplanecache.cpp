@@ -0,0 +1,454 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanecache.h"
+
+#include "board.h"
+#include "boardplanefragmentsbuilder.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_hole.h"
+#include "items/bi_netline.h"
+#include "items/bi_plane.h"
+#include "items/bi_polygon.h"
+#include "items/bi_via.h"
+
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/library/pkg/footprint.h>
+
+#include <QtCore>
+
+#include <limits>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPlaneCache::BoardPlaneCache(Board& board) noexcept
+  : mBoard(board), mAllPlanesDirty(true), mRevision(0) {
+}
+
+BoardPlaneCache::~BoardPlaneCache() noexcept {
+  Q_ASSERT(mItems.isEmpty());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+bool BoardPlaneCache::isPlaneDirty(const BI_Plane& plane) const noexcept {
+  if (mAllPlanesDirty || mDirtyPlanes.contains(&plane) ||
+      mInvalidItems.contains(&plane) || (!mItems.contains(&plane))) {
+    return true;
+  }
+  ClipperLib::IntRect planeBounds = getPlaneBounds(plane);
+  foreach (const DirtyArea& area, mDirtyAreas) {
+    bool onLayer = area.layerName.isEmpty() ||
+                   (area.layerName == *plane.getLayerName());
+    if (onLayer && intersects(area.bounds, planeBounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BoardPlaneCache::intersects(const BI_Base&  item,
+                                 const BI_Plane& plane) noexcept {
+  ClipperLib::IntRect itemBounds  = getValidItem(item).bounds;
+  ClipperLib::IntRect planeBounds = getPlaneBounds(plane);
+  return intersects(itemBounds, planeBounds);
+}
+
+const ClipperLib::Paths& BoardPlaneCache::getBoardArea(
+    const UnsignedLength& clearance) {
+  auto it = mBoardAreas.find(clearance->toNm());
+  if (it == mBoardAreas.end()) {
+    ClipperLib::Paths   boardArea;
+    ClipperLib::Clipper boardAreaClipper;
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+      if (isBoardOutline(*polygon)) {
+        ClipperLib::Path path = ClipperHelpers::convert(
+            polygon->getPolygon().getPath(),
+            BoardPlaneFragmentsBuilder::maxArcTolerance());
+        boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
+      }
+    }
+    boardAreaClipper.Execute(ClipperLib::ctXor, boardArea,
+                             ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+
+    // perform clearance offset
+    ClipperHelpers::offset(
+        boardArea, -clearance,
+        BoardPlaneFragmentsBuilder::maxArcTolerance());  // can throw
+    it = mBoardAreas.insert(clearance->toNm(), boardArea);
+  }
+  return *it;
+}
+
+const ClipperLib::Paths& BoardPlaneCache::getOutline(
+    const BI_Base& item) noexcept {
+  return getValidItem(item).outline;
+}
+
+const ClipperLib::Paths& BoardPlaneCache::getCutOut(
+    const BI_Base& item, const UnsignedLength& clearance) {
+  Item& entry = getValidItem(item);
+  auto  it    = entry.cutOuts.find(clearance->toNm());
+  if (it == entry.cutOuts.end()) {
+    it = entry.cutOuts.insert(clearance->toNm(),
+                              createCutOut(item, clearance));  // can throw
+  }
+  return *it;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardPlaneCache::insert(BI_Base& item) noexcept {
+  if ((!isCachedType(item)) || mItems.contains(&item)) {
+    return;
+  }
+  ++mRevision;
+  Item entry;
+  entry.valid = false;
+  mItems.insert(&item, entry);
+  mInvalidItems.insert(&item);  // update the item lazily
+  if (item.getType() == BI_Base::Type_t::Plane) {
+    mDirtyPlanes.insert(static_cast<BI_Plane*>(&item));
+  }
+}
+
+void BoardPlaneCache::remove(BI_Base& item) noexcept {
+  auto it = mItems.find(&item);
+  if (it == mItems.end()) {
+    return;
+  }
+  ++mRevision;
+  if (it->valid) {
+    markItemAreaAsDirty(item, *it);
+  }
+  mItems.erase(it);
+  mInvalidItems.remove(&item);
+  if (item.getType() == BI_Base::Type_t::Plane) {
+    mDirtyPlanes.remove(static_cast<BI_Plane*>(&item));
+  }
+}
+
+void BoardPlaneCache::invalidate(BI_Base& item) noexcept {
+  auto it = mItems.find(&item);
+  if (it == mItems.end()) {
+    return;
+  }
+  ++mRevision;
+  if (it->valid) {
+    markItemAreaAsDirty(item, *it);
+    it->valid = false;
+    it->outline.clear();
+    it->cutOuts.clear();
+    mInvalidItems.insert(&item);
+  }
+  if (item.getType() == BI_Base::Type_t::Plane) {
+    mDirtyPlanes.insert(static_cast<BI_Plane*>(&item));
+  }
+}
+
+void BoardPlaneCache::invalidateAllPlanes() noexcept {
+  // Drop the cached geometry as well, so the planes are rebuilt from scratch
+  // even if some modification was not reported with invalidate().
+  for (auto it = mItems.begin(); it != mItems.end(); ++it) {
+    if (it->valid) {
+      it->valid = false;
+      it->outline.clear();
+      it->cutOuts.clear();
+      mInvalidItems.insert(it.key());
+    }
+  }
+  mBoardAreas.clear();
+  ++mRevision;
+  mAllPlanesDirty = true;
+}
+
+void BoardPlaneCache::setPlaneDirty(const BI_Plane& plane) noexcept {
+  // Note: This does not increment the revision since the board geometry is
+  // not modified, the plane just needs to be rebuilt (again).
+  if (mItems.contains(&plane)) {
+    mDirtyPlanes.insert(&plane);
+  }
+}
+
+void BoardPlaneCache::updateItems() noexcept {
+  foreach (const BI_Base* item, mInvalidItems) {
+    auto it = mItems.find(item);
+    Q_ASSERT(it != mItems.end());
+    updateItem(*item, *it);
+    markItemAreaAsDirty(*item, *it);
+  }
+  mInvalidItems.clear();
+}
+
+void BoardPlaneCache::planeFragmentsChanged(const BI_Plane& plane) noexcept {
+  // Note: Planes with lower priority are not marked as dirty since they are
+  // rebuilt together with this plane (see BoardPlaneRebuildScheduler).
+  auto it = mItems.find(&plane);
+  if (it != mItems.end()) {
+    it->cutOuts.clear();
+  }
+}
+
+void BoardPlaneCache::clearDirtyState() noexcept {
+  mDirtyAreas.clear();
+  mDirtyPlanes.clear();
+  mAllPlanesDirty = false;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+BoardPlaneCache::Item& BoardPlaneCache::getValidItem(
+    const BI_Base& item) noexcept {
+  auto it = mItems.find(&item);
+  if (it == mItems.end()) {
+    // The item is not added to the board (e.g. while loading the board), so
+    // it can't be cached since we would not be notified about modifications.
+    updateItem(item, mUncachedItem);
+    return mUncachedItem;
+  }
+  if (!it->valid) {
+    updateItem(item, *it);
+    markItemAreaAsDirty(item, *it);
+    mInvalidItems.remove(&item);
+  }
+  return *it;
+}
+
+void BoardPlaneCache::updateItem(const BI_Base& item, Item& entry) noexcept {
+  PositiveLength tolerance = BoardPlaneFragmentsBuilder::maxArcTolerance();
+  entry.valid              = true;
+  entry.layerName.clear();
+  entry.outline.clear();
+  entry.cutOuts.clear();
+  switch (item.getType()) {
+    case BI_Base::Type_t::Footprint: {
+      const BI_Footprint& footprint = static_cast<const BI_Footprint&>(item);
+      for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+        Point pos  = footprint.mapToScene(hole.getPosition());
+        Path  path = Path::circle(hole.getDiameter()).translated(pos);
+        entry.outline.push_back(ClipperHelpers::convert(path, tolerance));
+      }
+      break;
+    }
+    case BI_Base::Type_t::FootprintPad: {
+      const BI_FootprintPad& pad = static_cast<const BI_FootprintPad&>(item);
+      if ((!pad.isOnLayer(GraphicsLayer::sTopCopper)) ||
+          (!pad.isOnLayer(GraphicsLayer::sBotCopper))) {
+        entry.layerName = pad.getLayerName();  // SMT pad
+      }
+      entry.outline.push_back(
+          ClipperHelpers::convert(pad.getSceneOutline(), tolerance));
+      break;
+    }
+    case BI_Base::Type_t::Via: {
+      const BI_Via& via = static_cast<const BI_Via&>(item);
+      entry.outline.push_back(
+          ClipperHelpers::convert(via.getSceneOutline(), tolerance));
+      break;
+    }
+    case BI_Base::Type_t::NetLine: {
+      const BI_NetLine& netline = static_cast<const BI_NetLine&>(item);
+      entry.layerName           = netline.getLayer().getName();
+      entry.outline.push_back(
+          ClipperHelpers::convert(netline.getSceneOutline(), tolerance));
+      break;
+    }
+    case BI_Base::Type_t::Hole: {
+      const Hole& hole = static_cast<const BI_Hole&>(item).getHole();
+      Path        path =
+          Path::circle(hole.getDiameter()).translated(hole.getPosition());
+      entry.outline.push_back(ClipperHelpers::convert(path, tolerance));
+      break;
+    }
+    case BI_Base::Type_t::Plane: {
+      const BI_Plane& plane = static_cast<const BI_Plane&>(item);
+      entry.layerName       = *plane.getLayerName();
+      entry.outline.push_back(
+          ClipperHelpers::convert(plane.getOutline(), tolerance));
+      break;
+    }
+    case BI_Base::Type_t::Polygon: {
+      // only the layer is relevant, see isBoardOutline()
+      const BI_Polygon& polygon = static_cast<const BI_Polygon&>(item);
+      entry.layerName           = *polygon.getPolygon().getLayerName();
+      break;
+    }
+    default:
+      break;
+  }
+  entry.bounds = getBounds(entry.outline);
+}
+
+void BoardPlaneCache::markItemAreaAsDirty(const BI_Base& item,
+                                          const Item&    entry) noexcept {
+  if (item.getType() == BI_Base::Type_t::Polygon) {
+    if (entry.layerName == GraphicsLayer::sBoardOutlines) {
+      // the board area has changed, thus all planes are affected
+      mBoardAreas.clear();
+      mAllPlanesDirty = true;
+    }
+  } else if (!entry.outline.empty()) {
+    mDirtyAreas.append(DirtyArea{entry.layerName, entry.bounds});
+  }
+}
+
+ClipperLib::Paths BoardPlaneCache::createCutOut(
+    const BI_Base& item, const UnsignedLength& clearance) const {
+  PositiveLength    tolerance = BoardPlaneFragmentsBuilder::maxArcTolerance();
+  ClipperLib::Paths paths;
+  switch (item.getType()) {
+    case BI_Base::Type_t::Footprint: {
+      const BI_Footprint& footprint = static_cast<const BI_Footprint&>(item);
+      for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+        Point          pos = footprint.mapToScene(hole.getPosition());
+        PositiveLength dia(hole.getDiameter() + clearance * 2);
+        Path           path = Path::circle(dia).translated(pos);
+        paths.push_back(ClipperHelpers::convert(path, tolerance));
+      }
+      break;
+    }
+    case BI_Base::Type_t::FootprintPad: {
+      const BI_FootprintPad& pad = static_cast<const BI_FootprintPad&>(item);
+      paths.push_back(
+          ClipperHelpers::convert(pad.getSceneOutline(*clearance), tolerance));
+      break;
+    }
+    case BI_Base::Type_t::Via: {
+      const BI_Via& via = static_cast<const BI_Via&>(item);
+      paths.push_back(
+          ClipperHelpers::convert(via.getSceneOutline(*clearance), tolerance));
+      break;
+    }
+    case BI_Base::Type_t::NetLine: {
+      const BI_NetLine& netline = static_cast<const BI_NetLine&>(item);
+      paths.push_back(ClipperHelpers::convert(
+          netline.getSceneOutline(*clearance), tolerance));
+      break;
+    }
+    case BI_Base::Type_t::Hole: {
+      const Hole&    hole = static_cast<const BI_Hole&>(item).getHole();
+      PositiveLength dia(hole.getDiameter() + clearance * 2);
+      Path           path = Path::circle(dia).translated(hole.getPosition());
+      paths.push_back(ClipperHelpers::convert(path, tolerance));
+      break;
+    }
+    case BI_Base::Type_t::Plane: {
+      const BI_Plane& plane = static_cast<const BI_Plane&>(item);
+      paths = ClipperHelpers::convert(plane.getFragments(), tolerance);
+      ClipperHelpers::offset(paths, *clearance, tolerance);  // can throw
+      break;
+    }
+    default:
+      break;
+  }
+  return paths;
+}
+
+ClipperLib::IntRect BoardPlaneCache::getPlaneBounds(const BI_Plane& plane) const
+    noexcept {
+  auto it = mItems.constFind(&plane);
+  if ((it == mItems.constEnd()) || (!it->valid)) {
+    // unknown bounds, thus assume the plane covers everything
+    ClipperLib::cInt max = std::numeric_limits<ClipperLib::cInt>::max() / 2;
+    return ClipperLib::IntRect{-max, -max, max, max};
+  }
+  // objects within the clearance also affect the plane
+  ClipperLib::cInt    clearance = plane.getMinClearance()->toNm();
+  ClipperLib::IntRect bounds    = it->bounds;
+  bounds.left -= clearance;
+  bounds.top -= clearance;
+  bounds.right += clearance;
+  bounds.bottom += clearance;
+  return bounds;
+}
+
+bool BoardPlaneCache::isCachedType(const BI_Base& item) noexcept {
+  switch (item.getType()) {
+    case BI_Base::Type_t::Footprint:
+    case BI_Base::Type_t::FootprintPad:
+    case BI_Base::Type_t::Via:
+    case BI_Base::Type_t::NetLine:
+    case BI_Base::Type_t::Hole:
+    case BI_Base::Type_t::Plane:
+    case BI_Base::Type_t::Polygon:
+      return true;
+    default:
+      // these items do not affect planes
+      return false;
+  }
+}
+
+bool BoardPlaneCache::isBoardOutline(const BI_Base& item) noexcept {
+  return (item.getType() == BI_Base::Type_t::Polygon) &&
+         (static_cast<const BI_Polygon&>(item).getPolygon().getLayerName() ==
+          GraphicsLayer::sBoardOutlines);
+}
+
+ClipperLib::IntRect BoardPlaneCache::getBounds(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect bounds{0, 0, -1, -1};  // empty
+  bool                first = true;
+  for (const ClipperLib::Path& path : paths) {
+    for (const ClipperLib::IntPoint& p : path) {
+      if (first) {
+        bounds = ClipperLib::IntRect{p.X, p.Y, p.X, p.Y};
+        first  = false;
+      } else {
+        bounds.left   = qMin(bounds.left, p.X);
+        bounds.top    = qMin(bounds.top, p.Y);
+        bounds.right  = qMax(bounds.right, p.X);
+        bounds.bottom = qMax(bounds.bottom, p.Y);
+      }
+    }
+  }
+  return bounds;
+}
+
+bool BoardPlaneCache::intersects(const ClipperLib::IntRect& a,
+                                 const ClipperLib::IntRect& b) noexcept {
+  // note: contrary to QRect::intersects(), touching rects do intersect
+  return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+         (b.top <= a.bottom);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,157 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANECACHE_H
+#define LIBREPCB_PROJECT_BOARDPLANECACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <clipper/clipper.hpp>
+#include <librepcb/common/units/all_length_units.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Base;
+class BI_Plane;
+
+/*******************************************************************************
+ *  Class BoardPlaneCache
+ ******************************************************************************/
+
+/**
+ * @brief Cache of the copper geometry needed to build the fragments of planes
+ *
+ * Converting all pads, vias, netlines and holes of a board into Clipper paths
+ * is the most expensive part of librepcb::project::BoardPlaneFragmentsBuilder,
+ * so this class keeps the converted outlines and cut-outs (per clearance) of
+ * every relevant board item until the item is modified. The clipped board
+ * outline area is cached as well.
+ *
+ * In addition, the cache keeps track of which areas on which layers were
+ * modified since the last plane rebuild. This allows
+ * librepcb::project::Board::rebuildDirtyPlanes() to rebuild only the planes
+ * which are actually affected by a modification.
+ *
+ * Board items notify the cache about modifications through
+ * librepcb::project::BI_Base::invalidateGeometry().
+ *
+ * @note References returned by the getters are only valid until the next
+ *       call to any method of this class.
+ */
+class BoardPlaneCache final {
+public:
+  // Constructors / Destructor
+  BoardPlaneCache()                             = delete;
+  BoardPlaneCache(const BoardPlaneCache& other) = delete;
+  explicit BoardPlaneCache(Board& board) noexcept;
+  ~BoardPlaneCache() noexcept;
+
+  // Getters
+  quint64 getRevision() const noexcept { return mRevision; }
+  bool    isPlaneDirty(const BI_Plane& plane) const noexcept;
+  bool    intersects(const BI_Base& item, const BI_Plane& plane) noexcept;
+  const ClipperLib::Paths& getBoardArea(const UnsignedLength& clearance);
+  const ClipperLib::Paths& getOutline(const BI_Base& item) noexcept;
+  const ClipperLib::Paths& getCutOut(const BI_Base& item,
+                                     const UnsignedLength& clearance);
+
+  // General Methods
+  void insert(BI_Base& item) noexcept;
+  void remove(BI_Base& item) noexcept;
+  void invalidate(BI_Base& item) noexcept;
+  void invalidateAllPlanes() noexcept;
+  void setPlaneDirty(const BI_Plane& plane) noexcept;
+  void updateItems() noexcept;
+  void planeFragmentsChanged(const BI_Plane& plane) noexcept;
+  void clearDirtyState() noexcept;
+
+  // Operator Overloadings
+  BoardPlaneCache& operator=(const BoardPlaneCache& rhs) = delete;
+
+private:  // Types
+  struct Item {
+    bool    valid;      ///< Whether the other members are up to date
+    QString layerName;  ///< Empty if the item is on all copper layers
+    ClipperLib::IntRect bounds;   ///< Bounds of #outline
+    ClipperLib::Paths   outline;  ///< Copper area without clearance
+    QHash<qint64, ClipperLib::Paths> cutOuts;  ///< Key: Clearance in nm
+  };
+
+  struct DirtyArea {
+    QString             layerName;  ///< Empty if on all copper layers
+    ClipperLib::IntRect bounds;
+  };
+
+private:  // Methods
+  Item& getValidItem(const BI_Base& item) noexcept;
+  void  updateItem(const BI_Base& item, Item& entry) noexcept;
+  void  markItemAreaAsDirty(const BI_Base& item, const Item& entry) noexcept;
+  ClipperLib::Paths createCutOut(const BI_Base& item,
+                                 const UnsignedLength& clearance) const;
+  ClipperLib::IntRect getPlaneBounds(const BI_Plane& plane) const noexcept;
+  static bool isCachedType(const BI_Base& item) noexcept;
+  static bool isBoardOutline(const BI_Base& item) noexcept;
+  static ClipperLib::IntRect getBounds(const ClipperLib::Paths& paths) noexcept;
+  static bool intersects(const ClipperLib::IntRect& a,
+                         const ClipperLib::IntRect& b) noexcept;
+
+private:  // Data
+  Board& mBoard;
+
+  /// All cached items (only those which are relevant for planes)
+  QHash<const BI_Base*, Item> mItems;
+
+  /// Temporary entry for items which are not added to the board
+  Item mUncachedItem;
+
+  /// Items which were inserted or modified since they were last updated
+  QSet<const BI_Base*> mInvalidItems;
+
+  /// The board area clipped by the board outlines, key: clearance in nm
+  QHash<qint64, ClipperLib::Paths> mBoardAreas;
+
+  /// Areas which were modified since the last plane rebuild
+  QVector<DirtyArea> mDirtyAreas;
+
+  /// Planes which were modified themselves since the last plane rebuild
+  QSet<const BI_Plane*> mDirtyPlanes;
+
+  /// Whether all planes need to be rebuilt (e.g. board outline modified)
+  bool mAllPlanesDirty;
+
+  /// Incremented on every modification of the board geometry
+  quint64 mRevision;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDPLANECACHE_H
@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "boardplanefragmentsbuilder.h"
 
+#include "board.h"
+#include "boardplanecache.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
 #include "items/bi_footprintpad.h"
@@ -30,10 +32,8 @@
 #include "items/bi_netpoint.h"
 #include "items/bi_netsegment.h"
 #include "items/bi_plane.h"
-#include "items/bi_polygon.h"
 #include "items/bi_via.h"
 
-#include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
@@ -50,156 +50,220 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept
-  : mPlane(plane) {
+BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(
+    BI_Plane&                                       plane,
+    const QList<const BoardPlaneFragmentsBuilder*>& rebuiltPlanes) noexcept
+  : mPlane(plane),
+    mCache(plane.getBoard().getPlaneCache()),
+    mMinWidth(plane.getMinWidth()),
+    mMinClearance(plane.getMinClearance()),
+    mKeepOrphans(plane.getKeepOrphans()),
+    mFragments(plane.getFragments()) {
+  try {
+    collectInputData(rebuiltPlanes);  // can throw
+  } catch (const Exception& e) {
+    mInputError = e.getMsg();
+  }
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QList<const BoardPlaneFragmentsBuilder*>
+    BoardPlaneFragmentsBuilder::getDependencies() const noexcept {
+  QList<const BoardPlaneFragmentsBuilder*> dependencies;
+  foreach (const OtherPlane& otherPlane, mOtherPlanes) {
+    if (otherPlane.builder) {
+      dependencies.append(otherPlane.builder);
+    }
+  }
+  return dependencies;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
-QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
+const QVector<Path>& BoardPlaneFragmentsBuilder::buildFragments() noexcept {
   try {
+    if (!mInputError.isNull()) {
+      throw RuntimeError(__FILE__, __LINE__, mInputError);
+    }
     mResult.clear();
     addPlaneOutline();
     clipToBoardOutline();
     subtractOtherObjects();
     ensureMinimumWidth();
     flattenResult();
-    if (!mPlane.getKeepOrphans()) {
+    if (!mKeepOrphans) {
       removeOrphans();
     }
-    return ClipperHelpers::convert(mResult);
+    mFragments = ClipperHelpers::convert(mResult);
   } catch (const Exception& e) {
     qCritical() << "Failed to build plane fragments! Leave plane empty...";
     qCritical() << "Inner error message:" << e.getMsg();
-    return QVector<Path>();
+    mFragments.clear();
   }
+  return mFragments;
 }
 
 /*******************************************************************************
- *  Private Methods
+ *  Static Methods
  ******************************************************************************/
 
-void BoardPlaneFragmentsBuilder::addPlaneOutline() {
-  mResult.push_back(
-      ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance()));
-}
-
-void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
-  // determine board area
-  ClipperLib::Paths   boardArea;
-  ClipperLib::Clipper boardAreaClipper;
-  foreach (const BI_Polygon* polygon, mPlane.getBoard().getPolygons()) {
-    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
-      ClipperLib::Path path = ClipperHelpers::convert(
-          polygon->getPolygon().getPath(), maxArcTolerance());
-      boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
-    }
-  }
-  boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
-                           ClipperLib::pftEvenOdd);
-
-  // perform clearance offset
-  ClipperHelpers::offset(boardArea, -mPlane.getMinClearance(),
-                         maxArcTolerance());  // can throw
-
-  // if we have no board area, abort here
-  if (boardArea.empty()) return;
-
-  // clip result to board area
-  ClipperLib::Clipper clip;
-  clip.AddPaths(mResult, ClipperLib::ptSubject, true);
-  clip.AddPaths(boardArea, ClipperLib::ptClip, true);
-  clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
-               ClipperLib::pftNonZero);
+bool BoardPlaneFragmentsBuilder::dependsOn(const BI_Plane& plane,
+                                           const BI_Plane& other,
+                                           BoardPlaneCache& cache) noexcept {
+  if (&other == &plane) return false;
+  if (other < plane) return false;  // ignore planes with lower priority
+  if (other.getLayerName() != plane.getLayerName()) return false;
+  if (&other.getNetSignal() == &plane.getNetSignal()) return false;
+  return cache.intersects(other, plane);
 }
 
-void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
-  ClipperLib::Clipper c;
-  c.AddPaths(mResult, ClipperLib::ptSubject, true);
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
 
-  // subtract other planes
+void BoardPlaneFragmentsBuilder::collectInputData(
+    const QList<const BoardPlaneFragmentsBuilder*>& rebuiltPlanes) {
+  // Note: Items which are not within the plane's area (incl. clearance) are
+  // skipped to avoid passing lots of irrelevant paths to Clipper.
+  mOutline   = ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance());
+  mBoardArea = mCache.getBoardArea(mMinClearance);  // can throw
+
+  // other planes
+  QHash<const BI_Plane*, const BoardPlaneFragmentsBuilder*> builders;
+  foreach (const BoardPlaneFragmentsBuilder* builder, rebuiltPlanes) {
+    builders.insert(&builder->getPlane(), builder);
+  }
   foreach (const BI_Plane* plane, mPlane.getBoard().getPlanes()) {
-    if (plane == &mPlane) continue;
-    if (*plane < mPlane) continue;  // ignore planes with lower priority
-    if (plane->getLayerName() != mPlane.getLayerName()) continue;
-    if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
-    ClipperLib::Paths paths =
-        ClipperHelpers::convert(plane->getFragments(), maxArcTolerance());
-    ClipperHelpers::offset(paths, *mPlane.getMinClearance(),
-                           maxArcTolerance());  // can throw
-    c.AddPaths(paths, ClipperLib::ptClip, true);
+    if (!dependsOn(mPlane, *plane, mCache)) continue;
+    OtherPlane otherPlane;
+    otherPlane.builder = builders.value(plane, nullptr);
+    if (!otherPlane.builder) {
+      otherPlane.cutOut = mCache.getCutOut(*plane, mMinClearance);  // can throw
+    }
+    mOtherPlanes.append(otherPlane);
   }
 
-  // subtract holes and pads from devices
+  // holes and pads from devices
   foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-    for (const Hole& hole :
-         device->getFootprint().getLibFootprint().getHoles()) {
-      Point pos = device->getFootprint().mapToScene(hole.getPosition());
-      PositiveLength dia(hole.getDiameter() + mPlane.getMinClearance() * 2);
-      Path           path = Path::circle(dia).translated(pos);
-      c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-                ClipperLib::ptClip, true);
+    const BI_Footprint& footprint = device->getFootprint();
+    if (mCache.intersects(footprint, mPlane)) {
+      const ClipperLib::Paths& paths =
+          mCache.getCutOut(footprint, mMinClearance);  // can throw
+      mCutOuts.insert(mCutOuts.end(), paths.begin(), paths.end());
     }
-    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
       if (!pad->isOnLayer(*mPlane.getLayerName())) continue;
+      if (!mCache.intersects(*pad, mPlane)) continue;
       if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(pad->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+        const ClipperLib::Paths& paths = mCache.getOutline(*pad);
+        mConnectedNetSignalAreas.insert(mConnectedNetSignalAreas.end(),
+                                        paths.begin(), paths.end());
+      }
+      if (isPadCutOutNeeded(*pad)) {
+        const ClipperLib::Paths& paths =
+            mCache.getCutOut(*pad, mMinClearance);  // can throw
+        mCutOuts.insert(mCutOuts.end(), paths.begin(), paths.end());
       }
-      c.AddPath(createPadCutOut(*pad), ClipperLib::ptClip, true);
     }
   }
 
-  // subtract board holes
+  // board holes
   for (const BI_Hole* hole : mPlane.getBoard().getHoles()) {
-    PositiveLength dia(hole->getHole().getDiameter() +
-                       mPlane.getMinClearance() * 2);
-    Path path = Path::circle(dia).translated(hole->getHole().getPosition());
-    c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-              ClipperLib::ptClip, true);
+    if (!mCache.intersects(*hole, mPlane)) continue;
+    const ClipperLib::Paths& paths =
+        mCache.getCutOut(*hole, mMinClearance);  // can throw
+    mCutOuts.insert(mCutOuts.end(), paths.begin(), paths.end());
   }
 
-  // subtract net segment items
+  // net segment items
   foreach (const BI_NetSegment* netsegment,
            mPlane.getBoard().getNetSegments()) {
-    // subtract vias
+    bool sameNetSignal =
+        (&netsegment->getNetSignal() == &mPlane.getNetSignal());
+
+    // vias
     foreach (const BI_Via* via, netsegment->getVias()) {
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(via->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+      if (!mCache.intersects(*via, mPlane)) continue;
+      if (sameNetSignal) {
+        const ClipperLib::Paths& paths = mCache.getOutline(*via);
+        mConnectedNetSignalAreas.insert(mConnectedNetSignalAreas.end(),
+                                        paths.begin(), paths.end());
+      }
+      if (isViaCutOutNeeded(*via)) {
+        const ClipperLib::Paths& paths =
+            mCache.getCutOut(*via, mMinClearance);  // can throw
+        mCutOuts.insert(mCutOuts.end(), paths.begin(), paths.end());
       }
-      c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
     }
 
-    // subtract netlines
+    // netlines
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       if (netline->getLayer().getName() != mPlane.getLayerName()) continue;
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+      if (!mCache.intersects(*netline, mPlane)) continue;
+      if (sameNetSignal) {
+        const ClipperLib::Paths& paths = mCache.getOutline(*netline);
+        mConnectedNetSignalAreas.insert(mConnectedNetSignalAreas.end(),
+                                        paths.begin(), paths.end());
       } else {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(*mPlane.getMinClearance()),
-            maxArcTolerance());
-        c.AddPath(path, ClipperLib::ptClip, true);
+        const ClipperLib::Paths& paths =
+            mCache.getCutOut(*netline, mMinClearance);  // can throw
+        mCutOuts.insert(mCutOuts.end(), paths.begin(), paths.end());
       }
     }
   }
+}
+
+void BoardPlaneFragmentsBuilder::addPlaneOutline() {
+  mResult.push_back(mOutline);
+}
+
+void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
+  // if we have no board area, abort here
+  if (mBoardArea.empty()) return;
+
+  // clip result to board area
+  ClipperLib::Clipper clip;
+  clip.AddPaths(mResult, ClipperLib::ptSubject, true);
+  clip.AddPaths(mBoardArea, ClipperLib::ptClip, true);
+  clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
+               ClipperLib::pftNonZero);
+}
+
+void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
+  ClipperLib::Clipper c;
+  c.AddPaths(mResult, ClipperLib::ptSubject, true);
+
+  // subtract other planes
+  foreach (const OtherPlane& otherPlane, mOtherPlanes) {
+    if (otherPlane.builder) {
+      // the plane was rebuilt at the same time, use its new fragments
+      ClipperLib::Paths paths = ClipperHelpers::convert(
+          otherPlane.builder->getFragments(), maxArcTolerance());
+      ClipperHelpers::offset(paths, *mMinClearance,
+                             maxArcTolerance());  // can throw
+      c.AddPaths(paths, ClipperLib::ptClip, true);
+    } else {
+      c.AddPaths(otherPlane.cutOut, ClipperLib::ptClip, true);
+    }
+  }
+
+  // subtract all other objects
+  c.AddPaths(mCutOuts, ClipperLib::ptClip, true);
 
   c.Execute(ClipperLib::ctDifference, mResult, ClipperLib::pftEvenOdd,
             ClipperLib::pftNonZero);
 }
 
 void BoardPlaneFragmentsBuilder::ensureMinimumWidth() {
-  Length delta = mPlane.getMinWidth() / 2;
+  Length delta = mMinWidth / 2;
   ClipperHelpers::offset(mResult, -delta, maxArcTolerance());  // can throw
   ClipperHelpers::offset(mResult, delta, maxArcTolerance());   // can throw
 }
@@ -236,30 +300,20 @@ void BoardPlaneFragmentsBuilder::removeOrphans() {
  *  Helper Methods
  ******************************************************************************/
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(
+bool BoardPlaneFragmentsBuilder::isPadCutOutNeeded(
     const BI_FootprintPad& pad) const noexcept {
   bool differentNetSignal =
       (pad.getCompSigInstNetSignal() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        pad.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
-  } else {
-    return ClipperLib::Path();
-  }
+  return (mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
+         differentNetSignal;
 }
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(
-    const BI_Via& via) const noexcept {
+bool BoardPlaneFragmentsBuilder::isViaCutOutNeeded(const BI_Via& via) const
+    noexcept {
   bool differentNetSignal =
       (&via.getNetSignalOfNetSegment() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        via.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
-  } else {
-    return ClipperLib::Path();
-  }
+  return (mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
+         differentNetSignal;
 }
 
 /*******************************************************************************
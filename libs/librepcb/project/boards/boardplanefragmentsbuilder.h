@@ -34,6 +34,7 @@
 namespace librepcb {
 namespace project {
 
+class BoardPlaneCache;
 class BI_Plane;
 class BI_Via;
 class BI_FootprintPad;
@@ -44,23 +45,67 @@ class BI_FootprintPad;
 
 /**
  * @brief The BoardPlaneFragmentsBuilder class
+ *
+ * The constructor takes a snapshot of all input data needed to build the
+ * fragments of a plane. The Clipper paths of all other board items are taken
+ * from the librepcb::project::BoardPlaneCache of the board, so only the items
+ * which were modified since the last plane rebuild need to be converted again.
+ *
+ * Since #buildFragments() does not access the board anymore, it can be called
+ * from a worker thread (see librepcb::project::BoardPlaneRebuildScheduler).
+ * The only exception are planes with a higher priority which are rebuilt at
+ * the same time: Their new fragments are read from their builders (see
+ * #getDependencies()), so #buildFragments() must not be called before all
+ * dependencies are finished.
  */
 class BoardPlaneFragmentsBuilder final {
 public:
   // Constructors / Destructor
   BoardPlaneFragmentsBuilder()                                        = delete;
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
-  BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept;
+  BoardPlaneFragmentsBuilder(
+      BI_Plane&                                       plane,
+      const QList<const BoardPlaneFragmentsBuilder*>& rebuiltPlanes =
+          QList<const BoardPlaneFragmentsBuilder*>()) noexcept;
   ~BoardPlaneFragmentsBuilder() noexcept;
 
+  // Getters
+  BI_Plane& getPlane() const noexcept { return mPlane; }
+  QList<const BoardPlaneFragmentsBuilder*> getDependencies() const noexcept;
+  const QVector<Path>& getFragments() const noexcept { return mFragments; }
+
   // General Methods
-  QVector<Path> buildFragments() noexcept;
+  const QVector<Path>& buildFragments() noexcept;
+
+  // Static Methods
+  static bool dependsOn(const BI_Plane& plane, const BI_Plane& other,
+                        BoardPlaneCache& cache) noexcept;
+
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs. Do not
+   * change this if you don't know exactly what you're doing (it affects all
+   * planes in all existing boards)!
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
 
   // Operator Overloadings
   BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) =
       delete;
 
+private:  // Types
+  /// A plane with higher priority to subtract
+  struct OtherPlane {
+    /// The builder if the plane is rebuilt too, otherwise nullptr
+    const BoardPlaneFragmentsBuilder* builder;
+    /// The cut-out of the plane if it is not rebuilt
+    ClipperLib::Paths cutOut;
+  };
+
 private:  // Methods
+  void collectInputData(
+      const QList<const BoardPlaneFragmentsBuilder*>& rebuiltPlanes);
   void addPlaneOutline();
   void clipToBoardOutline();
   void subtractOtherObjects();
@@ -69,22 +114,27 @@ private:  // Methods
   void removeOrphans();
 
   // Helper Methods
-  ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad) const noexcept;
-  ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
-
-  /**
-   * Returns the maximum allowed arc tolerance when flattening arcs. Do not
-   * change this if you don't know exactly what you're doing (it affects all
-   * planes in all existing boards)!
-   */
-  static PositiveLength maxArcTolerance() noexcept {
-    return PositiveLength(5000);
-  }
+  bool isPadCutOutNeeded(const BI_FootprintPad& pad) const noexcept;
+  bool isViaCutOutNeeded(const BI_Via& via) const noexcept;
 
 private:  // Data
-  BI_Plane&         mPlane;
-  ClipperLib::Paths mConnectedNetSignalAreas;
+  BI_Plane&        mPlane;
+  BoardPlaneCache& mCache;
+
+  // Input data (snapshot of the board)
+  QString             mInputError;  ///< Error while collecting input data
+  ClipperLib::Path    mOutline;
+  UnsignedLength      mMinWidth;
+  UnsignedLength      mMinClearance;
+  bool                mKeepOrphans;
+  ClipperLib::Paths   mBoardArea;
+  QVector<OtherPlane> mOtherPlanes;
+  ClipperLib::Paths   mCutOuts;
+  ClipperLib::Paths   mConnectedNetSignalAreas;
+
+  // Output data (initialized with the current fragments of the plane)
   ClipperLib::Paths mResult;
+  QVector<Path>     mFragments;
 };
 
 /*******************************************************************************
@@ -0,0 +1,327 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanerebuildscheduler.h"
+
+#include "board.h"
+#include "boardplanecache.h"
+#include "boardplanefragmentsbuilder.h"
+#include "items/bi_plane.h"
+
+#include <librepcb/common/profiler.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPlaneRebuildScheduler::BoardPlaneRebuildScheduler(Board& board) noexcept
+  : QObject(nullptr), mBoard(board), mPlanesOutdated(false) {
+}
+
+BoardPlaneRebuildScheduler::~BoardPlaneRebuildScheduler() noexcept {
+  // wait for running jobs, but do not apply their results anymore
+  if (mCurrentRun) {
+    mCurrentRun->aborted.store(1);
+    mCancelledRuns.append(mCurrentRun.take());
+  }
+  QMutexLocker lock(&mMutex);
+  foreach (Run* run, mCancelledRuns) {
+    while (run->pendingJobs > 0) {
+      mWaitCondition.wait(&mMutex);
+    }
+  }
+  qDeleteAll(mCancelledRuns);
+  mCancelledRuns.clear();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardPlaneRebuildScheduler::start() noexcept {
+  BoardPlaneCache& cache = mBoard.getPlaneCache();
+  if (mCurrentRun) {
+    if (mCurrentRun->cacheRevision == cache.getRevision()) {
+      return;  // board not modified since the running rebuild was started
+    }
+    cancel();  // results of the running rebuild would be outdated anyway
+  }
+
+  cache.updateItems();
+  QList<BI_Plane*> planes = mBoard.getPlanes();
+  qSort(planes.begin(), planes.end(),
+        [](const BI_Plane* p1, const BI_Plane* p2) {
+          return !(*p1 < *p2);
+        });  // sort by priority (highest priority first)
+
+  // create jobs (and their input data) in the main thread
+  QScopedPointer<Run> run(new Run());
+  run->pendingJobs = 0;
+  run->aborted.store(0);
+  run->cacheRevision = cache.getRevision();
+  QList<const BoardPlaneFragmentsBuilder*>       builders;
+  QHash<const BoardPlaneFragmentsBuilder*, Job*> jobs;
+  foreach (BI_Plane* plane, planes) {
+    bool dirty           = cache.isPlaneDirty(*plane);
+    bool dependencyDirty = false;
+    foreach (const BoardPlaneFragmentsBuilder* builder, builders) {
+      if (BoardPlaneFragmentsBuilder::dependsOn(*plane, builder->getPlane(),
+                                                cache)) {
+        dependencyDirty = true;
+        break;
+      }
+    }
+    if (dirty || dependencyDirty) {
+      Job* job   = new Job();
+      job->run   = run.data();
+      job->plane = plane;
+      job->builder.reset(new BoardPlaneFragmentsBuilder(*plane, builders));
+      job->oldFragments             = plane->getFragments();
+      job->onlyDependenciesModified = !dirty;
+      job->changed                  = false;
+      if (Profiler::instance().isEnabled()) {
+        job->label = plane->getUuid().toStr();
+      }
+      foreach (const BoardPlaneFragmentsBuilder* dependency,
+               job->builder->getDependencies()) {
+        Job* dependencyJob = jobs.value(dependency);
+        Q_ASSERT(dependencyJob);
+        job->dependencies.append(dependencyJob);
+        dependencyJob->dependents.append(job);
+      }
+      job->pendingDependencies.store(job->dependencies.count());
+      builders.append(job->builder.data());
+      jobs.insert(job->builder.data(), job);
+      run->jobs.append(job);
+    }
+  }
+  cache.clearDirtyState();
+
+  // start all jobs without dependencies, the others are started as soon as
+  // their dependencies are finished
+  if (!run->jobs.isEmpty()) {
+    qDebug() << "Rebuild" << run->jobs.count() << "of" << planes.count()
+             << "planes...";
+    {
+      QMutexLocker lock(&mMutex);
+      run->pendingJobs = run->jobs.count();
+    }
+    mCurrentRun.reset(run.take());
+    foreach (Job* job, mCurrentRun->jobs) {
+      if (job->dependencies.isEmpty()) {
+        this->run(job);
+      }
+    }
+    setPlanesOutdated(true);
+  } else {
+    setPlanesOutdated(false);
+  }
+}
+
+void BoardPlaneRebuildScheduler::cancel() noexcept {
+  if (!mCurrentRun) {
+    return;
+  }
+
+  // skip all jobs which are not started yet
+  mCurrentRun->aborted.store(1);
+
+  // the dirty state was cleared when starting the rebuild, so mark the planes
+  // as dirty again to get them rebuilt by the next run (except removed planes
+  // since they may be deleted at any time)
+  BoardPlaneCache& cache = mBoard.getPlaneCache();
+  foreach (const Job* job, mCurrentRun->jobs) {
+    if ((!job->onlyDependenciesModified) &&
+        mBoard.getPlanes().contains(job->plane)) {
+      cache.setPlaneDirty(*job->plane);
+    }
+  }
+
+  // keep the run until all of its running jobs are finished
+  bool finished;
+  {
+    QMutexLocker lock(&mMutex);
+    finished = (mCurrentRun->pendingJobs == 0);
+  }
+  if (finished) {
+    mCurrentRun.reset();
+  } else {
+    mCancelledRuns.append(mCurrentRun.take());
+  }
+  qDebug() << "Cancelled plane rebuild.";
+}
+
+void BoardPlaneRebuildScheduler::waitForFinished() noexcept {
+  if (!mCurrentRun) {
+    return;
+  }
+  {
+    QMutexLocker lock(&mMutex);
+    while (mCurrentRun->pendingJobs > 0) {
+      mWaitCondition.wait(&mMutex);
+    }
+  }
+  applyResults();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardPlaneRebuildScheduler::run(Job* job) noexcept {
+  QtConcurrent::run([this, job]() { execute(job); });
+}
+
+void BoardPlaneRebuildScheduler::execute(Job* job) noexcept {
+  // Note: This method is called in a worker thread!
+  Run* run = job->run;
+  if (!run->aborted.load()) {
+    bool needsRebuild = !job->onlyDependenciesModified;
+    foreach (const Job* dependency, job->dependencies) {
+      if (dependency->changed) {
+        needsRebuild = true;
+      }
+    }
+    if (needsRebuild) {
+      ProfilerScope profilerScope("board", "Build plane fragments", job->label);
+      job->changed = (job->builder->buildFragments() != job->oldFragments);
+    }
+  }
+
+  // start all dependents which have no more pending dependencies (even if
+  // aborted, to get the pending jobs counter down to zero)
+  foreach (Job* dependent, job->dependents) {
+    if (!dependent->pendingDependencies.deref()) {
+      this->run(dependent);
+    }
+  }
+
+  // Note: Do not access any members after releasing the mutex since the
+  // scheduler may be destroyed immediately after the last job has finished.
+  QMutexLocker lock(&mMutex);
+  if (--run->pendingJobs == 0) {
+    // all jobs are finished, apply results in the main thread
+    QMetaObject::invokeMethod(this, "runFinished", Qt::QueuedConnection);
+    mWaitCondition.wakeAll();
+  }
+}
+
+void BoardPlaneRebuildScheduler::runFinished() noexcept {
+  // release cancelled runs which are finished now
+  QList<Run*> finishedRuns;
+  bool        currentRunFinished = false;
+  {
+    QMutexLocker lock(&mMutex);
+    foreach (Run* run, mCancelledRuns) {
+      if (run->pendingJobs == 0) {
+        finishedRuns.append(run);
+        mCancelledRuns.removeOne(run);
+      }
+    }
+    // If waitForFinished() was called in the meantime, the results are
+    // already applied.
+    currentRunFinished = mCurrentRun && (mCurrentRun->pendingJobs == 0);
+  }
+  qDeleteAll(finishedRuns);
+  if (currentRunFinished) {
+    applyResults();
+  }
+}
+
+void BoardPlaneRebuildScheduler::applyResults() noexcept {
+  QScopedPointer<Run> run(mCurrentRun.take());
+  if (!run) {
+    return;
+  }
+
+  // If the board was modified while the rebuild was running, some results
+  // may be outdated. These are dropped and the planes are kept dirty to get
+  // them rebuilt by the next run.
+  BoardPlaneCache& cache = mBoard.getPlaneCache();
+  bool             stale = (cache.getRevision() != run->cacheRevision);
+  if (stale) {
+    cache.updateItems();
+  }
+  QSet<const Job*> droppedJobs;
+  int              changedPlanes = 0;
+  foreach (const Job* job, run->jobs) {  // highest priority first
+    if (stale) {
+      bool drop = (!mBoard.getPlanes().contains(job->plane)) ||
+                  cache.isPlaneDirty(*job->plane);
+      foreach (const Job* dependency, job->dependencies) {
+        if (droppedJobs.contains(dependency)) {
+          drop = true;
+        }
+      }
+      if (drop) {
+        if (mBoard.getPlanes().contains(job->plane)) {
+          cache.setPlaneDirty(*job->plane);
+        }
+        droppedJobs.insert(job);
+        continue;
+      }
+    }
+    if (job->changed) {
+      job->plane->setFragments(job->builder->getFragments());
+      ++changedPlanes;
+    }
+  }
+  Profiler::instance().addCounter("board", "Changed planes", changedPlanes);
+
+  bool outdated = !droppedJobs.isEmpty();
+  if (outdated) {
+    qDebug() << "Dropped" << droppedJobs.count()
+             << "outdated plane rebuild results.";
+  } else if (stale) {
+    foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+      if (cache.isPlaneDirty(*plane)) {
+        outdated = true;
+        break;
+      }
+    }
+  }
+  setPlanesOutdated(outdated);
+  emit finished();
+}
+
+void BoardPlaneRebuildScheduler::setPlanesOutdated(bool outdated) noexcept {
+  if (outdated != mPlanesOutdated) {
+    mPlanesOutdated = outdated;
+    emit planesOutdatedChanged(mPlanesOutdated);
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
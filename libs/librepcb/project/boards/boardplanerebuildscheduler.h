@@ -0,0 +1,143 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANEREBUILDSCHEDULER_H
+#define LIBREPCB_PROJECT_BOARDPLANEREBUILDSCHEDULER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Plane;
+class BoardPlaneFragmentsBuilder;
+
+/*******************************************************************************
+ *  Class BoardPlaneRebuildScheduler
+ ******************************************************************************/
+
+/**
+ * @brief Rebuilds the planes of a board in parallel on worker threads
+ *
+ * All planes which need to be rebuilt (see
+ * librepcb::project::BoardPlaneCache::isPlaneDirty()) are rebuilt by a
+ * librepcb::project::BoardPlaneFragmentsBuilder each. Planes only depend on
+ * planes with a higher priority on the same layer, so all other planes are
+ * built at the same time in the global thread pool. A plane is started as
+ * soon as all the planes it depends on are finished.
+ *
+ * Planes which are not modified themselves but depend on a rebuilt plane are
+ * scheduled too, but they are only rebuilt if the fragments of at least one
+ * of their dependencies have actually changed.
+ *
+ * The input data of all builders is collected when starting the rebuild (i.e.
+ * the builders work on a snapshot of the board) and the results are applied to
+ * the planes in the main thread, so the board must not be accessed from worker
+ * threads at all. Since the board may be modified while a rebuild is running,
+ * results which are outdated when the rebuild is finished are dropped and the
+ * corresponding planes are kept dirty. Starting a new rebuild while another
+ * one is still running cancels the running one.
+ *
+ * As long as a rebuild is running or some results were dropped, the planes
+ * are considered as out of date (see #arePlanesOutdated()).
+ */
+class BoardPlaneRebuildScheduler final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  BoardPlaneRebuildScheduler()                                        = delete;
+  BoardPlaneRebuildScheduler(const BoardPlaneRebuildScheduler& other) = delete;
+  explicit BoardPlaneRebuildScheduler(Board& board) noexcept;
+  ~BoardPlaneRebuildScheduler() noexcept;
+
+  // Getters
+  bool isRunning() const noexcept { return !mCurrentRun.isNull(); }
+  bool arePlanesOutdated() const noexcept { return mPlanesOutdated; }
+
+  // General Methods
+  void start() noexcept;
+  void cancel() noexcept;
+  void waitForFinished() noexcept;
+
+  // Operator Overloadings
+  BoardPlaneRebuildScheduler& operator=(const BoardPlaneRebuildScheduler& rhs) =
+      delete;
+
+signals:
+  void finished();
+  void planesOutdatedChanged(bool outdated);
+
+private:  // Types
+  struct Run;
+  struct Job {
+    Run*                                       run;
+    BI_Plane*                                  plane;
+    QScopedPointer<BoardPlaneFragmentsBuilder> builder;
+    QVector<Path>                              oldFragments;
+    QList<Job*>                                dependencies;
+    QList<Job*>                                dependents;
+    QAtomicInt                                 pendingDependencies;
+    QString label;  ///< Plane UUID, only set if the profiler is enabled
+    bool onlyDependenciesModified;  ///< Whether the plane itself is not dirty
+    bool changed;                   ///< Whether the fragments have changed
+  };
+  struct Run {
+    ~Run() noexcept { qDeleteAll(jobs); }
+    QList<Job*> jobs;           ///< Sorted by priority (highest first)
+    int         pendingJobs;    ///< Protected by #mMutex
+    QAtomicInt  aborted;        ///< Skip all jobs which are not started yet
+    quint64     cacheRevision;  ///< BoardPlaneCache::getRevision() at start
+  };
+
+private slots:
+  void runFinished() noexcept;
+
+private:  // Methods
+  void run(Job* job) noexcept;
+  void execute(Job* job) noexcept;
+  void applyResults() noexcept;
+  void setPlanesOutdated(bool outdated) noexcept;
+
+private:  // Data
+  Board&              mBoard;
+  QScopedPointer<Run> mCurrentRun;
+  QList<Run*>         mCancelledRuns;  ///< Aborted, but jobs still running
+  bool                mPlanesOutdated;
+  QMutex              mMutex;
+  QWaitCondition      mWaitCondition;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDPLANEREBUILDSCHEDULER_H
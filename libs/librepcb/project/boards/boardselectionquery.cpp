@@ -47,19 +47,9 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardSelectionQuery::BoardSelectionQuery(
-    const QMap<Uuid, BI_Device*>& deviceInstances,
-    const QList<BI_NetSegment*>& netsegments, const QList<BI_Plane*>& planes,
-    const QList<BI_Polygon*>&    polygons,
-    const QList<BI_StrokeText*>& strokeTexts, const QList<BI_Hole*>& holes,
-    QObject* parent)
-  : QObject(parent),
-    mDevices(deviceInstances),
-    mNetSegments(netsegments),
-    mPlanes(planes),
-    mPolygons(polygons),
-    mStrokeTexts(strokeTexts),
-    mHoles(holes) {
+BoardSelectionQuery::BoardSelectionQuery(const QSet<BI_Base*>& selectedItems,
+                                         QObject*              parent)
+  : QObject(parent), mSelectedItems(selectedItems) {
 }
 
 BoardSelectionQuery::~BoardSelectionQuery() noexcept {
@@ -81,71 +71,70 @@ int BoardSelectionQuery::getResultCount() const noexcept {
  ******************************************************************************/
 
 void BoardSelectionQuery::addDeviceInstancesOfSelectedFootprints() noexcept {
-  foreach (BI_Device* device, mDevices) {
-    if (device->getFootprint().isSelected()) {
-      mResultDeviceInstances.insert(device);
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::Footprint) {
+      BI_Footprint* footprint = static_cast<BI_Footprint*>(item);
+      mResultDeviceInstances.insert(&footprint->getDeviceInstance());
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedVias() noexcept {
-  foreach (BI_NetSegment* netsegment, mNetSegments) {
-    foreach (BI_Via* via, netsegment->getVias()) {
-      if (via->isSelected()) {
-        mResultVias.insert(via);
-      }
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::Via) {
+      mResultVias.insert(static_cast<BI_Via*>(item));
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedNetPoints() noexcept {
-  foreach (BI_NetSegment* netsegment, mNetSegments) {
-    foreach (BI_NetPoint* netpoint, netsegment->getNetPoints()) {
-      if (netpoint->isSelected()) {
-        mResultNetPoints.insert(netpoint);
-      }
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::NetPoint) {
+      mResultNetPoints.insert(static_cast<BI_NetPoint*>(item));
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedNetLines() noexcept {
-  foreach (BI_NetSegment* netsegment, mNetSegments) {
-    foreach (BI_NetLine* netline, netsegment->getNetLines()) {
-      if (netline->isSelected()) {
-        mResultNetLines.insert(netline);
-      }
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::NetLine) {
+      mResultNetLines.insert(static_cast<BI_NetLine*>(item));
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedPlanes() noexcept {
-  foreach (BI_Plane* plane, mPlanes) {
-    if (plane->isSelected()) {
-      mResultPlanes.insert(plane);
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::Plane) {
+      mResultPlanes.insert(static_cast<BI_Plane*>(item));
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedPolygons() noexcept {
-  foreach (BI_Polygon* polygon, mPolygons) {
-    if (polygon->isSelected()) {
-      mResultPolygons.insert(polygon);
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::Polygon) {
+      mResultPolygons.insert(static_cast<BI_Polygon*>(item));
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedBoardStrokeTexts() noexcept {
-  foreach (BI_StrokeText* text, mStrokeTexts) {
-    if (text->isSelected()) {
-      mResultStrokeTexts.insert(text);
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::StrokeText) {
+      BI_StrokeText* text = static_cast<BI_StrokeText*>(item);
+      if (!text->getFootprint()) {
+        mResultStrokeTexts.insert(text);
+      }
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedFootprintStrokeTexts() noexcept {
-  foreach (BI_Device* device, mDevices) {
-    foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
-      if (text->isSelected()) {
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::StrokeText) {
+      BI_StrokeText* text = static_cast<BI_StrokeText*>(item);
+      if (text->getFootprint()) {
         mResultStrokeTexts.insert(text);
       }
     }
@@ -153,9 +142,9 @@ void BoardSelectionQuery::addSelectedFootprintStrokeTexts() noexcept {
 }
 
 void BoardSelectionQuery::addSelectedHoles() noexcept {
-  foreach (BI_Hole* hole, mHoles) {
-    if (hole->isSelected()) {
-      mResultHoles.insert(hole);
+  foreach (BI_Base* item, mSelectedItems) {
+    if (item->getType() == BI_Base::Type_t::Hole) {
+      mResultHoles.insert(static_cast<BI_Hole*>(item));
     }
   }
 }
@@ -0,0 +1,241 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardspatialindex.h"
+
+#include <librepcb/common/units/length.h>
+
+#include <QtCore>
+
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardSpatialIndex::BoardSpatialIndex() noexcept
+  : mCellSizePx(Length(5000000).toPx()),  // 5mm
+    mNextInsertionIndex(0) {
+}
+
+BoardSpatialIndex::~BoardSpatialIndex() noexcept {
+  Q_ASSERT(mItems.isEmpty());
+  Q_ASSERT(mSelectedItems.isEmpty());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QVector<BI_Base*> BoardSpatialIndex::getItemsAt(const QPointF& posPx) const
+    noexcept {
+  updateDirtyItems();
+  int               x = static_cast<int>(std::floor(posPx.x() / mCellSizePx));
+  int               y = static_cast<int>(std::floor(posPx.y() / mCellSizePx));
+  QVector<BI_Base*> items = mCells.value(getCellKey(x, y));
+  foreach (BI_Base* item, mLargeItems) { items.append(item); }
+  sortByInsertionOrder(items);
+  return items;
+}
+
+QVector<BI_Base*> BoardSpatialIndex::getItemsInRect(const QRectF& rectPx) const
+    noexcept {
+  updateDirtyItems();
+  QSet<BI_Base*> items = mLargeItems;
+  QRect          range = getCellRange(rectPx.normalized());
+  if (isLargeCellRange(range)) {
+    // the rect is huge, so iterating over all cells would be slower than
+    // just returning all items
+    foreach (BI_Base* item, mItems.keys()) { items.insert(item); }
+  } else {
+    for (int x = range.left(); x <= range.right(); ++x) {
+      for (int y = range.top(); y <= range.bottom(); ++y) {
+        auto it = mCells.constFind(getCellKey(x, y));
+        if (it != mCells.constEnd()) {
+          foreach (BI_Base* item, *it) { items.insert(item); }
+        }
+      }
+    }
+  }
+  QVector<BI_Base*> result = items.toList().toVector();
+  sortByInsertionOrder(result);
+  return result;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardSpatialIndex::insert(BI_Base& item) noexcept {
+  if ((!isIndexedType(item.getType())) || mItems.contains(&item)) {
+    return;
+  }
+  mItems.insert(&item, Entry{QRectF(), mNextInsertionIndex++});
+  mDirtyItems.insert(&item);  // calculate bounding rect lazily
+  if (item.isSelected()) {
+    mSelectedItems.insert(&item);
+  }
+}
+
+void BoardSpatialIndex::remove(BI_Base& item) noexcept {
+  auto it = mItems.find(&item);
+  if (it == mItems.end()) {
+    return;
+  }
+  if (!mDirtyItems.remove(&item)) {
+    removeFromCells(&item, it.value().rect);
+  }
+  mItems.erase(it);
+  mSelectedItems.remove(&item);
+}
+
+void BoardSpatialIndex::invalidate(BI_Base& item) noexcept {
+  auto it = mItems.find(&item);
+  if ((it != mItems.end()) && (!mDirtyItems.contains(&item))) {
+    removeFromCells(&item, it.value().rect);
+    mDirtyItems.insert(&item);
+  }
+}
+
+void BoardSpatialIndex::setSelected(BI_Base& item, bool selected) noexcept {
+  if (!mItems.contains(&item)) {
+    return;
+  }
+  if (selected) {
+    mSelectedItems.insert(&item);
+  } else {
+    mSelectedItems.remove(&item);
+  }
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+bool BoardSpatialIndex::isIndexedType(BI_Base::Type_t type) noexcept {
+  switch (type) {
+    case BI_Base::Type_t::NetPoint:
+    case BI_Base::Type_t::NetLine:
+    case BI_Base::Type_t::Via:
+    case BI_Base::Type_t::Footprint:
+    case BI_Base::Type_t::FootprintPad:
+    case BI_Base::Type_t::Polygon:
+    case BI_Base::Type_t::StrokeText:
+    case BI_Base::Type_t::Hole:
+    case BI_Base::Type_t::Plane:
+      return true;
+    default:
+      // these items have no grab area on their own
+      return false;
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardSpatialIndex::updateDirtyItems() const noexcept {
+  foreach (BI_Base* item, mDirtyItems) {
+    QRectF rect = item->getGrabAreaScenePx().boundingRect();
+    if (rect.isNull()) {
+      // items without grab area are still registered at their position to
+      // keep the bookkeeping simple
+      rect = QRectF(item->getPosition().toPxQPointF(), QSizeF());
+    }
+    mItems[item].rect = rect;
+    addToCells(item, rect);
+  }
+  mDirtyItems.clear();
+}
+
+void BoardSpatialIndex::sortByInsertionOrder(QVector<BI_Base*>& items) const
+    noexcept {
+  std::sort(items.begin(), items.end(), [this](BI_Base* a, BI_Base* b) {
+    return mItems.value(a).insertionIndex < mItems.value(b).insertionIndex;
+  });
+}
+
+void BoardSpatialIndex::addToCells(BI_Base* item, const QRectF& rect) const
+    noexcept {
+  QRect range = getCellRange(rect);
+  if (isLargeCellRange(range)) {
+    mLargeItems.insert(item);
+  } else {
+    for (int x = range.left(); x <= range.right(); ++x) {
+      for (int y = range.top(); y <= range.bottom(); ++y) {
+        mCells[getCellKey(x, y)].append(item);
+      }
+    }
+  }
+}
+
+void BoardSpatialIndex::removeFromCells(BI_Base* item, const QRectF& rect) const
+    noexcept {
+  QRect range = getCellRange(rect);
+  if (isLargeCellRange(range)) {
+    mLargeItems.remove(item);
+  } else {
+    for (int x = range.left(); x <= range.right(); ++x) {
+      for (int y = range.top(); y <= range.bottom(); ++y) {
+        auto it = mCells.find(getCellKey(x, y));
+        if (it != mCells.end()) {
+          it->removeOne(item);
+          if (it->isEmpty()) {
+            mCells.erase(it);
+          }
+        }
+      }
+    }
+  }
+}
+
+QRect BoardSpatialIndex::getCellRange(const QRectF& rect) const noexcept {
+  int left   = static_cast<int>(std::floor(rect.left() / mCellSizePx));
+  int top    = static_cast<int>(std::floor(rect.top() / mCellSizePx));
+  int right  = static_cast<int>(std::floor(rect.right() / mCellSizePx));
+  int bottom = static_cast<int>(std::floor(rect.bottom() / mCellSizePx));
+  return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+bool BoardSpatialIndex::isLargeCellRange(const QRect& range) const noexcept {
+  // QRect::width() and QRect::height() are inclusive, i.e. at least 1
+  return (qint64(range.width()) * qint64(range.height())) > 256;
+}
+
+quint64 BoardSpatialIndex::getCellKey(int x, int y) noexcept {
+  return (static_cast<quint64>(static_cast<quint32>(x)) << 32) |
+         static_cast<quint64>(static_cast<quint32>(y));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
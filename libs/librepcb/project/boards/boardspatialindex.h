@@ -0,0 +1,141 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDSPATIALINDEX_H
+#define LIBREPCB_PROJECT_BOARDSPATIALINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "items/bi_base.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Class BoardSpatialIndex
+ ******************************************************************************/
+
+/**
+ * @brief Spatial index of all selectable items of a board
+ *
+ * The scene is divided into a uniform grid of square cells. Every item which
+ * is added to the board is registered in all cells touched by the bounding
+ * rect of its grab area, so point and rectangle queries only need to look at
+ * the items of the affected cells instead of iterating over the whole board.
+ * Items covering a very large area (e.g. planes or the board outline) are kept
+ * in a separate list which is always part of the query result.
+ *
+ * Items only mark themselves as dirty when their geometry changes (see
+ * #invalidate()), the bounding rects are updated lazily before the next
+ * query. This keeps e.g. dragging items cheap since the grab areas are only
+ * recalculated once per query, not once per modification.
+ *
+ * Query results are sorted by the order in which the items were inserted, so
+ * they do not depend on hashing of pointers. Note that this is not the order
+ * of the board's item lists since items added later (e.g. netlines added to
+ * an existing netsegment, or items restored by undo) always get a higher
+ * index. Callers which need a persistent priority have to sort the result on
+ * their own.
+ *
+ * In addition, the index keeps track of all currently selected items to avoid
+ * iterating over the whole board when clearing or querying the selection.
+ *
+ * @note The returned candidates are not filtered by their exact grab area, it
+ *       is up to the caller to check
+ *       librepcb::project::BI_Base::getGrabAreaScenePx().
+ */
+class BoardSpatialIndex final {
+public:
+  // Constructors / Destructor
+  BoardSpatialIndex(const BoardSpatialIndex& other) = delete;
+  BoardSpatialIndex() noexcept;
+  ~BoardSpatialIndex() noexcept;
+
+  // Getters
+  int getItemCount() const noexcept { return mItems.count(); }
+  const QSet<BI_Base*>& getSelectedItems() const noexcept {
+    return mSelectedItems;
+  }
+  QVector<BI_Base*> getItemsAt(const QPointF& posPx) const noexcept;
+  QVector<BI_Base*> getItemsInRect(const QRectF& rectPx) const noexcept;
+
+  // General Methods
+  void insert(BI_Base& item) noexcept;
+  void remove(BI_Base& item) noexcept;
+  void invalidate(BI_Base& item) noexcept;
+  void setSelected(BI_Base& item, bool selected) noexcept;
+
+  // Static Methods
+  static bool isIndexedType(BI_Base::Type_t type) noexcept;
+
+  // Operator Overloadings
+  BoardSpatialIndex& operator=(const BoardSpatialIndex& rhs) = delete;
+
+private:  // Types
+  struct Entry {
+    QRectF  rect;            ///< Bounding rect the item is indexed with
+    quint64 insertionIndex;  ///< To sort query results
+  };
+
+private:  // Methods
+  void  updateDirtyItems() const noexcept;
+  void  sortByInsertionOrder(QVector<BI_Base*>& items) const noexcept;
+  void  addToCells(BI_Base* item, const QRectF& rect) const noexcept;
+  void  removeFromCells(BI_Base* item, const QRectF& rect) const noexcept;
+  QRect getCellRange(const QRectF& rect) const noexcept;
+  bool  isLargeCellRange(const QRect& range) const noexcept;
+  static quint64 getCellKey(int x, int y) noexcept;
+
+private:  // Data
+  /// Edge length of the grid cells in pixels
+  const qreal mCellSizePx;
+
+  /// All indexed items with the bounding rect they are currently indexed with
+  mutable QHash<BI_Base*, Entry> mItems;
+
+  /// Insertion index of the next inserted item
+  quint64 mNextInsertionIndex;
+
+  /// The items contained in each (non-empty) grid cell
+  mutable QHash<quint64, QVector<BI_Base*>> mCells;
+
+  /// Items which are too large to be registered in single cells
+  mutable QSet<BI_Base*> mLargeItems;
+
+  /// Items whose bounding rect needs to be updated before the next query
+  mutable QSet<BI_Base*> mDirtyItems;
+
+  /// All indexed items which are currently selected
+  QSet<BI_Base*> mSelectedItems;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDSPATIALINDEX_H
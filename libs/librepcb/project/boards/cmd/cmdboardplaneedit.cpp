@@ -167,8 +167,8 @@ void CmdBoardPlaneEdit::performUndo() {
   mPlane.setPriority(mOldPriority);
   mPlane.setKeepOrphans(mOldKeepOrphans);
 
-  // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  // rebuild affected planes to see the changes
+  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildDirtyPlanes();
 }
 
 void CmdBoardPlaneEdit::performRedo() {
@@ -181,8 +181,8 @@ void CmdBoardPlaneEdit::performRedo() {
   mPlane.setPriority(mNewPriority);
   mPlane.setKeepOrphans(mNewKeepOrphans);
 
-  // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  // rebuild affected planes to see the changes
+  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildDirtyPlanes();
 }
 
 /*******************************************************************************
@@ -39,7 +39,9 @@ namespace project {
 BI_AirWire::BI_AirWire(Board& board, const NetSignal& netsignal,
                        const Point& p1, const Point& p2)
   : BI_Base(board), mNetSignal(netsignal), mP1(p1), mP2(p2) {
-  mGraphicsItem.reset(new BGI_AirWire(*this));
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new BGI_AirWire(*this));
+  }
 }
 
 BI_AirWire::~BI_AirWire() noexcept {
@@ -53,9 +55,11 @@ void BI_AirWire::addToBoard() {
   if (isAddedToBoard()) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mHighlightChangedConnection =
-      connect(&mNetSignal, &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+  if (mGraphicsItem) {
+    mHighlightChangedConnection =
+        connect(&mNetSignal, &NetSignal::highlightedChanged,
+                [this]() { mGraphicsItem->update(); });
+  }
   BI_Base::addToBoard(mGraphicsItem.data());
 }
 
@@ -72,16 +76,18 @@ void BI_AirWire::removeFromBoard() {
  ******************************************************************************/
 
 QPainterPath BI_AirWire::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->shape();
+  return mGraphicsItem ? mGraphicsItem->shape() : QPainterPath();
 }
 
 void BI_AirWire::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 bool BI_AirWire::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 /*******************************************************************************
@@ -24,6 +24,8 @@
 
 #include "../../project.h"
 #include "../board.h"
+#include "../boardplanecache.h"
+#include "../boardspatialindex.h"
 #include "../graphicsitems/bgi_base.h"
 
 #include <librepcb/common/graphics/graphicsscene.h>
@@ -60,12 +62,19 @@ Circuit& BI_Base::getCircuit() const noexcept {
   return mBoard.getProject().getCircuit();
 }
 
+bool BI_Base::isHeadless() const noexcept {
+  return mBoard.getProject().isHeadless();
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
 
 void BI_Base::setSelected(bool selected) noexcept {
   mIsSelected = selected;
+  if (mIsAddedToBoard) {
+    mBoard.getSpatialIndex().setSelected(*this, selected);
+  }
 }
 
 /*******************************************************************************
@@ -78,6 +87,8 @@ void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
     mBoard.getGraphicsScene().addItem(*item);
   }
   mIsAddedToBoard = true;
+  mBoard.getSpatialIndex().insert(*this);
+  mBoard.getPlaneCache().insert(*this);
 }
 
 void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
@@ -86,6 +97,15 @@ void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
     mBoard.getGraphicsScene().removeItem(*item);
   }
   mIsAddedToBoard = false;
+  mBoard.getSpatialIndex().remove(*this);
+  mBoard.getPlaneCache().remove(*this);
+}
+
+void BI_Base::invalidateGeometry() noexcept {
+  if (mIsAddedToBoard) {
+    mBoard.getSpatialIndex().invalidate(*this);
+    mBoard.getPlaneCache().invalidate(*this);
+  }
 }
 
 /*******************************************************************************
@@ -98,10 +98,24 @@ public:
   BI_Base& operator=(const BI_Base& rhs) = delete;
 
 protected:
+  // Getters
+  bool isHeadless() const noexcept;
+
   // General Methods
   void addToBoard(QGraphicsItem* item) noexcept;
   void removeFromBoard(QGraphicsItem* item) noexcept;
 
+  /**
+   * @brief Notify the board that the geometry of this item has changed
+   *
+   * Must be called by all derived classes whenever the result of
+   * #getGrabAreaScenePx() or any property affecting the copper area of the
+   * item (e.g. its net signal) might have changed. Otherwise the item will not
+   * be found at its new location by the board's spatial index and planes will
+   * not be rebuilt properly by librepcb::project::Board::rebuildDirtyPlanes().
+   */
+  void invalidateGeometry() noexcept;
+
 protected:
   Board& mBoard;
 
@@ -73,8 +73,10 @@ BI_Footprint::BI_Footprint(BI_Device& device)
 
 void BI_Footprint::init() {
   // create graphics item
-  mGraphicsItem.reset(new BGI_Footprint(*this));
-  mGraphicsItem->setPos(mDevice.getPosition().toPxQPointF());
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new BGI_Footprint(*this));
+    mGraphicsItem->setPos(mDevice.getPosition().toPxQPointF());
+  }
   updateGraphicsItemTransform();
 
   // load pads
@@ -257,16 +259,21 @@ bool BI_Footprint::getIsMirrored() const noexcept {
 }
 
 QPainterPath BI_Footprint::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
 bool BI_Footprint::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Footprint::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
   foreach (BI_FootprintPad* pad, mPads)
     pad->setSelected(selected);
   foreach (BI_StrokeText* text, mStrokeTexts)
@@ -278,24 +285,35 @@ void BI_Footprint::setSelected(bool selected) noexcept {
  ******************************************************************************/
 
 void BI_Footprint::deviceInstanceAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  invalidateGeometry();
   emit attributesChanged();
 }
 
 void BI_Footprint::deviceInstanceMoved(const Point& pos) {
-  mGraphicsItem->setPos(pos.toPxQPointF());
-  mGraphicsItem->updateCacheAndRepaint();
+  // A pure translation does not modify the local geometry, so the cached
+  // shapes of the graphics items are still valid and only their positions
+  // need to be updated.
+  if (mGraphicsItem) {
+    mGraphicsItem->setPos(pos.toPxQPointF());
+  }
+  invalidateGeometry();
   foreach (BI_FootprintPad* pad, mPads) {
-    pad->updatePosition();
+    pad->updateTranslation();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
   }
-  foreach (BI_StrokeText* text, mStrokeTexts) { text->updateGraphicsItems(); }
+  foreach (BI_StrokeText* text, mStrokeTexts) { text->updateAnchorLine(); }
 }
 
 void BI_Footprint::deviceInstanceRotated(const Angle& rot) {
   Q_UNUSED(rot);
   updateGraphicsItemTransform();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  invalidateGeometry();
   foreach (BI_FootprintPad* pad, mPads) {
     pad->updatePosition();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -305,7 +323,10 @@ void BI_Footprint::deviceInstanceRotated(const Angle& rot) {
 void BI_Footprint::deviceInstanceMirrored(bool mirrored) {
   Q_UNUSED(mirrored);
   updateGraphicsItemTransform();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  invalidateGeometry();
   foreach (BI_FootprintPad* pad, mPads) {
     pad->updatePosition();
     mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
@@ -320,7 +341,9 @@ void BI_Footprint::updateGraphicsItemTransform() noexcept {
   QTransform t;
   if (mDevice.getIsMirrored()) t.scale(qreal(-1), qreal(1));
   t.rotate(-mDevice.getRotation().toDeg());
-  mGraphicsItem->setTransform(t);
+  if (mGraphicsItem) {
+    mGraphicsItem->setTransform(t);
+  }
 }
 
 /*******************************************************************************
@@ -72,7 +72,9 @@ BI_FootprintPad::BI_FootprintPad(BI_Footprint& footprint, const Uuid& padUuid)
             &BI_FootprintPad::componentSignalInstanceNetSignalChanged);
   }
 
-  mGraphicsItem.reset(new BGI_FootprintPad(*this));
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new BGI_FootprintPad(*this));
+  }
   updatePosition();
 
   // connect to the "attributes changed" signal of the footprint
@@ -179,9 +181,23 @@ void BI_FootprintPad::unregisterNetLine(BI_NetLine& netline) {
 void BI_FootprintPad::updatePosition() noexcept {
   mPosition = mFootprint.mapToScene(mFootprintPad->getPosition());
   mRotation = mFootprint.getRotation() + mFootprintPad->getRotation();
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  if (mGraphicsItem) {
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+  }
   updateGraphicsItemTransform();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  invalidateGeometry();
+  foreach (BI_NetLine* netline, mRegisteredNetLines) { netline->updateLine(); }
+}
+
+void BI_FootprintPad::updateTranslation() noexcept {
+  mPosition = mFootprint.mapToScene(mFootprintPad->getPosition());
+  if (mGraphicsItem) {
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+  }
+  invalidateGeometry();
   foreach (BI_NetLine* netline, mRegisteredNetLines) { netline->updateLine(); }
 }
 
@@ -194,16 +210,21 @@ bool BI_FootprintPad::getIsMirrored() const noexcept {
 }
 
 QPainterPath BI_FootprintPad::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
 bool BI_FootprintPad::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_FootprintPad::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 Path BI_FootprintPad::getOutline(const Length& expansion) const noexcept {
@@ -219,7 +240,10 @@ Path BI_FootprintPad::getSceneOutline(const Length& expansion) const noexcept {
  ******************************************************************************/
 
 void BI_FootprintPad::footprintAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  invalidateGeometry();
 }
 
 void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from,
@@ -228,13 +252,14 @@ void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from,
   if (mHighlightChangedConnection) {
     disconnect(mHighlightChangedConnection);
   }
-  if (to) {
+  if (to && mGraphicsItem) {
     mHighlightChangedConnection =
         connect(to, &NetSignal::highlightedChanged,
                 [this]() { mGraphicsItem->update(); });
   }
   mBoard.scheduleAirWiresRebuild(from);
   mBoard.scheduleAirWiresRebuild(to);
+  invalidateGeometry();  // the net signal affects planes
 }
 
 /*******************************************************************************
@@ -245,7 +270,9 @@ void BI_FootprintPad::updateGraphicsItemTransform() noexcept {
   QTransform t;
   if (mFootprint.getIsMirrored()) t.scale(qreal(-1), qreal(1));
   t.rotate(-mRotation.toDeg());
-  mGraphicsItem->setTransform(t);
+  if (mGraphicsItem) {
+    mGraphicsItem->setTransform(t);
+  }
 }
 
 /*******************************************************************************
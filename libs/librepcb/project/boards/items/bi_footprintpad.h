@@ -87,6 +87,15 @@ public:
   void removeFromBoard() override;
   void updatePosition() noexcept;
 
+  /**
+   * @brief Update the position after the footprint was moved
+   *
+   * Same as #updatePosition(), but assumes that neither the rotation nor the
+   * mirror state of the footprint has changed. So only the position of the
+   * graphics item is updated, without rebuilding its cached shapes.
+   */
+  void updateTranslation() noexcept;
+
   // Inherited from BI_Base
   Type_t getType() const noexcept override {
     return BI_Base::Type_t::FootprintPad;
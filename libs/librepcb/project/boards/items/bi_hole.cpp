@@ -57,11 +57,15 @@ BI_Hole::BI_Hole(Board& board, const Hole& hole) : BI_Base(board) {
 }
 
 void BI_Hole::init() {
-  mGraphicsItem.reset(new HoleGraphicsItem(*mHole, mBoard.getLayerStack()));
+  mHole->registerObserver(*this);
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new HoleGraphicsItem(*mHole, mBoard.getLayerStack()));
+  }
 }
 
 BI_Hole::~BI_Hole() noexcept {
   mGraphicsItem.reset();
+  mHole->unregisterObserver(*this);
   mHole.reset();
 }
 
@@ -96,6 +100,9 @@ const Point& BI_Hole::getPosition() const noexcept {
 }
 
 QPainterPath BI_Hole::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
@@ -106,12 +113,14 @@ const Uuid& BI_Hole::getUuid() const noexcept {
 bool BI_Hole::isSelectable() const noexcept {
   const GraphicsLayer* layer =
       mBoard.getLayerStack().getLayer(GraphicsLayer::sBoardDrillsNpth);
-  return layer && layer->isVisible();
+  return mGraphicsItem && layer && layer->isVisible();
 }
 
 void BI_Hole::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->setSelected(selected);
+  if (mGraphicsItem) {
+    mGraphicsItem->setSelected(selected);
+  }
 }
 
 /*******************************************************************************
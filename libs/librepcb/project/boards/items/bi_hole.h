@@ -49,7 +49,9 @@ class Board;
 /**
  * @brief The BI_Hole class
  */
-class BI_Hole final : public BI_Base, public SerializableObject {
+class BI_Hole final : public BI_Base,
+                      public SerializableObject,
+                      public IF_HoleObserver {
   Q_OBJECT
 
 public:
@@ -87,6 +89,15 @@ public:
 
 private:  // Methods
   void init();
+  void holePositionChanged(const Point& newPos) noexcept override {
+    Q_UNUSED(newPos);
+    invalidateGeometry();
+  }
+  void holeDiameterChanged(
+      const PositiveLength& newDiameter) noexcept override {
+    Q_UNUSED(newDiameter);
+    invalidateGeometry();
+  }
 
 private:  // Data
   QScopedPointer<Hole>             mHole;
@@ -159,7 +159,9 @@ void BI_NetLine::init() {
                      tr("BI_NetLine: both endpoints are the same."));
   }
 
-  mGraphicsItem.reset(new BGI_NetLine(*this));
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new BGI_NetLine(*this));
+  }
   updateLine();
 }
 
@@ -207,14 +209,20 @@ void BI_NetLine::setLayer(GraphicsLayer& layer) {
   }
   if (&layer != mLayer) {
     mLayer = &layer;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
+    invalidateGeometry();
   }
 }
 
 void BI_NetLine::setWidth(const PositiveLength& width) noexcept {
   if (width != mWidth) {
     mWidth = width;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
+    invalidateGeometry();
   }
 }
 
@@ -231,9 +239,11 @@ void BI_NetLine::addToBoard() {
   auto sg = scopeGuard([&]() { mStartPoint->unregisterNetLine(*this); });
   mEndPoint->registerNetLine(*this);  // can throw
 
-  mHighlightChangedConnection =
-      connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+  if (mGraphicsItem) {
+    mHighlightChangedConnection =
+        connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
+                [this]() { mGraphicsItem->update(); });
+  }
   BI_Base::addToBoard(mGraphicsItem.data());
   sg.dismiss();
 }
@@ -254,7 +264,10 @@ void BI_NetLine::removeFromBoard() {
 
 void BI_NetLine::updateLine() noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  invalidateGeometry();
 }
 
 void BI_NetLine::serialize(SExpression& root) const {
@@ -304,16 +317,18 @@ void BI_NetLine::serializeAnchor(SExpression&      root,
  ******************************************************************************/
 
 QPainterPath BI_NetLine::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->shape();
+  return mGraphicsItem ? mGraphicsItem->shape() : QPainterPath();
 }
 
 bool BI_NetLine::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_NetLine::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 /*******************************************************************************
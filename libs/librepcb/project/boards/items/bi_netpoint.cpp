@@ -64,8 +64,10 @@ BI_NetPoint::BI_NetPoint(BI_NetSegment& segment, const Point& position)
 
 void BI_NetPoint::init() {
   // create the graphics item
-  mGraphicsItem.reset(new BGI_NetPoint(*this));
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new BGI_NetPoint(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+  }
 
   // create ERC messages
   mErcMsgDeadNetPoint.reset(
@@ -101,7 +103,10 @@ GraphicsLayer* BI_NetPoint::getLayerOfLines() const noexcept {
 void BI_NetPoint::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    if (mGraphicsItem) {
+      mGraphicsItem->setPos(mPosition.toPxQPointF());
+    }
+    invalidateGeometry();
     foreach (BI_NetLine* line, mRegisteredNetLines) { line->updateLine(); }
     mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
   }
@@ -115,9 +120,11 @@ void BI_NetPoint::addToBoard() {
   if (isAddedToBoard() || isUsed()) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mHighlightChangedConnection =
-      connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+  if (mGraphicsItem) {
+    mHighlightChangedConnection =
+        connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
+                [this]() { mGraphicsItem->update(); });
+  }
   mErcMsgDeadNetPoint->setVisible(true);
   BI_Base::addToBoard(mGraphicsItem.data());
   mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
@@ -142,7 +149,10 @@ void BI_NetPoint::registerNetLine(BI_NetLine& netline) {
   }
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  invalidateGeometry();  // size depends on the line widths
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -152,7 +162,10 @@ void BI_NetPoint::unregisterNetLine(BI_NetLine& netline) {
   }
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  invalidateGeometry();  // size depends on the line widths
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -166,16 +179,21 @@ void BI_NetPoint::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath BI_NetPoint::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
 bool BI_NetPoint::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_NetPoint::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 /*******************************************************************************
@@ -52,7 +52,8 @@ BI_NetSegment::BI_NetSegment(Board& board, const BI_NetSegment& other,
                              const QHash<const BI_Device*, BI_Device*>& devMap)
   : BI_Base(board),
     mUuid(Uuid::createRandom()),
-    mNetSignal(&other.getNetSignal()) {
+    mNetSignal(&other.getNetSignal()),
+    mConnectivityValid(false) {
   // determine new pad anchors
   QHash<const BI_NetLineAnchor*, BI_NetLineAnchor*> anchorsMap;
   for (auto it = devMap.begin(); it != devMap.end(); ++it) {
@@ -90,7 +91,8 @@ BI_NetSegment::BI_NetSegment(Board& board, const BI_NetSegment& other,
 BI_NetSegment::BI_NetSegment(Board& board, const SExpression& node)
   : BI_Base(board),
     mUuid(node.getChildByIndex(0).getValue<Uuid>()),
-    mNetSignal(nullptr) {
+    mNetSignal(nullptr),
+    mConnectivityValid(false) {
   try {
     Uuid netSignalUuid = node.getValueByPath<Uuid>("net");
     mNetSignal =
@@ -102,39 +104,45 @@ BI_NetSegment::BI_NetSegment(Board& board, const SExpression& node)
     }
 
     // Load all vias
+    QSet<Uuid> viaUuids;
     foreach (const SExpression& node, node.getChildren("via")) {
       BI_Via* via = new BI_Via(*this, node);
-      if (getViaByUuid(via->getUuid())) {
+      if (viaUuids.contains(via->getUuid())) {
         throw RuntimeError(
             __FILE__, __LINE__,
             QString(tr("There is already a via with the UUID \"%1\"!"))
                 .arg(via->getUuid().toStr()));
       }
+      viaUuids.insert(via->getUuid());
       mVias.append(via);
     }
 
     // Load all netpoints
+    QSet<Uuid> netPointUuids;
     foreach (const SExpression& child, node.getChildren("junction")) {
       BI_NetPoint* netpoint = new BI_NetPoint(*this, child);
-      if (getNetPointByUuid(netpoint->getUuid())) {
+      if (netPointUuids.contains(netpoint->getUuid())) {
         throw RuntimeError(
             __FILE__, __LINE__,
             QString(tr("There is already a netpoint with the UUID \"%1\"!"))
                 .arg(netpoint->getUuid().toStr()));
       }
+      netPointUuids.insert(netpoint->getUuid());
       mNetPoints.append(netpoint);
     }
 
     // Load all netlines
+    QSet<Uuid> netLineUuids;
     foreach (const SExpression& node,
              node.getChildren("netline") + node.getChildren("trace")) {
       BI_NetLine* netline = new BI_NetLine(*this, node);
-      if (getNetLineByUuid(netline->getUuid())) {
+      if (netLineUuids.contains(netline->getUuid())) {
         throw RuntimeError(
             __FILE__, __LINE__,
             QString(tr("There is already a netline with the UUID \"%1\"!"))
                 .arg(netline->getUuid().toStr()));
       }
+      netLineUuids.insert(netline->getUuid());
       mNetLines.append(netline);
     }
 
@@ -159,7 +167,10 @@ BI_NetSegment::BI_NetSegment(Board& board, const SExpression& node)
 }
 
 BI_NetSegment::BI_NetSegment(Board& board, NetSignal& signal)
-  : BI_Base(board), mUuid(Uuid::createRandom()), mNetSignal(&signal) {
+  : BI_Base(board),
+    mUuid(Uuid::createRandom()),
+    mNetSignal(&signal),
+    mConnectivityValid(false) {
 }
 
 BI_NetSegment::~BI_NetSegment() noexcept {
@@ -181,51 +192,6 @@ bool BI_NetSegment::isUsed() const noexcept {
           (!mNetLines.isEmpty()));
 }
 
-int BI_NetSegment::getViasAtScenePos(const Point&    pos,
-                                     QList<BI_Via*>& vias) const noexcept {
-  int count = 0;
-  foreach (BI_Via* via, mVias) {
-    if (via->isSelectable() &&
-        via->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
-      vias.append(via);
-      ++count;
-    }
-  }
-  return count;
-}
-
-int BI_NetSegment::getNetPointsAtScenePos(const Point&         pos,
-                                          const GraphicsLayer* layer,
-                                          QList<BI_NetPoint*>& points) const
-    noexcept {
-  int count = 0;
-  foreach (BI_NetPoint* netpoint, mNetPoints) {
-    if (netpoint->isSelectable() &&
-        netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-        ((!layer) || (netpoint->getLayerOfLines() == layer))) {
-      points.append(netpoint);
-      ++count;
-    }
-  }
-  return count;
-}
-
-int BI_NetSegment::getNetLinesAtScenePos(const Point&         pos,
-                                         const GraphicsLayer* layer,
-                                         QList<BI_NetLine*>&  lines) const
-    noexcept {
-  int count = 0;
-  foreach (BI_NetLine* netline, mNetLines) {
-    if (netline->isSelectable() &&
-        netline->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-        ((!layer) || (&netline->getLayer() == layer))) {
-      lines.append(netline);
-      ++count;
-    }
-  }
-  return count;
-}
-
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -291,13 +257,30 @@ void BI_NetSegment::addElements(const QList<BI_Via*>&      vias,
     throw LogicError(__FILE__, __LINE__);
   }
 
-  ScopeGuardList sgl(netpoints.count() + netlines.count());
+  // collect the UUIDs of all existing items only once to avoid quadratic
+  // runtime when adding many items at once
+  QSet<Uuid> viaUuids, netPointUuids, netLineUuids;
+  foreach (const BI_Via* via, mVias) {
+    viaUuids.insert(via->getUuid());
+  }
+  foreach (const BI_NetPoint* netpoint, mNetPoints) {
+    netPointUuids.insert(netpoint->getUuid());
+  }
+  foreach (const BI_NetLine* netline, mNetLines) {
+    netLineUuids.insert(netline->getUuid());
+  }
+
+  ScopeGuardList sgl(vias.count() + netpoints.count() + netlines.count() + 1);
+  sgl.add([this]() { mConnectivityValid = false; });
   foreach (BI_Via* via, vias) {
-    if ((mVias.contains(via)) || (&via->getNetSegment() != this)) {
+    if (&via->getNetSegment() != this) {
       throw LogicError(__FILE__, __LINE__);
     }
     // check if there is no via with the same uuid in the list
-    if (getViaByUuid(via->getUuid())) {
+    if (viaUuids.contains(via->getUuid())) {
+      if (mVias.contains(via)) {
+        throw LogicError(__FILE__, __LINE__);
+      }
       throw RuntimeError(
           __FILE__, __LINE__,
           QString(tr("There is already a via with the UUID \"%1\"!"))
@@ -305,6 +288,7 @@ void BI_NetSegment::addElements(const QList<BI_Via*>&      vias,
     }
     // add to board
     via->addToBoard();  // can throw
+    viaUuids.insert(via->getUuid());
     mVias.append(via);
     sgl.add([this, via]() {
       via->removeFromBoard();
@@ -312,12 +296,14 @@ void BI_NetSegment::addElements(const QList<BI_Via*>&      vias,
     });
   }
   foreach (BI_NetPoint* netpoint, netpoints) {
-    if ((mNetPoints.contains(netpoint)) ||
-        (&netpoint->getNetSegment() != this)) {
+    if (&netpoint->getNetSegment() != this) {
       throw LogicError(__FILE__, __LINE__);
     }
     // check if there is no netpoint with the same uuid in the list
-    if (getNetPointByUuid(netpoint->getUuid())) {
+    if (netPointUuids.contains(netpoint->getUuid())) {
+      if (mNetPoints.contains(netpoint)) {
+        throw LogicError(__FILE__, __LINE__);
+      }
       throw RuntimeError(
           __FILE__, __LINE__,
           QString(tr("There is already a netpoint with the UUID \"%1\"!"))
@@ -325,6 +311,7 @@ void BI_NetSegment::addElements(const QList<BI_Via*>&      vias,
     }
     // add to board
     netpoint->addToBoard();  // can throw
+    netPointUuids.insert(netpoint->getUuid());
     mNetPoints.append(netpoint);
     sgl.add([this, netpoint]() {
       netpoint->removeFromBoard();
@@ -332,11 +319,14 @@ void BI_NetSegment::addElements(const QList<BI_Via*>&      vias,
     });
   }
   foreach (BI_NetLine* netline, netlines) {
-    if ((mNetLines.contains(netline)) || (&netline->getNetSegment() != this)) {
+    if (&netline->getNetSegment() != this) {
       throw LogicError(__FILE__, __LINE__);
     }
     // check if there is no netline with the same uuid in the list
-    if (getNetLineByUuid(netline->getUuid())) {
+    if (netLineUuids.contains(netline->getUuid())) {
+      if (mNetLines.contains(netline)) {
+        throw LogicError(__FILE__, __LINE__);
+      }
       throw RuntimeError(
           __FILE__, __LINE__,
           QString(tr("There is already a netline with the UUID \"%1\"!"))
@@ -344,11 +334,17 @@ void BI_NetSegment::addElements(const QList<BI_Via*>&      vias,
     }
     // add to board
     netline->addToBoard();  // can throw
+    netLineUuids.insert(netline->getUuid());
     mNetLines.append(netline);
     sgl.add([this, netline]() {
       netline->removeFromBoard();
       mNetLines.removeOne(netline);
     });
+    if (mConnectivityValid) {
+      // new netlines can only merge groups of anchors, so the connectivity
+      // can be updated incrementally
+      mConnectivity.unite(&netline->getStartPoint(), &netline->getEndPoint());
+    }
   }
 
   if (!areAllNetPointsConnectedTogether()) {
@@ -368,7 +364,11 @@ void BI_NetSegment::removeElements(const QList<BI_Via*>&      vias,
     throw LogicError(__FILE__, __LINE__);
   }
 
-  ScopeGuardList sgl(netpoints.count() + netlines.count());
+  // removing netlines may split groups of anchors, thus the connectivity
+  // needs to be rebuilt from scratch
+  mConnectivityValid = false;
+
+  ScopeGuardList sgl(vias.count() + netpoints.count() + netlines.count());
   foreach (BI_NetLine* netline, netlines) {
     if (!mNetLines.contains(netline)) {
       throw LogicError(__FILE__, __LINE__);
@@ -470,27 +470,6 @@ void BI_NetSegment::removeFromBoard() {
   sgl.dismiss();
 }
 
-void BI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept {
-  foreach (BI_Via* via, mVias)
-    via->setSelected(via->isSelectable() &&
-                     via->getGrabAreaScenePx().intersects(rectPx));
-  foreach (BI_NetPoint* netpoint, mNetPoints)
-    netpoint->setSelected(netpoint->isSelectable() &&
-                          netpoint->getGrabAreaScenePx().intersects(rectPx));
-  foreach (BI_NetLine* netline, mNetLines)
-    netline->setSelected(netline->isSelectable() &&
-                         netline->getGrabAreaScenePx().intersects(rectPx));
-}
-
-void BI_NetSegment::clearSelection() const noexcept {
-  foreach (BI_Via* via, mVias)
-    via->setSelected(false);
-  foreach (BI_NetPoint* netpoint, mNetPoints)
-    netpoint->setSelected(false);
-  foreach (BI_NetLine* netline, mNetLines)
-    netline->setSelected(false);
-}
-
 void BI_NetSegment::serialize(SExpression& root) const {
   if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
@@ -548,55 +527,24 @@ bool BI_NetSegment::areAllNetPointsConnectedTogether() const noexcept {
                   // together" :)
   }
   Q_ASSERT(p);
-  QSet<const BI_Via*>          vias;
-  QSet<const BI_NetPoint*>     points;
-  QSet<const BI_FootprintPad*> pads;
-  findAllConnectedNetPoints(*p, vias, pads, points);
-  return (vias.count() == mVias.count()) &&
-         (points.count() == mNetPoints.count());
+  if (!mConnectivityValid) {
+    rebuildConnectivity();
+  }
+  foreach (const BI_Via* via, mVias) {
+    if (!mConnectivity.isConnected(p, via)) return false;
+  }
+  foreach (const BI_NetPoint* netpoint, mNetPoints) {
+    if (!mConnectivity.isConnected(p, netpoint)) return false;
+  }
+  return true;
 }
 
-void BI_NetSegment::findAllConnectedNetPoints(
-    const BI_NetLineAnchor& p, QSet<const BI_Via*>& vias,
-    QSet<const BI_FootprintPad*>& pads, QSet<const BI_NetPoint*>& points) const
-    noexcept {
-  if (const BI_Via* via = dynamic_cast<const BI_Via*>(&p)) {
-    if (vias.contains(via)) return;
-    vias.insert(via);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == via) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == via) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
-    }
-  } else if (const BI_FootprintPad* pad =
-                 dynamic_cast<const BI_FootprintPad*>(&p)) {
-    if (pads.contains(pad)) return;
-    pads.insert(pad);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == pad) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == pad) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
-    }
-  } else if (const BI_NetPoint* np = dynamic_cast<const BI_NetPoint*>(&p)) {
-    if (points.contains(np)) return;
-    points.insert(np);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == np) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == np) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
-    }
-  } else {
-    Q_ASSERT(false);
+void BI_NetSegment::rebuildConnectivity() const noexcept {
+  mConnectivity.clear();
+  foreach (const BI_NetLine* netline, mNetLines) {
+    mConnectivity.unite(&netline->getStartPoint(), &netline->getEndPoint());
   }
+  mConnectivityValid = true;
 }
 
 /*******************************************************************************
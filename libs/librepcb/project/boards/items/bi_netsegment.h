@@ -26,6 +26,7 @@
 #include "bi_base.h"
 
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/utils/unionfind.h>
 #include <librepcb/common/uuid.h>
 
 #include <QtCore>
@@ -34,15 +35,11 @@
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
-
-class GraphicsLayer;
-
 namespace project {
 
 class NetSignal;
 class BI_Device;
 class BI_Via;
-class BI_FootprintPad;
 class BI_NetPoint;
 class BI_NetLine;
 class BI_NetLineAnchor;
@@ -73,11 +70,6 @@ public:
   const Uuid& getUuid() const noexcept { return mUuid; }
   NetSignal&  getNetSignal() const noexcept { return *mNetSignal; }
   bool        isUsed() const noexcept;
-  int getViasAtScenePos(const Point& pos, QList<BI_Via*>& vias) const noexcept;
-  int getNetPointsAtScenePos(const Point& pos, const GraphicsLayer* layer,
-                             QList<BI_NetPoint*>& points) const noexcept;
-  int getNetLinesAtScenePos(const Point& pos, const GraphicsLayer* layer,
-                            QList<BI_NetLine*>& lines) const noexcept;
 
   // Setters
   void setNetSignal(NetSignal& netsignal);
@@ -107,8 +99,6 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
-  void setSelectionRect(const QRectF rectPx) noexcept;
-  void clearSelection() const noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -135,11 +125,7 @@ public:
 private:
   bool checkAttributesValidity() const noexcept;
   bool areAllNetPointsConnectedTogether() const noexcept;
-  void findAllConnectedNetPoints(const BI_NetLineAnchor&       p,
-                                 QSet<const BI_Via*>&          vias,
-                                 QSet<const BI_FootprintPad*>& pads,
-                                 QSet<const BI_NetPoint*>&     points) const
-      noexcept;
+  void rebuildConnectivity() const noexcept;
 
   // Attributes
   Uuid       mUuid;
@@ -149,6 +135,15 @@ private:
   QList<BI_Via*>      mVias;
   QList<BI_NetPoint*> mNetPoints;
   QList<BI_NetLine*>  mNetLines;
+
+  /**
+   * @brief Connectivity of all anchors (vias, netpoints and pads)
+   *
+   * Updated incrementally when adding netlines. Removing netlines invalidates
+   * it, then it is rebuilt by the next cohesion check.
+   */
+  mutable UnionFind<const BI_NetLineAnchor*> mConnectivity;
+  mutable bool                               mConnectivityValid;
 };
 
 /*******************************************************************************
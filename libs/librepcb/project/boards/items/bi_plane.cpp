@@ -25,7 +25,7 @@
 #include "../../circuit/circuit.h"
 #include "../../circuit/netsignal.h"
 #include "../../project.h"
-#include "../boardplanefragmentsbuilder.h"
+#include "../boardplanecache.h"
 #include "../graphicsitems/bgi_plane.h"
 
 #include <librepcb/common/scopeguard.h>
@@ -106,9 +106,11 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid,
 }
 
 void BI_Plane::init() {
-  mGraphicsItem.reset(new BGI_Plane(*this));
-  mGraphicsItem->setPos(getPosition().toPxQPointF());
-  mGraphicsItem->setRotation(Angle::deg0().toDeg());
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new BGI_Plane(*this));
+    mGraphicsItem->setPos(getPosition().toPxQPointF());
+    mGraphicsItem->setRotation(Angle::deg0().toDeg());
+  }
 
   // connect to the "attributes changed" signal of the board
   connect(&mBoard, &Board::attributesChanged, this,
@@ -126,14 +128,20 @@ BI_Plane::~BI_Plane() noexcept {
 void BI_Plane::setOutline(const Path& outline) noexcept {
   if (outline != mOutline) {
     mOutline = outline;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
+    invalidateGeometry();
   }
 }
 
 void BI_Plane::setLayerName(const GraphicsLayerName& layerName) noexcept {
   if (layerName != mLayerName) {
     mLayerName = layerName;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
+    invalidateGeometry();
   }
 }
 
@@ -149,36 +157,53 @@ void BI_Plane::setNetSignal(NetSignal& netsignal) {
       sg.dismiss();
     }
     mNetSignal = &netsignal;
+    invalidateGeometry();
   }
 }
 
 void BI_Plane::setMinWidth(const UnsignedLength& minWidth) noexcept {
   if (minWidth != mMinWidth) {
     mMinWidth = minWidth;
+    invalidateGeometry();
   }
 }
 
 void BI_Plane::setMinClearance(const UnsignedLength& minClearance) noexcept {
   if (minClearance != mMinClearance) {
     mMinClearance = minClearance;
+    invalidateGeometry();
   }
 }
 
 void BI_Plane::setConnectStyle(BI_Plane::ConnectStyle style) noexcept {
   if (style != mConnectStyle) {
     mConnectStyle = style;
+    invalidateGeometry();
   }
 }
 
 void BI_Plane::setPriority(int priority) noexcept {
   if (priority != mPriority) {
     mPriority = priority;
+    invalidateGeometry();
   }
 }
 
 void BI_Plane::setKeepOrphans(bool keepOrphans) noexcept {
   if (keepOrphans != mKeepOrphans) {
     mKeepOrphans = keepOrphans;
+    invalidateGeometry();
+  }
+}
+
+void BI_Plane::setFragments(const QVector<Path>& fragments) noexcept {
+  if (fragments != mFragments) {
+    mFragments = fragments;
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
+    mBoard.getPlaneCache().planeFragmentsChanged(*this);
+    mBoard.scheduleAirWiresRebuild(mNetSignal);
   }
 }
 
@@ -192,7 +217,9 @@ void BI_Plane::addToBoard() {
   }
   mNetSignal->registerBoardPlane(*this);  // can throw
   BI_Base::addToBoard(mGraphicsItem.data());
-  mGraphicsItem->updateCacheAndRepaint();  // TODO: remove this
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();  // TODO: remove this
+  }
   mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
@@ -206,15 +233,7 @@ void BI_Plane::removeFromBoard() {
 }
 
 void BI_Plane::clear() noexcept {
-  mFragments.clear();
-  mGraphicsItem->updateCacheAndRepaint();
-}
-
-void BI_Plane::rebuild() noexcept {
-  BoardPlaneFragmentsBuilder builder(*this);
-  mFragments = builder.buildFragments();
-  mGraphicsItem->updateCacheAndRepaint();
-  mBoard.scheduleAirWiresRebuild(mNetSignal);
+  setFragments(QVector<Path>());
 }
 
 void BI_Plane::serialize(SExpression& root) const {
@@ -236,16 +255,21 @@ void BI_Plane::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath BI_Plane::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
 bool BI_Plane::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Plane::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 /*******************************************************************************
@@ -269,7 +293,9 @@ bool BI_Plane::operator<(const BI_Plane& rhs) const noexcept {
  ******************************************************************************/
 
 void BI_Plane::boardAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 /*******************************************************************************
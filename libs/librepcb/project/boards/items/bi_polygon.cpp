@@ -68,17 +68,21 @@ BI_Polygon::BI_Polygon(Board& board, const Uuid& uuid,
 }
 
 void BI_Polygon::init() {
-  mGraphicsItem.reset(
-      new PolygonGraphicsItem(*mPolygon, mBoard.getLayerStack()));
-  mGraphicsItem->setZValue(Board::ZValue_Default);
-
-  // connect to the "attributes changed" signal of the board
-  connect(&mBoard, &Board::attributesChanged, this,
-          &BI_Polygon::boardAttributesChanged);
+  mPolygon->registerObserver(*this);
+  if (!isHeadless()) {
+    mGraphicsItem.reset(
+        new PolygonGraphicsItem(*mPolygon, mBoard.getLayerStack()));
+    mGraphicsItem->setZValue(Board::ZValue_Default);
+
+    // connect to the "attributes changed" signal of the board
+    connect(&mBoard, &Board::attributesChanged, this,
+            &BI_Polygon::boardAttributesChanged);
+  }
 }
 
 BI_Polygon::~BI_Polygon() noexcept {
   mGraphicsItem.reset();
+  mPolygon->unregisterObserver(*this);
   mPolygon.reset();
 }
 
@@ -109,6 +113,9 @@ void BI_Polygon::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath BI_Polygon::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
@@ -119,12 +126,14 @@ const Uuid& BI_Polygon::getUuid() const noexcept {
 bool BI_Polygon::isSelectable() const noexcept {
   const GraphicsLayer* layer =
       mBoard.getLayerStack().getLayer(*mPolygon->getLayerName());
-  return layer && layer->isVisible();
+  return mGraphicsItem && layer && layer->isVisible();
 }
 
 void BI_Polygon::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->setSelected(selected);
+  if (mGraphicsItem) {
+    mGraphicsItem->setSelected(selected);
+  }
 }
 
 /*******************************************************************************
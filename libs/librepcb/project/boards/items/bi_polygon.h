@@ -26,6 +26,7 @@
 #include "bi_base.h"
 
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/geometry/polygon.h>
 #include <librepcb/common/graphics/graphicslayername.h>
 #include <librepcb/common/uuid.h>
 
@@ -36,8 +37,6 @@
  ******************************************************************************/
 namespace librepcb {
 
-class Path;
-class Polygon;
 class PolygonGraphicsItem;
 
 namespace project {
@@ -56,7 +55,9 @@ class BGI_Polygon;
  * @author ubruhin
  * @date 2016-01-12
  */
-class BI_Polygon final : public BI_Base, public SerializableObject {
+class BI_Polygon final : public BI_Base,
+                         public SerializableObject,
+                         public IF_PolygonObserver {
   Q_OBJECT
 
 public:
@@ -104,6 +105,28 @@ private slots:
 
 private:
   void init();
+  void polygonLayerNameChanged(
+      const GraphicsLayerName& newLayerName) noexcept override {
+    Q_UNUSED(newLayerName);
+    invalidateGeometry();
+  }
+  void polygonLineWidthChanged(
+      const UnsignedLength& newLineWidth) noexcept override {
+    Q_UNUSED(newLineWidth);
+    invalidateGeometry();
+  }
+  void polygonIsFilledChanged(bool newIsFilled) noexcept override {
+    Q_UNUSED(newIsFilled);
+    invalidateGeometry();
+  }
+  void polygonIsGrabAreaChanged(bool newIsGrabArea) noexcept override {
+    Q_UNUSED(newIsGrabArea);
+    invalidateGeometry();
+  }
+  void polygonPathChanged(const Path& newPath) noexcept override {
+    Q_UNUSED(newPath);
+    invalidateGeometry();
+  }
 
   // General
   QScopedPointer<Polygon>             mPolygon;
@@ -69,9 +69,11 @@ void BI_StrokeText::init() {
   mText->setFont(&getProject().getStrokeFonts().getFont(
       mBoard.getDefaultFontName()));  // can throw
 
-  mGraphicsItem.reset(
-      new StrokeTextGraphicsItem(*mText, mBoard.getLayerStack()));
-  mAnchorGraphicsItem.reset(new LineGraphicsItem());
+  if (!isHeadless()) {
+    mGraphicsItem.reset(
+        new StrokeTextGraphicsItem(*mText, mBoard.getLayerStack()));
+    mAnchorGraphicsItem.reset(new LineGraphicsItem());
+  }
   updateGraphicsItems();
 
   // connect to the "attributes changed" signal of the board
@@ -96,24 +98,33 @@ void BI_StrokeText::setFootprint(BI_Footprint* footprint) noexcept {
 }
 
 void BI_StrokeText::updateGraphicsItems() noexcept {
-  // update z-value
-  Board::ItemZValue zValue = Board::ZValue_Texts;
-  if (GraphicsLayer::isTopLayer(*mText->getLayerName())) {
-    zValue = Board::ZValue_TextsTop;
-  } else if (GraphicsLayer::isBottomLayer(*mText->getLayerName())) {
-    zValue = Board::ZValue_TextsBottom;
+  if (mGraphicsItem && mAnchorGraphicsItem) {
+    // update z-value
+    Board::ItemZValue zValue = Board::ZValue_Texts;
+    if (GraphicsLayer::isTopLayer(*mText->getLayerName())) {
+      zValue = Board::ZValue_TextsTop;
+    } else if (GraphicsLayer::isBottomLayer(*mText->getLayerName())) {
+      zValue = Board::ZValue_TextsBottom;
+    }
+    mGraphicsItem->setZValue(static_cast<qreal>(zValue));
+    mAnchorGraphicsItem->setZValue(static_cast<qreal>(zValue));
   }
-  mGraphicsItem->setZValue(static_cast<qreal>(zValue));
-  mAnchorGraphicsItem->setZValue(static_cast<qreal>(zValue));
-
-  // show anchor line only if there is a footprint and the text is selected
-  if (mFootprint && isSelected()) {
-    mAnchorGraphicsItem->setLine(mText->getPosition(),
-                                 mFootprint->getPosition());
-    mAnchorGraphicsItem->setLayer(
-        mBoard.getLayerStack().getLayer(*mText->getLayerName()));
-  } else {
-    mAnchorGraphicsItem->setLayer(nullptr);
+
+  updateAnchorLine();
+  invalidateGeometry();
+}
+
+void BI_StrokeText::updateAnchorLine() noexcept {
+  if (mAnchorGraphicsItem) {
+    // show anchor line only if there is a footprint and the text is selected
+    if (mFootprint && isSelected()) {
+      mAnchorGraphicsItem->setLine(mText->getPosition(),
+                                   mFootprint->getPosition());
+      mAnchorGraphicsItem->setLayer(
+          mBoard.getLayerStack().getLayer(*mText->getLayerName()));
+    } else {
+      mAnchorGraphicsItem->setLayer(nullptr);
+    }
   }
 }
 
@@ -122,7 +133,9 @@ void BI_StrokeText::addToBoard() {
     throw LogicError(__FILE__, __LINE__);
   }
   BI_Base::addToBoard(mGraphicsItem.data());
-  mBoard.getGraphicsScene().addItem(*mAnchorGraphicsItem);
+  if (mAnchorGraphicsItem) {
+    mBoard.getGraphicsScene().addItem(*mAnchorGraphicsItem);
+  }
 }
 
 void BI_StrokeText::removeFromBoard() {
@@ -130,7 +143,9 @@ void BI_StrokeText::removeFromBoard() {
     throw LogicError(__FILE__, __LINE__);
   }
   BI_Base::removeFromBoard(mGraphicsItem.data());
-  mBoard.getGraphicsScene().removeItem(*mAnchorGraphicsItem);
+  if (mAnchorGraphicsItem) {
+    mBoard.getGraphicsScene().removeItem(*mAnchorGraphicsItem);
+  }
 }
 
 void BI_StrokeText::serialize(SExpression& root) const {
@@ -146,6 +161,9 @@ const Point& BI_StrokeText::getPosition() const noexcept {
 }
 
 QPainterPath BI_StrokeText::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
@@ -156,12 +174,14 @@ const Uuid& BI_StrokeText::getUuid() const noexcept {
 bool BI_StrokeText::isSelectable() const noexcept {
   const GraphicsLayer* layer =
       mBoard.getLayerStack().getLayer(*mText->getLayerName());
-  return layer && layer->isVisible();
+  return mGraphicsItem && layer && layer->isVisible();
 }
 
 void BI_StrokeText::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->setSelected(selected);
+  if (mGraphicsItem) {
+    mGraphicsItem->setSelected(selected);
+  }
   updateGraphicsItems();
 }
 
@@ -78,6 +78,7 @@ public:
   BI_Footprint* getFootprint() const noexcept { return mFootprint; }
   void          setFootprint(BI_Footprint* footprint) noexcept;
   void          updateGraphicsItems() noexcept;
+  void          updateAnchorLine() noexcept;
   void          addToBoard() override;
   void          removeFromBoard() override;
 
@@ -116,6 +117,7 @@ private:  // Methods
   }
   void strokeTextRotationChanged(const Angle& newRot) noexcept override {
     Q_UNUSED(newRot);
+    invalidateGeometry();
   }
   void strokeTextHeightChanged(
       const PositiveLength& newHeight) noexcept override {
@@ -138,12 +140,14 @@ private:  // Methods
   }
   void strokeTextMirroredChanged(bool mirrored) noexcept override {
     Q_UNUSED(mirrored);
+    invalidateGeometry();
   }
   void strokeTextAutoRotateChanged(bool newAutoRotate) noexcept override {
     Q_UNUSED(newAutoRotate);
   }
   void strokeTextPathsChanged(const QVector<Path>& paths) noexcept override {
     Q_UNUSED(paths);
+    invalidateGeometry();
   }
 
 private:  // Data
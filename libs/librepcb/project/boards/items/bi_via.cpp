@@ -74,8 +74,10 @@ BI_Via::BI_Via(BI_NetSegment& netsegment, const Point& position, Shape shape,
 
 void BI_Via::init() {
   // create the graphics item
-  mGraphicsItem.reset(new BGI_Via(*this));
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new BGI_Via(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+  }
 
   // connect to the "attributes changed" signal of the board
   connect(&mBoard, &Board::attributesChanged, this,
@@ -136,7 +138,10 @@ QPainterPath BI_Via::toQPainterPathPx(const Length& expansion) const noexcept {
 void BI_Via::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    if (mGraphicsItem) {
+      mGraphicsItem->setPos(mPosition.toPxQPointF());
+    }
+    invalidateGeometry();
     foreach (BI_NetLine* netline, mRegisteredNetLines) {
       netline->updateLine();
     }
@@ -147,21 +152,30 @@ void BI_Via::setPosition(const Point& position) noexcept {
 void BI_Via::setShape(Shape shape) noexcept {
   if (shape != mShape) {
     mShape = shape;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
+    invalidateGeometry();
   }
 }
 
 void BI_Via::setSize(const PositiveLength& size) noexcept {
   if (size != mSize) {
     mSize = size;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
+    invalidateGeometry();
   }
 }
 
 void BI_Via::setDrillDiameter(const PositiveLength& diameter) noexcept {
   if (diameter != mDrillDiameter) {
     mDrillDiameter = diameter;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
+    invalidateGeometry();
   }
 }
 
@@ -173,9 +187,11 @@ void BI_Via::addToBoard() {
   if (isAddedToBoard() || isUsed()) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mHighlightChangedConnection =
-      connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+  if (mGraphicsItem) {
+    mHighlightChangedConnection =
+        connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
+                [this]() { mGraphicsItem->update(); });
+  }
   BI_Base::addToBoard(mGraphicsItem.data());
   mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
@@ -196,7 +212,9 @@ void BI_Via::registerNetLine(BI_NetLine& netline) {
   }
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void BI_Via::unregisterNetLine(BI_NetLine& netline) {
@@ -205,7 +223,9 @@ void BI_Via::unregisterNetLine(BI_NetLine& netline) {
   }
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void BI_Via::serialize(SExpression& root) const {
@@ -221,16 +241,21 @@ void BI_Via::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath BI_Via::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
 bool BI_Via::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Via::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 /*******************************************************************************
@@ -238,7 +263,9 @@ void BI_Via::setSelected(bool selected) noexcept {
  ******************************************************************************/
 
 void BI_Via::boardAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 /*******************************************************************************
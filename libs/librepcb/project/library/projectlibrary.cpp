@@ -28,11 +28,13 @@
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/profiler.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/dev/device.h>
 #include <librepcb/library/pkg/package.h>
 #include <librepcb/library/sym/symbol.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -59,14 +61,38 @@ ProjectLibrary::ProjectLibrary(const FilePath& libDir, bool restore,
   }
 
   try {
-    // Load all library elements
-    const FilePath& dirToLoad =
+    ProfilerScope profilerScope("library", "Load library elements",
+                                mLibraryPath.toNative());
+
+    const FilePath& dir =
         restore && mBackupPath.isExistingDir() ? mBackupPath : mLibraryPath;
-    loadElements<Symbol>(dirToLoad.getPathTo("sym"), "symbols", mSymbols);
-    loadElements<Package>(dirToLoad.getPathTo("pkg"), "packages", mPackages);
-    loadElements<Component>(dirToLoad.getPathTo("cmp"), "components",
-                            mComponents);
-    loadElements<Device>(dirToLoad.getPathTo("dev"), "devices", mDevices);
+
+    // Load all library elements in parallel since they don't depend on each
+    // other
+    ElementFutures symbols    = loadElements<Symbol>(dir.getPathTo("sym"));
+    ElementFutures packages   = loadElements<Package>(dir.getPathTo("pkg"));
+    ElementFutures components = loadElements<Component>(dir.getPathTo("cmp"));
+    ElementFutures devices    = loadElements<Device>(dir.getPathTo("dev"));
+
+    // Wait until all elements are loaded, even if some of them failed, and
+    // take ownership of all successfully loaded elements to not leak them
+    foreach (QFuture<LibraryBaseElement*> future,
+             symbols + packages + components + devices) {
+      try {
+        mAllElements.insert(future.result());  // can throw
+      } catch (...) {
+        // will be rethrown below
+      }
+    }
+
+    // Register all loaded elements (throws the exception of the first failed
+    // element, if any)
+    addLoadedElements<Symbol>(symbols, "symbols", mSymbols);
+    addLoadedElements<Package>(packages, "packages", mPackages);
+    addLoadedElements<Component>(components, "components", mComponents);
+    addLoadedElements<Device>(devices, "devices", mDevices);
+    Profiler::instance().addCounter("library", "Loaded library elements",
+                                    mAllElements.count());
   } catch (const Exception&) {
     qDeleteAll(mAllElements);
     mAllElements.clear();
@@ -161,6 +187,9 @@ bool ProjectLibrary::save(bool toOriginal, QStringList& errors) noexcept {
     FilePath dir = libDir.getPathTo(element->getShortElementName())
                        .getPathTo(element->getUuid().toStr());
     try {
+      // The element might be added again later (e.g. by undo), so keep its
+      // files if they are located in the directory to remove.
+      detachElement(*element, dir);          // can throw
       FileUtils::removeDirRecursively(dir);  // can throw
       savedElements.remove(element);
     } catch (const Exception& e) {
@@ -179,11 +208,14 @@ bool ProjectLibrary::save(bool toOriginal, QStringList& errors) noexcept {
         element->save();  // can throw
         mLoadedElements.remove(element);
       }
-      if (dir.isExistingDir()) {
-        // Avoid copy failure caused by already existing directory.
-        FileUtils::removeDirRecursively(dir);
-      }
-      FileUtils::copyDirRecursively(element->getFilePath(), dir);  // can throw
+      if (element->getFilePath() != dir) {
+        if (dir.isExistingDir()) {
+          // Avoid copy failure caused by already existing directory.
+          FileUtils::removeDirRecursively(dir);
+        }
+        FileUtils::copyDirRecursively(element->getFilePath(),
+                                      dir);  // can throw
+      }  // else: element was loaded in place, so the files are up to date
       savedElements.insert(element);
     } catch (const Exception& e) {
       success = false;
@@ -208,15 +240,15 @@ QSet<LibraryBaseElement*> ProjectLibrary::getCurrentElements() const noexcept {
 }
 
 template <typename ElementType>
-void ProjectLibrary::loadElements(const FilePath&            directory,
-                                  const QString&             type,
-                                  QHash<Uuid, ElementType*>& elementList) {
+ProjectLibrary::ElementFutures ProjectLibrary::loadElements(
+    const FilePath& directory) {
   QDir dir(directory.toStr());
 
   // search all subdirectories which have a valid UUID as directory name
   dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Readable);
   dir.setNameFilters(QStringList()
                      << QString("*.%1").arg(directory.getBasename()));
+  ElementFutures futures;
   foreach (const QString& dirname, dir.entryList()) {
     FilePath subdirPath(directory.getPathTo(dirname));
 
@@ -233,32 +265,54 @@ void ProjectLibrary::loadElements(const FilePath&            directory,
       continue;
     }
 
-    // Copy element to temporary directory to decouple it from the project
-    // library.
-    FilePath elementDir =
-        mTmpDir.getPathTo(QString::number(qrand())).getPathTo(dirname);
-    FileUtils::copyDirRecursively(subdirPath, elementDir);  // can throw
+    // Load the library element in place in a worker thread. It is copied to
+    // the temporary directory only if its directory is going to be
+    // overwritten or removed, see detachElement().
+    QThread* thread = QThread::currentThread();
+    futures.append(QtConcurrent::run([subdirPath, thread]() {
+      ProfilerScope profilerScope("library", "Load library element",
+                                  subdirPath.getFilename());
+      LibraryBaseElement* element =
+          new ElementType(subdirPath, false);  // can throw
+      // Objects can only be pushed to another thread from their own thread.
+      element->moveToThread(thread);
+      return element;
+    }));
+  }
+  return futures;
+}
 
-    // load the library element
-    QScopedPointer<ElementType> element(
-        new ElementType(elementDir, false));  // can throw
+template <typename ElementType>
+void ProjectLibrary::addLoadedElements(const ElementFutures&      futures,
+                                       const QString&             type,
+                                       QHash<Uuid, ElementType*>& elementList) {
+  foreach (QFuture<LibraryBaseElement*> future, futures) {
+    ElementType* element =
+        static_cast<ElementType*>(future.result());  // can throw
     if (elementList.contains(element->getUuid())) {
       throw RuntimeError(
           __FILE__, __LINE__,
           QString(tr("There are multiple library elements with the same "
                      "UUID in the directory \"%1\""))
-              .arg(subdirPath.toNative()));
+              .arg(element->getFilePath().getParentDir().toNative()));
     }
 
     // everything is ok -> update members
-    elementList.insert(element->getUuid(), element.data());
-    mAllElements.insert(element.data());
-    mLoadedElements.insert(element.take());  // Take object from smart pointer!
+    elementList.insert(element->getUuid(), element);
+    mLoadedElements.insert(element);
   }
 
   qDebug() << "successfully loaded" << elementList.count() << qPrintable(type);
 }
 
+void ProjectLibrary::detachElement(LibraryBaseElement& element,
+                                   const FilePath&     dir) {
+  if (element.getFilePath() == dir) {
+    element.saveIntoParentDirectory(
+        mTmpDir.getPathTo(QString::number(qrand())));  // can throw
+  }
+}
+
 template <typename ElementType>
 void ProjectLibrary::addElement(ElementType&               element,
                                 QHash<Uuid, ElementType*>& elementList) {
@@ -53,6 +53,12 @@ class Project;
 /**
  * @brief The ProjectLibrary class
  *
+ * Library elements are loaded in place, i.e. directly from the project's
+ * library directory (or its backup). An element is copied to a temporary
+ * directory only before its directory gets overwritten or removed while
+ * saving the project (copy-on-write), so opening a project does not need to
+ * copy the whole library.
+ *
  * @todo Adding and removing elements is very provisional. It does not really
  * work together with the automatic backup/restore feature of projects.
  */
@@ -108,6 +114,9 @@ public:
   bool save(bool toOriginal, QStringList& errors) noexcept;
 
 private:
+  // Types
+  typedef QList<QFuture<library::LibraryBaseElement*>> ElementFutures;
+
   // make some methods inaccessible...
   ProjectLibrary();
   ProjectLibrary(const ProjectLibrary& other);
@@ -116,8 +125,13 @@ private:
   // Private Methods
   QSet<library::LibraryBaseElement*> getCurrentElements() const noexcept;
   template <typename ElementType>
-  void loadElements(const FilePath& directory, const QString& type,
-                    QHash<Uuid, ElementType*>& elementList);
+  ElementFutures loadElements(const FilePath& directory);
+  template <typename ElementType>
+  void addLoadedElements(const ElementFutures&      futures,
+                         const QString&             type,
+                         QHash<Uuid, ElementType*>& elementList);
+  void detachElement(library::LibraryBaseElement& element,
+                     const FilePath&              dir);
   template <typename ElementType>
   void addElement(ElementType& element, QHash<Uuid, ElementType*>& elementList);
   template <typename ElementType>
@@ -40,8 +40,10 @@
 #include <librepcb/common/fileio/smarttextfile.h>
 #include <librepcb/common/fileio/smartversionfile.h>
 #include <librepcb/common/font/strokefontpool.h>
+#include <librepcb/common/profiler.h>
 
 #include <QPrinter>
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -50,19 +52,31 @@
 namespace librepcb {
 namespace project {
 
+/*******************************************************************************
+ *  Struct ParsedFile
+ ******************************************************************************/
+
+/// A schematic or board file opened and parsed in a worker thread
+struct Project::ParsedFile {
+  std::unique_ptr<SmartSExprFile> file;
+  SExpression                     root;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 Project::Project(const FilePath& filepath, bool create, bool readOnly,
-                 bool interactive)
+                 bool interactive, bool headless, StrokeFontCache* fontCache)
   : QObject(nullptr),
     AttributeProvider(),
     mPath(filepath.getParentDir()),
     mFilepath(filepath),
     mLock(filepath.getParentDir()),
     mIsRestored(false),
-    mIsReadOnly(readOnly) {
+    mIsReadOnly(readOnly),
+    mIsHeadless(headless) {
+  ProfilerScope profilerScope("project", "Open project", filepath.toNative());
   qDebug() << (create ? "create project:" : "open project:")
            << filepath.toNative();
 
@@ -225,7 +239,7 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly,
         FileUtils::copyFile(fp, fontobeneDir.getPathTo(fp.getFilename()));
       }
     }
-    mStrokeFontPool.reset(new StrokeFontPool(fontobeneDir));
+    mStrokeFontPool.reset(new StrokeFontPool(fontobeneDir, fontCache));
 
     // Create all needed objects
     mProjectMetadata.reset(
@@ -242,36 +256,47 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly,
     // Load all schematic layers
     mSchematicLayerProvider.reset(new SchematicLayerProvider(*this));
 
-    // Load all schematics
+    // Load all schematics and boards
     FilePath schematicsFilepath = mPath.getPathTo("schematics/schematics.lp");
+    FilePath boardsFilepath     = mPath.getPathTo("boards/boards.lp");
     if (create) {
       mSchematicsFile.reset(SmartSExprFile::create(schematicsFilepath));
+      mBoardsFile.reset(SmartSExprFile::create(boardsFilepath));
     } else {
       mSchematicsFile.reset(
           new SmartSExprFile(schematicsFilepath, mIsRestored, mIsReadOnly));
+      mBoardsFile.reset(
+          new SmartSExprFile(boardsFilepath, mIsRestored, mIsReadOnly));
       SExpression schRoot = mSchematicsFile->parseFileAndBuildDomTree();
+      SExpression brdRoot = mBoardsFile->parseFileAndBuildDomTree();
+
+      // Parsing the files is the most expensive part of loading schematics
+      // and boards, and it doesn't depend on anything else. So all files are
+      // parsed in parallel, but the objects are created one after another
+      // since they are wired up with the shared circuit.
+      QList<QFuture<ParsedFilePtr>> schematicFiles;
       foreach (const SExpression& node, schRoot.getChildren("schematic")) {
         FilePath fp =
             FilePath::fromRelative(mPath, node.getValueOfFirstChild<QString>());
-        Schematic* schematic =
-            new Schematic(*this, fp, mIsRestored, mIsReadOnly);
-        addSchematic(*schematic);
+        schematicFiles.append(parseFileInBackground(fp));
       }
-      qDebug() << mSchematics.count() << "schematics successfully loaded!";
-    }
-
-    // Load all boards
-    FilePath boardsFilepath = mPath.getPathTo("boards/boards.lp");
-    if (create) {
-      mBoardsFile.reset(SmartSExprFile::create(boardsFilepath));
-    } else {
-      mBoardsFile.reset(
-          new SmartSExprFile(boardsFilepath, mIsRestored, mIsReadOnly));
-      SExpression brdRoot = mBoardsFile->parseFileAndBuildDomTree();
+      QList<QFuture<ParsedFilePtr>> boardFiles;
       foreach (const SExpression& node, brdRoot.getChildren("board")) {
         FilePath fp =
             FilePath::fromRelative(mPath, node.getValueOfFirstChild<QString>());
-        Board* board = new Board(*this, fp, mIsRestored, mIsReadOnly);
+        boardFiles.append(parseFileInBackground(fp));
+      }
+      foreach (QFuture<ParsedFilePtr> future, schematicFiles) {
+        ParsedFilePtr parsed = future.result();  // can throw
+        Schematic*    schematic =
+            new Schematic(*this, std::move(parsed->file), parsed->root);
+        addSchematic(*schematic);
+      }
+      qDebug() << mSchematics.count() << "schematics successfully loaded!";
+      foreach (QFuture<ParsedFilePtr> future, boardFiles) {
+        ParsedFilePtr parsed = future.result();  // can throw
+        Board*        board =
+            new Board(*this, std::move(parsed->file), parsed->root);
         addBoard(*board);
       }
       qDebug() << mBoards.count() << "boards successfully loaded!";
@@ -448,6 +473,10 @@ void Project::exportSchematicsAsPdf(const FilePath& filepath) {
 }
 
 void Project::printSchematicPages(QPrinter& printer, QList<int>& pages) {
+  if (mIsHeadless) {
+    throw LogicError(__FILE__, __LINE__,
+                     tr("Schematics of a headless project can't be printed."));
+  }
   if (pages.isEmpty())
     throw RuntimeError(__FILE__, __LINE__, tr("No schematic pages selected."));
 
@@ -677,6 +706,7 @@ Version Project::getProjectFileFormatVersion(const FilePath& dir) {
  ******************************************************************************/
 
 bool Project::save(bool toOriginal, QStringList& errors) noexcept {
+  ProfilerScope profilerScope("project", "Save project", mFilepath.toNative());
   bool success = true;
 
   if (mIsReadOnly) {
@@ -770,6 +800,20 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept {
   return success;
 }
 
+QFuture<Project::ParsedFilePtr> Project::parseFileInBackground(
+    const FilePath& filepath) const noexcept {
+  bool restore  = mIsRestored;
+  bool readOnly = mIsReadOnly;
+  return QtConcurrent::run([filepath, restore, readOnly]() {
+    ProfilerScope profilerScope("project", "Parse file", filepath.toNative());
+    ParsedFilePtr parsed = std::make_shared<ParsedFile>();
+    parsed->file.reset(
+        new SmartSExprFile(filepath, restore, readOnly));     // can throw
+    parsed->root = parsed->file->parseFileAndBuildDomTree();  // can throw
+    return parsed;
+  });
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -33,6 +33,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -43,6 +45,7 @@ namespace librepcb {
 class SmartTextFile;
 class SmartSExprFile;
 class SmartVersionFile;
+class StrokeFontCache;
 class StrokeFontPool;
 
 namespace project {
@@ -95,11 +98,16 @@ public:
    * @param filepath      The filepath to the an existing *.lpp project file
    * @param readOnly      It true, the project will be opened in read-only mode
    * @param interactive   If true, message boxes may be shown.
+   * @param headless      If true, no graphics scenes and graphics items are
+   *                      created (see #isHeadless())
+   * @param fontCache     If not nullptr, the stroke fonts are loaded through
+   *                      this cache to share them with other projects
    *
    * @throw Exception     If the project could not be opened successfully
    */
-  Project(const FilePath& filepath, bool readOnly, bool interactve)
-    : Project(filepath, false, readOnly, interactve) {}
+  Project(const FilePath& filepath, bool readOnly, bool interactve,
+          bool headless = false, StrokeFontCache* fontCache = nullptr)
+    : Project(filepath, false, readOnly, interactve, headless, fontCache) {}
 
   /**
    * @brief The destructor will close the whole project (without saving!)
@@ -136,6 +144,20 @@ public:
    */
   bool isRestored() const noexcept { return mIsRestored; }
 
+  /**
+   * @brief Check whether this project was opened without graphics or not
+   *
+   * In headless mode, schematics and boards don't create graphics scenes and
+   * their items don't create graphics items. This saves a lot of time and
+   * memory for command line tools which only need the data and the geometry
+   * of the project. Geometry queries like
+   * librepcb::project::BI_Via::getSceneOutline() still work, but nothing can
+   * be rendered, printed or selected.
+   *
+   * @return See #mIsHeadless
+   */
+  bool isHeadless() const noexcept { return mIsHeadless; }
+
   /**
    * @brief Get the StrokeFontPool which contains all stroke fonts of the
    * project
@@ -278,7 +300,7 @@ public:
    * @param filepath  The filepath where the PDF should be saved. If the file
    * exists already, it will be overwritten.
    *
-   * @throw Exception     On error
+   * @throw Exception     On error (e.g. if the project is opened headless)
    *
    * @todo add more parameters (paper size, orientation, pages to print, ...)
    */
@@ -416,7 +438,7 @@ public:
   // Static Methods
 
   static Project* create(const FilePath& filepath) {
-    return new Project(filepath, true, false, false);
+    return new Project(filepath, true, false, false, false, nullptr);
   }
 
   static bool    isFilePathInsideProjectDirectory(const FilePath& fp) noexcept;
@@ -459,6 +481,10 @@ signals:
   void boardRemoved(int oldIndex);
 
 private:
+  // Types
+  struct ParsedFile;
+  typedef std::shared_ptr<ParsedFile> ParsedFilePtr;
+
   // Private Methods
 
   /**
@@ -469,6 +495,10 @@ private:
    * and must be created.
    * @param readOnly      If true, the project will be opened in read-only mode
    * @param interactive   If true, message boxes may be shown.
+   * @param headless      If true, no graphics scenes and graphics items are
+   *                      created
+   * @param fontCache     If not nullptr, the stroke fonts are loaded through
+   *                      this cache
    *
    * @throw Exception     If the project could not be created/opened
    * successfully
@@ -476,7 +506,7 @@ private:
    * @todo Remove interactive message boxes, should be done at a higher layer!
    */
   explicit Project(const FilePath& filepath, bool create, bool readOnly,
-                   bool interactve);
+                   bool interactve, bool headless, StrokeFontCache* fontCache);
 
   /**
    * @brief Save the project to the harddisc (to temporary or original files)
@@ -491,6 +521,19 @@ private:
    */
   bool save(bool toOriginal, QStringList& errors) noexcept;
 
+  /**
+   * @brief Start opening and parsing a schematic or board file in a worker
+   *        thread
+   *
+   * @param filepath      The file to parse (its backup is parsed if the
+   *                      project is restored)
+   *
+   * @return The future of the opened and parsed file (rethrows errors on
+   *         access)
+   */
+  QFuture<ParsedFilePtr> parseFileInBackground(const FilePath& filepath) const
+      noexcept;
+
   // Project File (*.lpp)
   FilePath mPath;      ///< the path to the project directory
   FilePath mFilepath;  ///< the filepath of the *.lpp project file
@@ -503,6 +546,7 @@ private:
                      ///< was restored
   bool mIsReadOnly;  ///< the constructor will set this to true if the project
                      ///< was opened in read only mode
+  bool mIsHeadless;  ///< if true, no graphics scenes and items are created
 
   // schematic and board list files
   QScopedPointer<SmartSExprFile> mSchematicsFile;  ///< core/schematics.lp
@@ -10,7 +10,7 @@ TARGET = librepcbproject
 # Use common project definitions
 include(../../../common.pri)
 
-QT += core widgets xml sql printsupport
+QT += core widgets xml sql printsupport concurrent
 
 CONFIG += staticlib
 
@@ -25,8 +25,11 @@ SOURCES += \
     boards/boardfabricationoutputsettings.cpp \
     boards/boardgerberexport.cpp \
     boards/boardlayerstack.cpp \
+    boards/boardplanecache.cpp \
     boards/boardplanefragmentsbuilder.cpp \
+    boards/boardplanerebuildscheduler.cpp \
     boards/boardselectionquery.cpp \
+    boards/boardspatialindex.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
     boards/cmd/cmdboarddesignrulesmodify.cpp \
@@ -140,8 +143,11 @@ HEADERS += \
     boards/boardfabricationoutputsettings.h \
     boards/boardgerberexport.h \
     boards/boardlayerstack.h \
+    boards/boardplanecache.h \
     boards/boardplanefragmentsbuilder.h \
+    boards/boardplanerebuildscheduler.h \
     boards/boardselectionquery.h \
+    boards/boardspatialindex.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
     boards/cmd/cmdboarddesignrulesmodify.h \
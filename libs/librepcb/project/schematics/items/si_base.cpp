@@ -63,6 +63,10 @@ Circuit& SI_Base::getCircuit() const noexcept {
   return mSchematic.getProject().getCircuit();
 }
 
+bool SI_Base::isHeadless() const noexcept {
+  return mSchematic.getProject().isHeadless();
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
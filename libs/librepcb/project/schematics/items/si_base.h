@@ -92,6 +92,9 @@ public:
   SI_Base& operator=(const SI_Base& rhs) = delete;
 
 protected:
+  // Getters
+  bool isHeadless() const noexcept;
+
   // General Methods
   void addToSchematic(SGI_Base* item) noexcept;
   void removeFromSchematic(SGI_Base* item) noexcept;
@@ -64,9 +64,11 @@ SI_NetLabel::SI_NetLabel(SI_NetSegment& segment, const Point& position,
 
 void SI_NetLabel::init() {
   // create the graphics item
-  mGraphicsItem.reset(new SGI_NetLabel(*this));
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
-  mGraphicsItem->setRotation(-mRotation.toDeg());
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new SGI_NetLabel(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    mGraphicsItem->setRotation(-mRotation.toDeg());
+  }
 }
 
 SI_NetLabel::~SI_NetLabel() noexcept {
@@ -88,7 +90,9 @@ NetSignal& SI_NetLabel::getNetSignalOfNetSegment() const noexcept {
 void SI_NetLabel::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    if (mGraphicsItem) {
+      mGraphicsItem->setPos(mPosition.toPxQPointF());
+    }
     updateAnchor();
   }
 }
@@ -96,8 +100,10 @@ void SI_NetLabel::setPosition(const Point& position) noexcept {
 void SI_NetLabel::setRotation(const Angle& rotation) noexcept {
   if (rotation != mRotation) {
     mRotation = rotation;
-    mGraphicsItem->setRotation(-mRotation.toDeg());
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->setRotation(-mRotation.toDeg());
+      mGraphicsItem->updateCacheAndRepaint();
+    }
     updateAnchor();
   }
 }
@@ -107,21 +113,27 @@ void SI_NetLabel::setRotation(const Angle& rotation) noexcept {
  ******************************************************************************/
 
 void SI_NetLabel::updateAnchor() noexcept {
-  mGraphicsItem->setAnchor(mNetSegment.calcNearestPoint(mPosition));
+  if (mGraphicsItem) {
+    mGraphicsItem->setAnchor(mNetSegment.calcNearestPoint(mPosition));
+  }
 }
 
 void SI_NetLabel::addToSchematic() {
   if (isAddedToSchematic()) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mNameChangedConnection =
-      connect(&getNetSignalOfNetSegment(), &NetSignal::nameChanged,
-              [this]() { mGraphicsItem->updateCacheAndRepaint(); });
-  mHighlightChangedConnection =
-      connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+  if (mGraphicsItem) {
+    mNameChangedConnection =
+        connect(&getNetSignalOfNetSegment(), &NetSignal::nameChanged,
+                [this]() { mGraphicsItem->updateCacheAndRepaint(); });
+    mHighlightChangedConnection =
+        connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
+                [this]() { mGraphicsItem->update(); });
+  }
   SI_Base::addToSchematic(mGraphicsItem.data());
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
   updateAnchor();
 }
 
@@ -145,12 +157,17 @@ void SI_NetLabel::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath SI_NetLabel::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
 void SI_NetLabel::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 /*******************************************************************************
@@ -81,7 +81,9 @@ void SI_NetLine::init() {
                      tr("SI_NetLine: both endpoints are the same."));
   }
 
-  mGraphicsItem.reset(new SGI_NetLine(*this));
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new SGI_NetLine(*this));
+  }
   updateLine();
 }
 
@@ -115,7 +117,9 @@ NetSignal& SI_NetLine::getNetSignalOfNetSegment() const noexcept {
 void SI_NetLine::setWidth(const UnsignedLength& width) noexcept {
   if (width != mWidth) {
     mWidth = width;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
   }
 }
 
@@ -132,9 +136,11 @@ void SI_NetLine::addToSchematic() {
   auto sg = scopeGuard([&]() { mStartPoint->unregisterNetLine(*this); });
   mEndPoint->registerNetLine(*this);  // can throw
 
-  mHighlightChangedConnection =
-      connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+  if (mGraphicsItem) {
+    mHighlightChangedConnection =
+        connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
+                [this]() { mGraphicsItem->update(); });
+  }
   SI_Base::addToSchematic(mGraphicsItem.data());
   sg.dismiss();
 }
@@ -155,7 +161,9 @@ void SI_NetLine::removeFromSchematic() {
 
 void SI_NetLine::updateLine() noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void SI_NetLine::serialize(SExpression& root) const {
@@ -198,12 +206,14 @@ void SI_NetLine::serializeAnchor(SExpression&      root,
  ******************************************************************************/
 
 QPainterPath SI_NetLine::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->shape();
+  return mGraphicsItem ? mGraphicsItem->shape() : QPainterPath();
 }
 
 void SI_NetLine::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 /*******************************************************************************
@@ -56,8 +56,10 @@ SI_NetPoint::SI_NetPoint(SI_NetSegment& segment, const Point& position)
 
 void SI_NetPoint::init() {
   // create the graphics item
-  mGraphicsItem.reset(new SGI_NetPoint(*this));
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new SGI_NetPoint(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+  }
 
   // create ERC messages
   mErcMsgDeadNetPoint.reset(
@@ -95,7 +97,9 @@ NetSignal& SI_NetPoint::getNetSignalOfNetSegment() const noexcept {
 void SI_NetPoint::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
     mPosition = position;
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    if (mGraphicsItem) {
+      mGraphicsItem->setPos(mPosition.toPxQPointF());
+    }
     foreach (SI_NetLine* line, mRegisteredNetLines) { line->updateLine(); }
   }
 }
@@ -108,9 +112,11 @@ void SI_NetPoint::addToSchematic() {
   if (isAddedToSchematic() || isUsed()) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mHighlightChangedConnection =
-      connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+  if (mGraphicsItem) {
+    mHighlightChangedConnection =
+        connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
+                [this]() { mGraphicsItem->update(); });
+  }
   mErcMsgDeadNetPoint->setVisible(true);
   SI_Base::addToSchematic(mGraphicsItem.data());
 }
@@ -131,7 +137,9 @@ void SI_NetPoint::registerNetLine(SI_NetLine& netline) {
   }
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -141,7 +149,9 @@ void SI_NetPoint::unregisterNetLine(SI_NetLine& netline) {
   }
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -155,12 +165,17 @@ void SI_NetPoint::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath SI_NetPoint::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
 void SI_NetPoint::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 /*******************************************************************************
@@ -51,7 +51,8 @@ namespace project {
 SI_NetSegment::SI_NetSegment(Schematic& schematic, const SExpression& node)
   : SI_Base(schematic),
     mUuid(node.getChildByIndex(0).getValue<Uuid>()),
-    mNetSignal(nullptr) {
+    mNetSignal(nullptr),
+    mConnectivityValid(false) {
   try {
     Uuid netSignalUuid = node.getValueByPath<Uuid>("net");
     mNetSignal =
@@ -63,40 +64,46 @@ SI_NetSegment::SI_NetSegment(Schematic& schematic, const SExpression& node)
     }
 
     // Load all netpoints
+    QSet<Uuid> netPointUuids;
     foreach (const SExpression& child, node.getChildren("junction")) {
       SI_NetPoint* netpoint = new SI_NetPoint(*this, child);
-      if (getNetPointByUuid(netpoint->getUuid())) {
+      if (netPointUuids.contains(netpoint->getUuid())) {
         throw RuntimeError(
             __FILE__, __LINE__,
             QString(tr("There is already a netpoint with the UUID \"%1\"!"))
                 .arg(netpoint->getUuid().toStr()));
       }
+      netPointUuids.insert(netpoint->getUuid());
       mNetPoints.append(netpoint);
     }
 
     // Load all netlines
+    QSet<Uuid> netLineUuids;
     foreach (const SExpression& child,
              node.getChildren("netline") + node.getChildren("line")) {
       SI_NetLine* netline = new SI_NetLine(*this, child);
-      if (getNetLineByUuid(netline->getUuid())) {
+      if (netLineUuids.contains(netline->getUuid())) {
         throw RuntimeError(
             __FILE__, __LINE__,
             QString(tr("There is already a netline with the UUID \"%1\"!"))
                 .arg(netline->getUuid().toStr()));
       }
+      netLineUuids.insert(netline->getUuid());
       mNetLines.append(netline);
     }
 
     // Load all netlabels
+    QSet<Uuid> netLabelUuids;
     foreach (const SExpression& child,
              node.getChildren("netlabel") + node.getChildren("label")) {
       SI_NetLabel* netlabel = new SI_NetLabel(*this, child);
-      if (getNetLabelByUuid(netlabel->getUuid())) {
+      if (netLabelUuids.contains(netlabel->getUuid())) {
         throw RuntimeError(
             __FILE__, __LINE__,
             QString(tr("There is already a netlabel with the UUID \"%1\"!"))
                 .arg(netlabel->getUuid().toStr()));
       }
+      netLabelUuids.insert(netlabel->getUuid());
       mNetLabels.append(netlabel);
     }
 
@@ -121,7 +128,10 @@ SI_NetSegment::SI_NetSegment(Schematic& schematic, const SExpression& node)
 }
 
 SI_NetSegment::SI_NetSegment(Schematic& schematic, NetSignal& signal)
-  : SI_Base(schematic), mUuid(Uuid::createRandom()), mNetSignal(&signal) {
+  : SI_Base(schematic),
+    mUuid(Uuid::createRandom()),
+    mNetSignal(&signal),
+    mConnectivityValid(false) {
 }
 
 SI_NetSegment::~SI_NetSegment() noexcept {
@@ -296,14 +306,27 @@ void SI_NetSegment::addNetPointsAndNetLines(
     throw LogicError(__FILE__, __LINE__);
   }
 
-  ScopeGuardList sgl(netpoints.count() + netlines.count());
+  // collect the UUIDs of all existing items only once to avoid quadratic
+  // runtime when adding many items at once
+  QSet<Uuid> netPointUuids, netLineUuids;
+  foreach (const SI_NetPoint* netpoint, mNetPoints) {
+    netPointUuids.insert(netpoint->getUuid());
+  }
+  foreach (const SI_NetLine* netline, mNetLines) {
+    netLineUuids.insert(netline->getUuid());
+  }
+
+  ScopeGuardList sgl(netpoints.count() + netlines.count() + 1);
+  sgl.add([this]() { mConnectivityValid = false; });
   foreach (SI_NetPoint* netpoint, netpoints) {
-    if ((mNetPoints.contains(netpoint)) ||
-        (&netpoint->getNetSegment() != this)) {
+    if (&netpoint->getNetSegment() != this) {
       throw LogicError(__FILE__, __LINE__);
     }
     // check if there is no netpoint with the same uuid in the list
-    if (getNetPointByUuid(netpoint->getUuid())) {
+    if (netPointUuids.contains(netpoint->getUuid())) {
+      if (mNetPoints.contains(netpoint)) {
+        throw LogicError(__FILE__, __LINE__);
+      }
       throw RuntimeError(
           __FILE__, __LINE__,
           QString(tr("There is already a netpoint with the UUID \"%1\"!"))
@@ -311,6 +334,7 @@ void SI_NetSegment::addNetPointsAndNetLines(
     }
     // add to schematic
     netpoint->addToSchematic();  // can throw
+    netPointUuids.insert(netpoint->getUuid());
     mNetPoints.append(netpoint);
     sgl.add([this, netpoint]() {
       netpoint->removeFromSchematic();
@@ -318,11 +342,14 @@ void SI_NetSegment::addNetPointsAndNetLines(
     });
   }
   foreach (SI_NetLine* netline, netlines) {
-    if ((mNetLines.contains(netline)) || (&netline->getNetSegment() != this)) {
+    if (&netline->getNetSegment() != this) {
       throw LogicError(__FILE__, __LINE__);
     }
     // check if there is no netline with the same uuid in the list
-    if (getNetLineByUuid(netline->getUuid())) {
+    if (netLineUuids.contains(netline->getUuid())) {
+      if (mNetLines.contains(netline)) {
+        throw LogicError(__FILE__, __LINE__);
+      }
       throw RuntimeError(
           __FILE__, __LINE__,
           QString(tr("There is already a netline with the UUID \"%1\"!"))
@@ -330,11 +357,17 @@ void SI_NetSegment::addNetPointsAndNetLines(
     }
     // add to schematic
     netline->addToSchematic();  // can throw
+    netLineUuids.insert(netline->getUuid());
     mNetLines.append(netline);
     sgl.add([this, netline]() {
       netline->removeFromSchematic();
       mNetLines.removeOne(netline);
     });
+    if (mConnectivityValid) {
+      // new netlines can only merge groups of anchors, so the connectivity
+      // can be updated incrementally
+      mConnectivity.unite(&netline->getStartPoint(), &netline->getEndPoint());
+    }
   }
 
   if (!areAllNetPointsConnectedTogether()) {
@@ -355,6 +388,10 @@ void SI_NetSegment::removeNetPointsAndNetLines(
     throw LogicError(__FILE__, __LINE__);
   }
 
+  // removing netlines may split groups of anchors, thus the connectivity
+  // needs to be rebuilt from scratch
+  mConnectivityValid = false;
+
   ScopeGuardList sgl(netpoints.count() + netlines.count());
   foreach (SI_NetLine* netline, netlines) {
     if (!mNetLines.contains(netline)) {
@@ -550,45 +587,26 @@ bool SI_NetSegment::checkAttributesValidity() const noexcept {
 
 bool SI_NetSegment::areAllNetPointsConnectedTogether() const noexcept {
   if (mNetPoints.count() > 1) {
-    const SI_NetPoint*        firstPoint = mNetPoints.first();
-    QSet<const SI_SymbolPin*> pins;
-    QSet<const SI_NetPoint*>  points;
-    findAllConnectedNetPoints(*firstPoint, pins, points);
-    return (points.count() == mNetPoints.count());
+    const SI_NetLineAnchor* firstPoint = mNetPoints.first();
+    if (!mConnectivityValid) {
+      rebuildConnectivity();
+    }
+    foreach (const SI_NetPoint* netpoint, mNetPoints) {
+      if (!mConnectivity.isConnected(firstPoint, netpoint)) return false;
+    }
+    return true;
   } else {
     return true;  // there is only 0 or 1 netpoint => must be "connected
                   // together" :)
   }
 }
 
-void SI_NetSegment::findAllConnectedNetPoints(
-    const SI_NetLineAnchor& p, QSet<const SI_SymbolPin*>& pins,
-    QSet<const SI_NetPoint*>& points) const noexcept {
-  if (const SI_SymbolPin* pin = dynamic_cast<const SI_SymbolPin*>(&p)) {
-    if (pins.contains(pin)) return;
-    pins.insert(pin);
-    foreach (const SI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == pin) {
-        findAllConnectedNetPoints(netline->getEndPoint(), pins, points);
-      }
-      if (&netline->getEndPoint() == pin) {
-        findAllConnectedNetPoints(netline->getStartPoint(), pins, points);
-      }
-    }
-  } else if (const SI_NetPoint* np = dynamic_cast<const SI_NetPoint*>(&p)) {
-    if (points.contains(np)) return;
-    points.insert(np);
-    foreach (const SI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == np) {
-        findAllConnectedNetPoints(netline->getEndPoint(), pins, points);
-      }
-      if (&netline->getEndPoint() == np) {
-        findAllConnectedNetPoints(netline->getStartPoint(), pins, points);
-      }
-    }
-  } else {
-    Q_ASSERT(false);
+void SI_NetSegment::rebuildConnectivity() const noexcept {
+  mConnectivity.clear();
+  foreach (const SI_NetLine* netline, mNetLines) {
+    mConnectivity.unite(&netline->getStartPoint(), &netline->getEndPoint());
   }
+  mConnectivityValid = true;
 }
 
 /*******************************************************************************
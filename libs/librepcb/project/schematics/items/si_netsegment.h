@@ -26,6 +26,7 @@
 #include "si_base.h"
 
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/utils/unionfind.h>
 #include <librepcb/common/uuid.h>
 
 #include <QtCore>
@@ -135,10 +136,7 @@ public:
 private:
   bool checkAttributesValidity() const noexcept;
   bool areAllNetPointsConnectedTogether() const noexcept;
-  void findAllConnectedNetPoints(const SI_NetLineAnchor&    p,
-                                 QSet<const SI_SymbolPin*>& pins,
-                                 QSet<const SI_NetPoint*>&  points) const
-      noexcept;
+  void rebuildConnectivity() const noexcept;
 
   // Attributes
   Uuid       mUuid;
@@ -148,6 +146,15 @@ private:
   QList<SI_NetPoint*> mNetPoints;
   QList<SI_NetLine*>  mNetLines;
   QList<SI_NetLabel*> mNetLabels;
+
+  /**
+   * @brief Connectivity of all anchors (netpoints and symbol pins)
+   *
+   * Updated incrementally when adding netlines. Removing netlines invalidates
+   * it, then it is rebuilt by the next cohesion check.
+   */
+  mutable UnionFind<const SI_NetLineAnchor*> mConnectivity;
+  mutable bool                               mConnectivityValid;
 };
 
 /*******************************************************************************
@@ -96,8 +96,10 @@ void SI_Symbol::init(const Uuid& symbVarItemUuid) {
                            .arg(mSymbVarItem->getSymbolUuid().toStr()));
   }
 
-  mGraphicsItem.reset(new SGI_Symbol(*this));
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new SGI_Symbol(*this));
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+  }
   updateGraphicsItemTransform();
 
   for (const library::SymbolPin& libPin : mSymbol->getPins()) {
@@ -151,8 +153,10 @@ QString SI_Symbol::getName() const noexcept {
 void SI_Symbol::setPosition(const Point& newPos) noexcept {
   if (newPos != mPosition) {
     mPosition = newPos;
-    mGraphicsItem->setPos(newPos.toPxQPointF());
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->setPos(newPos.toPxQPointF());
+      mGraphicsItem->updateCacheAndRepaint();
+    }
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
   }
 }
@@ -161,7 +165,9 @@ void SI_Symbol::setRotation(const Angle& newRotation) noexcept {
   if (newRotation != mRotation) {
     mRotation = newRotation;
     updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
   }
 }
@@ -170,7 +176,9 @@ void SI_Symbol::setMirrored(bool newMirrored) noexcept {
   if (newMirrored != mMirrored) {
     mMirrored = newMirrored;
     updateGraphicsItemTransform();
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
   }
 }
@@ -256,12 +264,17 @@ QVector<const AttributeProvider*> SI_Symbol::getAttributeProviderParents() const
  ******************************************************************************/
 
 QPainterPath SI_Symbol::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
 void SI_Symbol::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
   foreach (SI_SymbolPin* pin, mPins) { pin->setSelected(selected); }
 }
 
@@ -270,7 +283,9 @@ void SI_Symbol::setSelected(bool selected) noexcept {
  ******************************************************************************/
 
 void SI_Symbol::schematicOrComponentAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 /*******************************************************************************
@@ -281,7 +296,9 @@ void SI_Symbol::updateGraphicsItemTransform() noexcept {
   QTransform t;
   if (mMirrored) t.scale(qreal(-1), qreal(1));
   t.rotate(-mRotation.toDeg());
-  mGraphicsItem->setTransform(t);
+  if (mGraphicsItem) {
+    mGraphicsItem->setTransform(t);
+  }
 }
 
 bool SI_Symbol::checkAttributesValidity() const noexcept {
@@ -62,7 +62,9 @@ SI_SymbolPin::SI_SymbolPin(SI_Symbol& symbol, const Uuid& pinUuid)
     mComponentSignalInstance =
         mSymbol.getComponentInstance().getSignalInstance(*cmpSignalUuid);
 
-  mGraphicsItem.reset(new SGI_SymbolPin(*this));
+  if (!isHeadless()) {
+    mGraphicsItem.reset(new SGI_SymbolPin(*this));
+  }
   updatePosition();
 
   // create ERC messages
@@ -151,14 +153,16 @@ void SI_SymbolPin::addToSchematic() {
   if (mComponentSignalInstance) {
     mComponentSignalInstance->registerSymbolPin(*this);  // can throw
   }
-  if (getCompSigInstNetSignal()) {
+  if (getCompSigInstNetSignal() && mGraphicsItem) {
     mHighlightChangedConnection =
         connect(getCompSigInstNetSignal(), &NetSignal::highlightedChanged,
                 [this]() { mGraphicsItem->update(); });
   }
   SI_Base::addToSchematic(mGraphicsItem.data());
   updateErcMessages();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void SI_SymbolPin::removeFromSchematic() {
@@ -189,8 +193,10 @@ void SI_SymbolPin::registerNetLine(SI_NetLine& netline) {
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
   updateErcMessages();
-  mGraphicsItem
-      ->updateCacheAndRepaint();  // re-check whether to fill the circle or not
+  if (mGraphicsItem) {
+    // re-check whether to fill the circle or not
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void SI_SymbolPin::unregisterNetLine(SI_NetLine& netline) {
@@ -200,16 +206,22 @@ void SI_SymbolPin::unregisterNetLine(SI_NetLine& netline) {
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
   updateErcMessages();
-  mGraphicsItem
-      ->updateCacheAndRepaint();  // re-check whether to fill the circle or not
+  if (mGraphicsItem) {
+    // re-check whether to fill the circle or not
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void SI_SymbolPin::updatePosition() noexcept {
   mPosition = mSymbol.mapToScene(mSymbolPin->getPosition());
   mRotation = mSymbol.getRotation() + mSymbolPin->getRotation();
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  if (mGraphicsItem) {
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+  }
   updateGraphicsItemTransform();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
   foreach (SI_NetLine* netline, mRegisteredNetLines) { netline->updateLine(); }
 }
 
@@ -218,12 +230,17 @@ void SI_SymbolPin::updatePosition() noexcept {
  ******************************************************************************/
 
 QPainterPath SI_SymbolPin::getGrabAreaScenePx() const noexcept {
+  if (!mGraphicsItem) {
+    return QPainterPath();  // headless mode
+  }
   return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
 void SI_SymbolPin::setSelected(bool selected) noexcept {
   SI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
 }
 
 /*******************************************************************************
@@ -248,7 +265,9 @@ void SI_SymbolPin::updateGraphicsItemTransform() noexcept {
   QTransform t;
   if (mSymbol.getMirrored()) t.scale(qreal(-1), qreal(1));
   t.rotate(-mRotation.toDeg());
-  mGraphicsItem->setTransform(t);
+  if (mGraphicsItem) {
+    mGraphicsItem->setTransform(t);
+  }
 }
 
 /*******************************************************************************
@@ -37,6 +37,7 @@
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/gridproperties.h>
+#include <librepcb/common/profiler.h>
 #include <librepcb/common/scopeguardlist.h>
 #include <librepcb/library/sym/symbolpin.h>
 
@@ -52,17 +53,30 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
+Schematic::Schematic(Project& project, std::unique_ptr<SmartSExprFile> file,
+                     const SExpression& root)
+  : Schematic(project, file->getFilepath(), file->isRestored(),
+              file->isReadOnly(), false, QString(), &file, &root) {
+}
+
 Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
-                     bool readOnly, bool create, const QString& newName)
+                     bool readOnly, bool create, const QString& newName,
+                     std::unique_ptr<SmartSExprFile>* file,
+                     const SExpression* dom)
   : QObject(&project),
     AttributeProvider(),
     mProject(project),
     mFilePath(filepath),
+    mFile(file ? file->release() : nullptr),
     mIsAddedToProject(false),
     mUuid(Uuid::createRandom()),
     mName("New Page") {
+  ProfilerScope profilerScope("schematic", "Load schematic",
+                              filepath.toNative());
   try {
-    mGraphicsScene.reset(new GraphicsScene());
+    if (!mProject.isHeadless()) {
+      mGraphicsScene.reset(new GraphicsScene());
+    }
 
     // try to open/create the schematic file
     if (create) {
@@ -74,8 +88,12 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
       // load default grid properties
       mGridProperties.reset(new GridProperties());
     } else {
-      mFile.reset(new SmartSExprFile(mFilePath, restore, readOnly));
-      SExpression root = mFile->parseFileAndBuildDomTree();
+      if (!mFile) {
+        mFile.reset(new SmartSExprFile(mFilePath, restore, readOnly));
+      }
+      SExpression parsedRoot =
+          dom ? SExpression() : mFile->parseFileAndBuildDomTree();
+      const SExpression& root = dom ? *dom : parsedRoot;
 
       // the schematic seems to be ready to open, so we will create all needed
       // objects
@@ -370,12 +388,15 @@ bool Schematic::save(bool toOriginal, QStringList& errors) noexcept {
 }
 
 void Schematic::showInView(GraphicsView& view) noexcept {
+  Q_ASSERT(mGraphicsScene);  // not available in headless mode
   view.setScene(mGraphicsScene.data());
 }
 
 void Schematic::setSelectionRect(const Point& p1, const Point& p2,
                                  bool updateItems) noexcept {
-  mGraphicsScene->setSelectionRect(p1, p2);
+  if (mGraphicsScene) {
+    mGraphicsScene->setSelectionRect(p1, p2);
+  }
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
     foreach (SI_Symbol* symbol, mSymbols) {
@@ -404,6 +425,7 @@ void Schematic::updateAllNetLabelAnchors() noexcept {
 }
 
 void Schematic::renderToQPainter(QPainter& painter) const noexcept {
+  Q_ASSERT(mGraphicsScene);  // not available in headless mode
   mGraphicsScene->render(&painter, QRectF(),
                          mGraphicsScene->itemsBoundingRect(),
                          Qt::KeepAspectRatio);
@@ -439,6 +461,9 @@ QVector<const AttributeProvider*> Schematic::getAttributeProviderParents() const
  ******************************************************************************/
 
 void Schematic::updateIcon() noexcept {
+  if (!mGraphicsScene) {
+    return;  // headless mode, nothing to render
+  }
   QRectF source =
       mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
   QRect target(0, 0, 297, 210);  // DIN A4 format :-)
@@ -467,7 +492,8 @@ void Schematic::serialize(SExpression& root) const {
 
 Schematic* Schematic::create(Project& project, const FilePath& filepath,
                              const ElementName& name) {
-  return new Schematic(project, filepath, false, false, true, *name);
+  return new Schematic(project, filepath, false, false, true, *name, nullptr,
+                       nullptr);
 }
 
 /*******************************************************************************
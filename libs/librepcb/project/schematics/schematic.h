@@ -113,7 +113,21 @@ public:
   Schematic(const Schematic& other) = delete;
   Schematic(Project& project, const FilePath& filepath, bool restore,
             bool readOnly)
-    : Schematic(project, filepath, restore, readOnly, false, QString()) {}
+    : Schematic(project, filepath, restore, readOnly, false, QString(),
+                nullptr, nullptr) {}
+
+  /**
+   * @brief Load a schematic from an already opened and parsed file
+   *
+   * Allows to parse the files of several schematics in parallel.
+   *
+   * @param project   The project the schematic belongs to
+   * @param file      The opened schematic file
+   * @param root      The parsed content of the file (must be kept alive
+   *                  until the constructor returns, it is not copied)
+   */
+  Schematic(Project& project, std::unique_ptr<SmartSExprFile> file,
+            const SExpression& root);
   ~Schematic() noexcept;
 
   // Getters: General
@@ -187,7 +201,8 @@ signals:
 
 private:
   Schematic(Project& project, const FilePath& filepath, bool restore,
-            bool readOnly, bool create, const QString& newName);
+            bool readOnly, bool create, const QString& newName,
+            std::unique_ptr<SmartSExprFile>* file, const SExpression* dom);
   void updateIcon() noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
@@ -74,6 +74,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
     mProject(project),
     mUi(new Ui::BoardEditor),
     mGraphicsView(nullptr),
+    mPlanesOutdatedLabel(nullptr),
     mActiveBoardIndex(-1),
     mBoardListActionGroup(this),
     mErcMsgDock(nullptr),
@@ -231,6 +232,11 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
           &StatusBar::setProgressBarPercent, Qt::QueuedConnection);
   connect(mGraphicsView, &GraphicsView::cursorScenePositionChanged,
           mUi->statusbar, &StatusBar::setAbsoluteCursorPosition);
+  mPlanesOutdatedLabel = new QLabel(tr("Planes are out of date, rebuilding..."),
+                                    mUi->statusbar);
+  mPlanesOutdatedLabel->setStyleSheet("QLabel {color: rgb(170, 0, 0);}");
+  mPlanesOutdatedLabel->hide();
+  mUi->statusbar->addPermanentWidget(mPlanesOutdatedLabel);
 
   // Restore Window Geometry
   QSettings clientSettings;
@@ -293,6 +299,10 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept {
     // reasons)
     disconnect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified, board,
                &Board::triggerAirWiresRebuild);
+    disconnect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified, board,
+               &Board::startDirtyPlanesRebuild);
+    disconnect(board, &Board::planesOutdatedChanged, mPlanesOutdatedLabel,
+               &QLabel::setVisible);
     // save current view scene rect
     board->saveViewSceneRect(mGraphicsView->getVisibleSceneRect());
     // uncheck QAction
@@ -310,12 +320,20 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept {
     board->triggerAirWiresRebuild();
     connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified, board,
             &Board::triggerAirWiresRebuild);
+    // rebuild modified planes in background on every project modification
+    board->startDirtyPlanesRebuild();
+    connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified, board,
+            &Board::startDirtyPlanesRebuild);
+    mPlanesOutdatedLabel->setVisible(board->arePlanesOutdated());
+    connect(board, &Board::planesOutdatedChanged, mPlanesOutdatedLabel,
+            &QLabel::setVisible);
     // check QAction
     QAction* action = mBoardListActions.value(index);
     Q_ASSERT(action);
     if (action) action->setChecked(true);
   } else {
     mGraphicsView->setScene(nullptr);
+    mPlanesOutdatedLabel->hide();
   }
 
   // active board has changed!
@@ -536,7 +554,7 @@ void BoardEditor::on_actionModifyDesignRules_triggered() {
 void BoardEditor::on_actionRebuildPlanes_triggered() {
   Board* board = getActiveBoard();
   if (board) {
-    board->rebuildAllPlanes();
+    board->startAllPlanesRebuild();
     board->forceAirWiresRebuild();
   }
 }
@@ -132,6 +132,7 @@ private:
   Project&                             mProject;
   Ui::BoardEditor*                     mUi;
   GraphicsView*                        mGraphicsView;
+  QLabel*                              mPlanesOutdatedLabel;
   QScopedPointer<UndoStackActionGroup> mUndoStackActionGroup;
   QScopedPointer<ExclusiveActionGroup> mToolsActionGroup;
 
@@ -146,9 +146,11 @@ void CmdMoveSelectedBoardItems::setCurrentPosition(const Point& pos) noexcept {
     }
     mDeltaPos = delta;
 
-    // Force updating airwires immediately as they are important while moving
-    // items.
-    mBoard.triggerAirWiresRebuild();
+    // Airwires are important while moving items, but rebuilding them on
+    // every mouse move event would be too slow for large footprints, so they
+    // are updated with a limited rate. Planes are not rebuilt until the move
+    // command is executed.
+    mBoard.triggerAirWiresRebuildDeferred();
   }
 }
 
@@ -254,11 +254,11 @@ void AddComponentDialog::searchComponents(const QString& input) {
   setSelectedComponent(nullptr);
   mUi->treeComponents->clear();
 
-  if (input.length() >
-      1) {  // avoid freeze on entering first character due to huge result
+  if (!input.isEmpty()) {
+    // limit the number of results to keep typing responsive
     const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
-    QSet<Uuid>         components =
-        mWorkspace.getLibraryDb().getComponentsBySearchKeyword(input);
+    QList<Uuid>        components =
+        mWorkspace.getLibraryDb().searchComponents(input, 100);
     foreach (const Uuid& cmpUuid, components) {
       // component
       FilePath cmpFp = mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);
@@ -302,8 +302,7 @@ void AddComponentDialog::searchComponents(const QString& input) {
       cmpItem->setTextAlignment(1, Qt::AlignRight);
     }
   }
-
-  mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
+  // Note: Not sorted by name since the results are sorted by relevance.
 }
 
 void AddComponentDialog::setSelectedCategory(
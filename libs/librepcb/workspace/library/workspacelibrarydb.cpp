@@ -52,7 +52,7 @@ using namespace library;
  ******************************************************************************/
 
 WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
-  : QObject(nullptr), mWorkspace(ws) {
+  : QObject(nullptr), mWorkspace(ws), mHasFullTextIndex(false) {
   qDebug("Load workspace library database...");
 
   // open SQLite database
@@ -66,12 +66,22 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
   int dbVersion = getDbVersion();
   if (dbVersion != sCurrentDbVersion) {
     qCritical() << "Library database version" << dbVersion << "is wrong!";
+  } else if (hasFullTextIndex() && (!mDb->isFts5Available())) {
+    // the triggers to update the full-text index would fail on every insert
+    qCritical() << "Library database requires SQLite FTS5, recreating it.";
+    dbVersion = -1;
+  }
+  if (dbVersion != sCurrentDbVersion) {
     mDb.reset();
     QFile(mFilePath.toStr()).remove();
     mDb.reset(new SQLiteDatabase(mFilePath));  // can throw
     createAllTables();                         // can throw
     setDbVersion(sCurrentDbVersion);           // can throw
   }
+  mHasFullTextIndex = hasFullTextIndex();  // can throw
+  if (!mHasFullTextIndex) {
+    qWarning() << "SQLite FTS5 not available, library search will be slow.";
+  }
 
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mWorkspace, mFilePath));
@@ -434,28 +444,62 @@ QSet<Uuid> WorkspaceLibraryDb::getDevicesOfComponent(
   return elements;
 }
 
-QSet<Uuid> WorkspaceLibraryDb::getComponentsBySearchKeyword(
-    const QString& keyword) const {
+/*******************************************************************************
+ *  Getters: Search
+ ******************************************************************************/
+
+QList<Uuid> WorkspaceLibraryDb::searchComponents(const QString& keywords,
+                                                 int            limit) const {
+  QStringList terms =
+      keywords.split(QRegularExpression("\\W+"), QString::SkipEmptyParts);
+  if (terms.isEmpty()) {
+    return QList<Uuid>();
+  } else if (!mHasFullTextIndex) {
+    return searchComponentsWithoutIndex(terms, limit);  // can throw
+  }
+
+  // Rank by BM25 with the weights 10 for names, 1 for descriptions and 5 for
+  // keywords. Matches in devices are ranked lower than matches in their
+  // component (note that BM25 returns negative values, lower is better).
   QSqlQuery query = mDb->prepareQuery(
-      "SELECT components.uuid FROM components, components_tr, devices, "
-      "devices_tr "
-      "ON components.id=components_tr.component_id "
-      "AND devices.id=devices_tr.device_id "
-      "AND devices.component_uuid=components.uuid "
-      "WHERE components_tr.name LIKE :keyword "
-      "OR components_tr.keywords LIKE :keyword "
-      "OR devices_tr.name LIKE :keyword "
-      "OR devices_tr.keywords LIKE :keyword ");
-  query.bindValue(":keyword", "%" + keyword + "%");
+      "SELECT uuid FROM ("
+      "SELECT components.uuid AS uuid, "
+      "bm25(components_fts, 10.0, 1.0, 5.0) AS score "
+      "FROM components_fts "
+      "INNER JOIN components_tr "
+      "ON components_tr.id = components_fts.rowid "
+      "INNER JOIN components "
+      "ON components.id = components_tr.component_id "
+      "WHERE components_fts MATCH :match "
+      "UNION ALL "
+      "SELECT devices.component_uuid AS uuid, "
+      "0.5 * bm25(devices_fts, 10.0, 1.0, 5.0) AS score "
+      "FROM devices_fts "
+      "INNER JOIN devices_tr ON devices_tr.id = devices_fts.rowid "
+      "INNER JOIN devices ON devices.id = devices_tr.device_id "
+      "WHERE devices_fts MATCH :match"
+      ") GROUP BY uuid ORDER BY MIN(score) LIMIT :limit");
+  query.bindValue(":match", toFullTextQuery(terms));
+  query.bindValue(":limit", limit);
   mDb->exec(query);
 
-  QSet<Uuid> elements;
+  QList<Uuid> elements;
   while (query.next()) {
-    elements.insert(Uuid::fromString(query.value(0).toString()));  // can throw
+    elements.append(Uuid::fromString(query.value(0).toString()));  // can throw
   }
   return elements;
 }
 
+QString WorkspaceLibraryDb::toFullTextQuery(const QStringList& terms) noexcept {
+  // Every term is quoted to avoid interpreting it as FTS5 query syntax, and
+  // marked as prefix to match while the user is still typing.
+  QStringList phrases;
+  foreach (QString term, terms) {
+    phrases.append("\"" % term.replace("\"", "\"\"") % "\"*");
+  }
+  return phrases.join(" ");  // implicit AND
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -712,6 +756,9 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`file_mtime` INTEGER NOT NULL, "
+      "`file_size` INTEGER NOT NULL, "
+      "`file_hash` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
@@ -734,6 +781,9 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`file_mtime` INTEGER NOT NULL, "
+      "`file_size` INTEGER NOT NULL, "
+      "`file_hash` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
@@ -756,6 +806,9 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`file_mtime` INTEGER NOT NULL, "
+      "`file_size` INTEGER NOT NULL, "
+      "`file_hash` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL"
       ")");
@@ -785,6 +838,9 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`file_mtime` INTEGER NOT NULL, "
+      "`file_size` INTEGER NOT NULL, "
+      "`file_hash` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL "
       ")");
@@ -814,6 +870,9 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`file_mtime` INTEGER NOT NULL, "
+      "`file_size` INTEGER NOT NULL, "
+      "`file_hash` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL"
       ")");
@@ -843,6 +902,9 @@ void WorkspaceLibraryDb::createAllTables() {
       "`id` INTEGER PRIMARY KEY NOT NULL, "
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
+      "`file_mtime` INTEGER NOT NULL, "
+      "`file_size` INTEGER NOT NULL, "
+      "`file_hash` TEXT NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`component_uuid` TEXT NOT NULL, "
@@ -868,6 +930,49 @@ void WorkspaceLibraryDb::createAllTables() {
       "UNIQUE(device_id, category_uuid)"
       ")");
 
+  // Full-text search indices of the translations, kept up to date by triggers.
+  // If FTS5 is not available, searching falls back to LIKE queries.
+  if (mDb->isFts5Available()) {  // can throw
+    QStringList tables = {"components", "devices"};
+    foreach (const QString& table, tables) {
+      queries << QString(
+                     "CREATE VIRTUAL TABLE IF NOT EXISTS %1_fts USING fts5("
+                     "name, description, keywords, "
+                     "content='%1_tr', content_rowid='id', prefix='2 3'"
+                     ")")
+                     .arg(table);
+      queries << QString(
+                     "CREATE TRIGGER IF NOT EXISTS %1_tr_ai "
+                     "AFTER INSERT ON %1_tr BEGIN "
+                     "INSERT INTO %1_fts (rowid, name, description, keywords) "
+                     "VALUES (new.id, new.name, new.description, "
+                     "new.keywords); "
+                     "END")
+                     .arg(table);
+      queries << QString(
+                     "CREATE TRIGGER IF NOT EXISTS %1_tr_ad "
+                     "AFTER DELETE ON %1_tr BEGIN "
+                     "INSERT INTO %1_fts "
+                     "(%1_fts, rowid, name, description, keywords) VALUES "
+                     "('delete', old.id, old.name, old.description, "
+                     "old.keywords); "
+                     "END")
+                     .arg(table);
+      queries << QString(
+                     "CREATE TRIGGER IF NOT EXISTS %1_tr_au "
+                     "AFTER UPDATE ON %1_tr BEGIN "
+                     "INSERT INTO %1_fts "
+                     "(%1_fts, rowid, name, description, keywords) VALUES "
+                     "('delete', old.id, old.name, old.description, "
+                     "old.keywords); "
+                     "INSERT INTO %1_fts (rowid, name, description, keywords) "
+                     "VALUES (new.id, new.name, new.description, "
+                     "new.keywords); "
+                     "END")
+                     .arg(table);
+    }
+  }
+
   // execute queries
   foreach (const QString& string, queries) {
     QSqlQuery query = mDb->prepareQuery(string);  // can throw
@@ -875,6 +980,69 @@ void WorkspaceLibraryDb::createAllTables() {
   }
 }
 
+QList<Uuid> WorkspaceLibraryDb::searchComponentsWithoutIndex(
+    const QStringList& terms, int limit) const {
+  // All terms must match the beginning of a word in any name, description or
+  // keywords of the component or one of its devices, like the prefix queries
+  // of the full-text index.
+  QStringList conditions;
+  for (int i = 0; i < terms.count(); ++i) {
+    QStringList columns;
+    foreach (const QString& table, QStringList{"components", "devices"}) {
+      foreach (const QString& column,
+               QStringList{"name", "description", "keywords"}) {
+        columns.append(
+            QString("%1_tr.%2 LIKE :term%3 ESCAPE '\\'")
+                .arg(table, column)
+                .arg(i));
+      }
+    }
+    conditions.append("(" % columns.join(" OR ") % ")");
+  }
+  QSqlQuery query = mDb->prepareQuery(
+      "SELECT components.uuid, "
+      "components_tr.name, components_tr.description, "
+      "components_tr.keywords, devices_tr.name, devices_tr.description, "
+      "devices_tr.keywords FROM components "
+      "LEFT JOIN components_tr "
+      "ON components.id = components_tr.component_id "
+      "LEFT JOIN devices ON devices.component_uuid = components.uuid "
+      "LEFT JOIN devices_tr ON devices.id = devices_tr.device_id "
+      "WHERE " %
+      conditions.join(" AND "));
+  for (int i = 0; i < terms.count(); ++i) {
+    // LIKE only finds substrings, word prefixes are checked below (note that
+    // '_' is a word character, but a wildcard in LIKE patterns)
+    QString term = QString(terms.at(i)).replace("_", "\\_");
+    query.bindValue(QString(":term%1").arg(i), "%" % term % "%");
+  }
+  mDb->exec(query);
+
+  QList<QRegularExpression> prefixes;
+  foreach (const QString& term, terms) {
+    prefixes.append(QRegularExpression(
+        "(?<![\\p{L}\\p{N}])" % QRegularExpression::escape(term),
+        QRegularExpression::CaseInsensitiveOption));
+  }
+  QList<Uuid> elements;
+  while (query.next() && ((limit < 0) || (elements.count() < limit))) {
+    QStringList texts;
+    for (int i = 1; i <= 6; ++i) {
+      texts.append(query.value(i).toString());
+    }
+    QString text  = texts.join("\n");
+    bool    match = true;
+    foreach (const QRegularExpression& prefix, prefixes) {
+      match = match && prefix.match(text).hasMatch();
+    }
+    Uuid uuid = Uuid::fromString(query.value(0).toString());  // can throw
+    if (match && (!elements.contains(uuid))) {
+      elements.append(uuid);
+    }
+  }
+  return elements;
+}
+
 int WorkspaceLibraryDb::getDbVersion() const noexcept {
   try {
     QSqlQuery query = mDb->prepareQuery(
@@ -893,6 +1061,14 @@ int WorkspaceLibraryDb::getDbVersion() const noexcept {
   }
 }
 
+bool WorkspaceLibraryDb::hasFullTextIndex() const {
+  QSqlQuery query = mDb->prepareQuery(
+      "SELECT COUNT(*) FROM sqlite_master "
+      "WHERE type = 'table' AND name = 'components_fts'");
+  mDb->exec(query);  // can throw
+  return query.next() && (query.value(0).toInt() > 0);
+}
+
 void WorkspaceLibraryDb::setDbVersion(int version) {
   QSqlQuery query = mDb->prepareQuery(
       "INSERT INTO internal (key, value_int) "
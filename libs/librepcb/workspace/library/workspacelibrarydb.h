@@ -118,7 +118,34 @@ public:
   QSet<Uuid>  getComponentsByCategory(const tl::optional<Uuid>& category) const;
   QSet<Uuid>  getDevicesByCategory(const tl::optional<Uuid>& category) const;
   QSet<Uuid>  getDevicesOfComponent(const Uuid& component) const;
-  QSet<Uuid>  getComponentsBySearchKeyword(const QString& keyword) const;
+
+  // Getters: Search
+
+  /**
+   * @brief Search components by their name, description or keywords, or the
+   *        name, description or keywords of their devices
+   *
+   * The search string is split into terms at all non-word characters (regex
+   * `\W+`), so punctuation is ignored. All terms must match the beginning of
+   * a word (e.g. "res 06" finds a resistor with the keyword "0603"). If the
+   * SQLite FTS5 full-text index is available, the results are ranked by
+   * relevance, otherwise they are returned in no particular order.
+   *
+   * @param keywords  The search terms entered by the user
+   * @param limit     Maximum number of results (-1 means no limit)
+   *
+   * @return UUIDs of the found components, the most relevant first
+   */
+  QList<Uuid> searchComponents(const QString& keywords, int limit = -1) const;
+
+  /**
+   * @brief Build an FTS5 query which matches all terms as word prefixes
+   *
+   * @param terms   The search terms, any FTS5 query syntax in them is escaped
+   *
+   * @return The FTS5 query string (e.g. `"res"* "06"*`)
+   */
+  static QString toFullTextQuery(const QStringList& terms) noexcept;
 
   // General Methods
 
@@ -163,7 +190,10 @@ private:
   int             getLibraryId(const FilePath& lib) const;
   QList<FilePath> getLibraryElements(const FilePath& lib,
                                      const QString&  tablename) const;
+  QList<Uuid>     searchComponentsWithoutIndex(const QStringList& terms,
+                                               int                limit) const;
   void            createAllTables();
+  bool            hasFullTextIndex() const;
   void            setDbVersion(int version);
   int             getDbVersion() const noexcept;
 
@@ -172,9 +202,10 @@ private:
   FilePath                       mFilePath;  ///< path to the SQLite database
   QScopedPointer<SQLiteDatabase> mDb;        ///< the SQLite database
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+  bool mHasFullTextIndex;  ///< Whether SQLite FTS5 is used for searching
 
   // Constants
-  static const int sCurrentDbVersion = 2;
+  static const int sCurrentDbVersion = 4;
 };
 
 /*******************************************************************************
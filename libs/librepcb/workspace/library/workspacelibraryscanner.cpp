@@ -24,11 +24,15 @@
 
 #include "../workspace.h"
 
+#include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/sqlitedatabase.h>
 #include <librepcb/library/elements.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <type_traits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -110,8 +114,10 @@ void WorkspaceLibraryScanner::scan() noexcept {
     emit scanProgressUpdate(0);
     qDebug() << "Workspace library scan started.";
 
-    // open SQLite database
-    SQLiteDatabase db(mDbFilePath);  // can throw
+    // open SQLite database (the database is only a cache which would be
+    // rebuilt anyway, so avoid waiting for every write to reach the disk)
+    SQLiteDatabase db(mDbFilePath);                          // can throw
+    db.setSynchronous(SQLiteDatabase::Synchronous::Normal);  // can throw
 
     // update list of libraries
     QHash<FilePath, std::shared_ptr<Library>> libraries;
@@ -125,8 +131,8 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    clearAllTables(db);
+    // remove elements of libraries which do no longer exist
+    removeElementsOfRemovedLibraries(db);
 
     // scan all libraries
     int   count   = 0;
@@ -137,12 +143,12 @@ void WorkspaceLibraryScanner::scan() noexcept {
       const std::shared_ptr<Library>& lib   = libraries[fp];
       Q_ASSERT(lib);
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addCategoriesToDb<ComponentCategory>(
+      count += addElementsToDb<ComponentCategory>(
           db, lib->searchForElements<ComponentCategory>(),
           "component_categories", "cat_id", libId);
       emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addCategoriesToDb<PackageCategory>(
+      count += addElementsToDb<PackageCategory>(
           db, lib->searchForElements<PackageCategory>(), "package_categories",
           "cat_id", libId);
       emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
@@ -160,8 +166,8 @@ void WorkspaceLibraryScanner::scan() noexcept {
                                      "components", "component_id", libId);
       emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addDevicesToDb(db, lib->searchForElements<Device>(), "devices",
-                              "device_id", libId);
+      count += addElementsToDb<Device>(db, lib->searchForElements<Device>(),
+                                       "devices", "device_id", libId);
       emit scanProgressUpdate(percent += qreal(100) / (libraries.count() * 6));
     }
 
@@ -290,86 +296,17 @@ QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
   return dbLibIds;
 }
 
-void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db) {
-  // component categories
-  db.clearTable("component_categories_tr");
-  db.clearTable("component_categories");
-
-  // package categories
-  db.clearTable("package_categories_tr");
-  db.clearTable("package_categories");
-
-  // symbols
-  db.clearTable("symbols_tr");
-  db.clearTable("symbols_cat");
-  db.clearTable("symbols");
-
-  // packages
-  db.clearTable("packages_tr");
-  db.clearTable("packages_cat");
-  db.clearTable("packages");
-
-  // components
-  db.clearTable("components_tr");
-  db.clearTable("components_cat");
-  db.clearTable("components");
-
-  // devices
-  db.clearTable("devices_tr");
-  db.clearTable("devices_cat");
-  db.clearTable("devices");
-}
-
-template <typename ElementType>
-int WorkspaceLibraryScanner::addCategoriesToDb(SQLiteDatabase&        db,
-                                               const QList<FilePath>& dirs,
-                                               const QString&         table,
-                                               const QString&         idColumn,
-                                               int                    libId) {
-  int count = 0;
-  foreach (const FilePath& filepath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    try {
-      ElementType element(filepath, true);  // can throw
-      QSqlQuery   query = db.prepareQuery(
-          "INSERT INTO " % table %
-          " "
-          "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
-          "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":parent_uuid", element.getParentUuid()
-                                          ? element.getParentUuid()->toStr()
-                                          : QVariant(QVariant::String));
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
-      }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
-    }
+void WorkspaceLibraryScanner::removeElementsOfRemovedLibraries(
+    SQLiteDatabase& db) {
+  // Note: Translations and categories are removed by "ON DELETE CASCADE".
+  QStringList tables = {"component_categories", "package_categories", "symbols",
+                        "packages", "components", "devices"};
+  foreach (const QString& table, tables) {
+    QSqlQuery query = db.prepareQuery(
+        "DELETE FROM " % table %
+        " WHERE lib_id NOT IN (SELECT id FROM libraries)");
+    db.exec(query);
   }
-  return count;
 }
 
 template <typename ElementType>
@@ -378,120 +315,254 @@ int WorkspaceLibraryScanner::addElementsToDb(SQLiteDatabase&        db,
                                              const QString&         table,
                                              const QString&         idColumn,
                                              int                    libId) {
-  int count = 0;
+  // get all elements of this library which are already in the database
+  QHash<FilePath, ElementData> dbElements;
+
+  QSqlQuery query = db.prepareQuery(
+      "SELECT id, filepath, file_mtime, file_size, file_hash FROM " % table %
+      " WHERE lib_id = :lib_id");
+  query.bindValue(":lib_id", libId);
+  db.exec(query);
+  while (query.next()) {
+    ElementData data;
+    data.id       = query.value(0).toInt();
+    data.filepath = FilePath::fromRelative(mWorkspace.getLibrariesPath(),
+                                           query.value(1).toString());
+    data.valid    = false;
+    data.modified = true;
+
+    data.fingerprint.mtime = query.value(2).toLongLong();
+    data.fingerprint.size  = query.value(3).toLongLong();
+    data.fingerprint.hash  = query.value(4).toString();
+    dbElements.insert(data.filepath, data);
+  }
+
+  // Determine the elements which need to be parsed. To avoid reading all
+  // files, unmodified files are detected by their modification time and size.
+  int                count = 0;
+  QList<ElementData> modifiedElements;
   foreach (const FilePath& filepath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    try {
-      ElementType element(filepath, true);  // can throw
-      QSqlQuery   query =
-          db.prepareQuery("INSERT INTO " % table %
-                          " "
-                          "(lib_id, filepath, uuid, version) VALUES "
-                          "(:lib_id, :filepath, :uuid, :version)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
+    QFileInfo file(
+        filepath.getPathTo(ElementType::getLongElementName() % ".lp").toStr());
+    qint64 mtime = file.lastModified().toMSecsSinceEpoch();
+    qint64 size  = file.size();
+    if (dbElements.contains(filepath)) {
+      ElementData data = dbElements.take(filepath);
+      if ((data.fingerprint.mtime == mtime) &&
+          (data.fingerprint.size == size)) {
+        count++;  // element is up to date
+        continue;
       }
-      foreach (const Uuid& categoryUuid, element.getCategories()) {
-        QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                          "_cat "
-                                          "(" %
-                                          idColumn %
-                                          ", category_uuid) VALUES "
-                                          "(:element_id, :category_uuid)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":category_uuid", categoryUuid.toStr());
-        db.insert(query);
+      data.fingerprint.mtime = mtime;
+      data.fingerprint.size  = size;
+      modifiedElements.append(data);
+    } else {
+      ElementData data;
+      data.filepath          = filepath;
+      data.id                = -1;
+      data.valid             = false;
+      data.modified          = true;
+      data.fingerprint.mtime = mtime;
+      data.fingerprint.size  = size;
+      modifiedElements.append(data);
+    }
+  }
+
+  // remove elements which do no longer exist
+  foreach (const ElementData& data, dbElements) {
+    QSqlQuery& deleteQuery =
+        db.prepareCachedQuery("DELETE FROM " % table % " WHERE id = :id");
+    deleteQuery.bindValue(":id", data.id);
+    db.exec(deleteQuery);
+  }
+
+  // parse the elements in worker threads, but access the database only from
+  // this thread (results are provided in the same order as the elements)
+  QFuture<ElementData> future =
+      QtConcurrent::mapped(modifiedElements, &parseElement<ElementType>);
+
+  // only library elements (but not categories) have a categories table
+  const bool hasCategories =
+      std::is_base_of<LibraryElement, ElementType>::value;
+  int updatedCount = 0;
+  for (int i = 0; i < modifiedElements.count(); ++i) {
+    if (mAbort || (mSemaphore.available() > 0)) {
+      future.cancel();
+      break;
+    }
+    const ElementData data = future.resultAt(i);  // blocks until parsed
+    if (data.valid) {
+      writeElementToDb(db, data, table, idColumn, libId, hasCategories);
+      if (data.modified) {
+        updatedCount++;
       }
       count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
+    } else {
+      qWarning() << "Failed to open library element:"
+                 << data.filepath.toNative();
+      if (data.id >= 0) {
+        QSqlQuery& deleteQuery =
+            db.prepareCachedQuery("DELETE FROM " % table % " WHERE id = :id");
+        deleteQuery.bindValue(":id", data.id);
+        db.exec(deleteQuery);
+      }
     }
   }
+
+  // don't leave this method while worker threads are still running
+  future.waitForFinished();
+  if ((updatedCount > 0) || (!dbElements.isEmpty())) {
+    qDebug() << "Updated" << updatedCount << "and removed" << dbElements.count()
+             << "elements in table" << table;
+  }
   return count;
 }
 
-int WorkspaceLibraryScanner::addDevicesToDb(SQLiteDatabase&        db,
-                                            const QList<FilePath>& dirs,
-                                            const QString&         table,
-                                            const QString&         idColumn,
-                                            int                    libId) {
-  int count = 0;
-  foreach (const FilePath& filepath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    try {
-      Device    element(filepath, true);  // can throw
-      QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                        " "
-                                        "(lib_id, filepath, uuid, version, "
-                                        "component_uuid, package_uuid) VALUES "
-                                        "(:lib_id, :filepath, :uuid, :version, "
-                                        ":component_uuid, :package_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath",
-                      filepath.toRelative(mWorkspace.getLibrariesPath()));
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":component_uuid", element.getComponentUuid().toStr());
-      query.bindValue(":package_uuid", element.getPackageUuid().toStr());
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
-      }
-      foreach (const Uuid& categoryUuid, element.getCategories()) {
-        QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                          "_cat "
-                                          "(" %
-                                          idColumn %
-                                          ", category_uuid) VALUES "
-                                          "(:element_id, :category_uuid)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":category_uuid", categoryUuid.toStr());
-        db.insert(query);
-      }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << filepath.toNative();
+void WorkspaceLibraryScanner::writeElementToDb(
+    SQLiteDatabase& db, const ElementData& data, const QString& table,
+    const QString& idColumn, int libId, bool hasCategories) {
+  QList<QPair<QString, QVariant>> columns;
+  columns.append(qMakePair(QString("file_mtime"),
+                           QVariant(data.fingerprint.mtime)));
+  columns.append(qMakePair(QString("file_size"),
+                           QVariant(data.fingerprint.size)));
+  columns.append(qMakePair(QString("file_hash"),
+                           QVariant(data.fingerprint.hash)));
+  if (!data.modified) {
+    // only the modification time has changed, not the content
+    updateElementRow(db, table, data.id, columns);
+    return;
+  }
+  columns.append(qMakePair(QString("uuid"), QVariant(data.uuid)));
+  columns.append(qMakePair(QString("version"), QVariant(data.version)));
+  columns.append(data.columns);
+
+  int id = data.id;
+  if (id >= 0) {
+    // update the existing row to keep its ID, but replace all translations
+    // and categories
+    updateElementRow(db, table, id, columns);
+    QStringList childTables = {table % "_tr"};
+    if (hasCategories) {
+      childTables.append(table % "_cat");
+    }
+    foreach (const QString& childTable, childTables) {
+      QSqlQuery& query = db.prepareCachedQuery(
+          "DELETE FROM " % childTable % " WHERE " % idColumn % " = :id");
+      query.bindValue(":id", id);
+      db.exec(query);
     }
+  } else {
+    columns.append(qMakePair(QString("lib_id"), QVariant(libId)));
+    columns.append(qMakePair(
+        QString("filepath"),
+        QVariant(data.filepath.toRelative(mWorkspace.getLibrariesPath()))));
+    QStringList names;
+    for (const auto& column : columns) {
+      names.append(column.first);
+    }
+    QSqlQuery& query = db.prepareCachedQuery("INSERT INTO " % table % " (" %
+                                             names.join(", ") % ") VALUES (:" %
+                                             names.join(", :") % ")");
+    for (const auto& column : columns) {
+      query.bindValue(":" % column.first, column.second);
+    }
+    id = db.insert(query);
   }
-  return count;
+
+  // insert all translations and categories at once
+  QList<QVariantList> translations;
+  foreach (const Translation& tr, data.translations) {
+    translations.append(
+        QVariantList{id, tr.locale, tr.name, tr.description, tr.keywords});
+  }
+  db.insertRows(table % "_tr",
+                {idColumn, "locale", "name", "description", "keywords"},
+                translations);  // can throw
+  QList<QVariantList> categories;
+  foreach (const QString& categoryUuid, data.categories) {
+    categories.append(QVariantList{id, categoryUuid});
+  }
+  db.insertRows(table % "_cat", {idColumn, "category_uuid"},
+                categories);  // can throw
+}
+
+void WorkspaceLibraryScanner::updateElementRow(
+    SQLiteDatabase& db, const QString& table, int id,
+    const QList<QPair<QString, QVariant>>& columns) {
+  QStringList assignments;
+  for (const auto& column : columns) {
+    assignments.append(column.first % " = :" % column.first);
+  }
+  QSqlQuery& query = db.prepareCachedQuery(
+      "UPDATE " % table % " SET " % assignments.join(", ") % " WHERE id = :id");
+  for (const auto& column : columns) {
+    query.bindValue(":" % column.first, column.second);
+  }
+  query.bindValue(":id", id);
+  db.exec(query);
+}
+
+template <typename ElementType>
+WorkspaceLibraryScanner::ElementData WorkspaceLibraryScanner::parseElement(
+    const ElementData& input) noexcept {
+  // Note: This method is called in a worker thread!
+  ElementData data = input;
+  try {
+    // if the file content has not changed, there's no need to parse it
+    QByteArray content = FileUtils::readFile(data.filepath.getPathTo(
+        ElementType::getLongElementName() % ".lp"));  // can throw
+    QString hash = QString::fromLatin1(
+        QCryptographicHash::hash(content, QCryptographicHash::Sha256).toHex());
+    if ((data.id >= 0) && (hash == data.fingerprint.hash)) {
+      data.modified = false;
+      data.valid    = true;
+      return data;
+    }
+    data.fingerprint.hash = hash;
+
+    ElementType element(data.filepath, true);  // can throw
+    data.uuid    = element.getUuid().toStr();
+    data.version = element.getVersion().toStr();
+    foreach (const QString& locale, element.getAllAvailableLocales()) {
+      Translation tr;
+      tr.locale      = locale;
+      tr.name        = optionalToVariant(element.getNames().tryGet(locale));
+      tr.description =
+          optionalToVariant(element.getDescriptions().tryGet(locale));
+      tr.keywords    = optionalToVariant(element.getKeywords().tryGet(locale));
+      data.translations.append(tr);
+    }
+    getElementData(element, data);
+    data.valid = true;
+  } catch (const Exception&) {
+    // will be reported by addElementsToDb()
+  }
+  return data;
+}
+
+void WorkspaceLibraryScanner::getElementData(const LibraryCategory& element,
+                                             ElementData& data) noexcept {
+  data.columns.append(qMakePair(QString("parent_uuid"),
+                                element.getParentUuid()
+                                    ? QVariant(element.getParentUuid()->toStr())
+                                    : QVariant(QVariant::String)));
+}
+
+void WorkspaceLibraryScanner::getElementData(const LibraryElement& element,
+                                             ElementData& data) noexcept {
+  foreach (const Uuid& categoryUuid, element.getCategories()) {
+    data.categories.append(categoryUuid.toStr());
+  }
+}
+
+void WorkspaceLibraryScanner::getElementData(const Device& element,
+                                             ElementData& data) noexcept {
+  getElementData(static_cast<const LibraryElement&>(element), data);
+  data.columns.append(qMakePair(QString("component_uuid"),
+                                QVariant(element.getComponentUuid().toStr())));
+  data.columns.append(qMakePair(QString("package_uuid"),
+                                QVariant(element.getPackageUuid().toStr())));
 }
 
 /*******************************************************************************
@@ -39,7 +39,10 @@ class SQLiteDatabase;
 
 namespace library {
 class Library;
-}
+class LibraryCategory;
+class LibraryElement;
+class Device;
+}  // namespace library
 
 namespace workspace {
 
@@ -52,6 +55,16 @@ class Workspace;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
+ * The library elements are scanned in a pipeline: They are parsed in parallel
+ * by the worker threads of the global thread pool while the #run() thread
+ * writes the already parsed elements into the SQLite database. So the
+ * database is still accessed from only one thread.
+ *
+ * To make rescans fast, the database contains a fingerprint of each element's
+ * *.lp file. Only elements whose modification time or size has changed are
+ * read again, and only those whose content hash has changed are parsed again
+ * and updated in the database. Elements which no longer exist are removed.
+ *
  * @warning Be very careful with dependencies to other objects as the #run()
  * method is executed in a separate thread! Keep the number of dependencies as
  * small as possible and consider thread synchronization and object lifetimes.
@@ -80,25 +93,57 @@ signals:
   void scanFailed(QString errorMsg);
   void scanFinished();
 
+private:  // Types
+  struct Translation {
+    QString  locale;
+    QVariant name;
+    QVariant description;
+    QVariant keywords;
+  };
+  struct Fingerprint {
+    qint64  mtime;  ///< Modification time of the *.lp file [ms since epoch]
+    qint64  size;   ///< Size of the *.lp file [bytes]
+    QString hash;   ///< SHA-256 of the *.lp file content (hex)
+  };
+  struct ElementData {
+    FilePath                        filepath;
+    int                             id;  ///< Row ID, or -1 if not in the DB
+    Fingerprint                     fingerprint;
+    bool                            valid;     ///< False if parsing failed
+    bool                            modified;  ///< False if content unchanged
+    QString                         uuid;
+    QString                         version;
+    QList<QPair<QString, QVariant>> columns;  ///< Type-specific columns
+    QList<Translation>              translations;
+    QStringList                     categories;
+  };
+
 private:  // Methods
   void                 run() noexcept override;
   void                 scan() noexcept;
   QHash<FilePath, int> updateLibraries(
       SQLiteDatabase&                                           db,
       const QHash<FilePath, std::shared_ptr<library::Library>>& libs);
-  void clearAllTables(SQLiteDatabase& db);
+  void removeElementsOfRemovedLibraries(SQLiteDatabase& db);
   void getLibrariesOfDirectory(
       const FilePath&                                     dir,
       QHash<FilePath, std::shared_ptr<library::Library>>& libs) noexcept;
   template <typename ElementType>
-  int addCategoriesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                        const QString& table, const QString& idColumn,
-                        int libId);
-  template <typename ElementType>
   int addElementsToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
                       const QString& table, const QString& idColumn, int libId);
-  int addDevicesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                     const QString& table, const QString& idColumn, int libId);
+  void writeElementToDb(SQLiteDatabase& db, const ElementData& data,
+                        const QString& table, const QString& idColumn,
+                        int libId, bool hasCategories);
+  static void updateElementRow(SQLiteDatabase& db, const QString& table, int id,
+                               const QList<QPair<QString, QVariant>>& columns);
+  template <typename ElementType>
+  static ElementData parseElement(const ElementData& input) noexcept;
+  static void getElementData(const library::LibraryCategory& element,
+                             ElementData&                    data) noexcept;
+  static void getElementData(const library::LibraryElement& element,
+                             ElementData&                   data) noexcept;
+  static void getElementData(const library::Device& element,
+                             ElementData&           data) noexcept;
   template <typename T>
   static QVariant optionalToVariant(const T& opt) noexcept;
 
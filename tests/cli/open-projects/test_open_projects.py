@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import os
+import json
+
+"""
+Test command "open-projects"
+"""
+
+PROJECT_DIR = 'data/Empty Project/'
+PROJECT_PATH = PROJECT_DIR + 'Empty Project.lpp'
+OUTPUT_DIR = PROJECT_DIR + 'output/v1/gerber'
+
+PROJECT_2_DIR = 'data/Project With Two Boards/'
+PROJECT_2_PATH = PROJECT_2_DIR + 'Project With Two Boards.lpp'
+OUTPUT_2_DIR = PROJECT_2_DIR + 'output/v1/gerber'
+
+
+def test_help(cli):
+    code, stdout, stderr = cli.run('open-projects', '--help')
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 20
+
+
+def test_no_projects(cli):
+    code, stdout, stderr = cli.run('open-projects')
+    assert code == 1
+    assert len(stderr) > 0
+    assert 'Wrong argument count.' in stderr[0]
+
+
+def test_invalid_jobs(cli):
+    code, stdout, stderr = cli.run('open-projects', '--jobs=0', PROJECT_PATH)
+    assert code == 1
+    assert len(stderr) > 0
+    assert 'Invalid number of jobs' in stderr[0]
+
+
+def test_nonexistent_project(cli):
+    code, stdout, stderr = cli.run('open-projects', 'nonexistent/*.lpp')
+    assert code == 1
+    assert len(stderr) == 1
+    assert 'No project files found' in stderr[0]
+    assert stdout[-1] == 'Finished with errors!'
+
+
+def test_export_with_report(cli):
+    report = cli.abspath('report.json')
+    code, stdout, stderr = cli.run('open-projects',
+                                   '--erc',
+                                   '--export-pcb-fabrication-data',
+                                   '--jobs=2',
+                                   '--report={}'.format(report),
+                                   PROJECT_PATH,
+                                   'data/Project With Two Boards/*.lpp')
+    assert code == 0
+    assert len(stderr) == 0
+    assert '2 of 2 project(s) succeeded' in stdout[-3]
+    assert stdout[-1] == 'SUCCESS'
+    assert len(os.listdir(cli.abspath(OUTPUT_DIR))) == 8
+    assert len(os.listdir(cli.abspath(OUTPUT_2_DIR))) == 16
+
+    with open(report, 'r') as f:
+        data = json.load(f)
+    assert data['success'] is True
+    assert data['jobs'] == 2
+    assert len(data['projects']) == 2
+    project = data['projects'][0]
+    assert project['project'] == cli.abspath(PROJECT_PATH)
+    assert project['success'] is True
+    assert project['errors'] == []
+    assert project['approved_erc_messages'] == 1
+    assert project['erc_messages'] == []
+    assert len(project['written_files']) == 8
+    assert project['times_ms']['total'] >= project['times_ms']['load']
+    assert len(data['projects'][1]['written_files']) == 16
+
+
+def test_manifest_with_nonapproved_message(cli):
+    # disapprove the ERC message of the first project
+    with open(cli.abspath(PROJECT_DIR + 'circuit/erc.lp'), 'w') as f:
+        f.write('(librepcb_erc)')
+    manifest = cli.abspath('data/projects.txt')
+    with open(manifest, 'w') as f:
+        f.write('# comment\n')
+        f.write('Empty Project/Empty Project.lpp\n')
+        f.write('\n')
+        f.write('Project With Two Boards/*.lpp\n')
+    code, stdout, stderr = cli.run('open-projects',
+                                   '--erc',
+                                   '--manifest={}'.format(manifest))
+    assert code == 1
+    assert len(stderr) == 1
+    assert 'Unused net class' in stderr[0]
+    assert '1 of 2 project(s) succeeded' in stdout[-2]
+    assert stdout[-1] == 'Finished with errors!'
@@ -0,0 +1,36 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import json
+
+"""
+Test "--profile"
+"""
+
+PROJECT_DIR = 'data/Empty Project/'
+PROJECT_PATH = PROJECT_DIR + 'Empty Project.lpp'
+
+
+def test_write_profile(cli):
+    code, stdout, stderr = cli.run('--profile', 'profile.json', 'open-project',
+                                   '--export-pcb-fabrication-data',
+                                   PROJECT_PATH)
+    assert code == 0
+    assert len(stderr) == 0
+    assert "Write profile to 'profile.json'..." in stdout
+    assert stdout[-1] == 'SUCCESS'
+    with open(cli.abspath('profile.json'), 'r') as f:
+        profile = json.load(f)
+    names = [event['name'] for event in profile['traceEvents']]
+    assert 'Open project' in names
+    assert 'Load board' in names
+    assert 'Export fabrication data' in names
+
+
+def test_invalid_profile_path(cli):
+    # the path of an existing directory can't be written as a file
+    code, stdout, stderr = cli.run('--profile', 'data', 'open-project',
+                                   PROJECT_PATH)
+    assert code == 1
+    assert len(stderr) > 0
+    assert stdout[-1] == 'Finished with errors!'
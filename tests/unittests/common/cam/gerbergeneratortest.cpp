@@ -0,0 +1,137 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerbergenerator.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GerberGeneratorTest : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+  Uuid     mUuid;
+
+  GerberGeneratorTest() : mUuid(Uuid::createRandom()) {}
+
+  virtual void SetUp() override {
+    mTempDir =
+        FilePath::getApplicationTempPath().getPathTo("GerberGeneratorTest");
+    if (mTempDir.isExistingDir()) {
+      FileUtils::removeDirRecursively(mTempDir);  // can throw
+    }
+    FileUtils::makePath(mTempDir);  // can throw
+  }
+
+  virtual void TearDown() override {
+    FileUtils::removeDirRecursively(mTempDir);  // can throw
+  }
+
+  QByteArray generate(const QString& filename, bool streaming) {
+    GerberGenerator gen("Test Project", mUuid, "v1");
+    if (streaming) {
+      gen.enableStreaming();
+    }
+    // more content than the buffer used for streaming
+    for (int i = 0; i < 50000; ++i) {
+      gen.drawLine(Point(i, 0), Point(i, 100000), UnsignedLength(100 + i % 7));
+    }
+    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
+    gen.flashCircle(Point(0, 0), UnsignedLength(1000), UnsignedLength(0));
+    gen.generate();
+    FilePath fp = mTempDir.getPathTo(filename);
+    gen.saveToFile(fp);
+    QByteArray content = FileUtils::readFile(fp);
+    if (!streaming) {
+      EXPECT_TRUE(gen.toStr().toLatin1() == content);
+    }
+    return content;
+  }
+
+  static QByteArray getLine(const QByteArray& content,
+                            const QByteArray& prefix) noexcept {
+    foreach (const QByteArray& line, content.split('\n')) {
+      if (line.startsWith(prefix)) {
+        return line;
+      }
+    }
+    return QByteArray();
+  }
+
+  static QByteArray calcChecksumLine(const QByteArray& content) noexcept {
+    // everything before the checksum line, without linebreaks
+    QByteArray data = content.left(content.indexOf("%TF.MD5,"));
+    data.replace('\n', QByteArray());
+    QByteArray md5 = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+    return "%TF.MD5," + md5.toHex() + "*%";
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GerberGeneratorTest, testStreamingCreatesSameFile) {
+  QByteArray inMemory;
+  QByteArray streamed;
+  // repeat if the creation date (resolution of seconds) changed in between
+  for (int i = 0; i < 3; ++i) {
+    inMemory = generate("in_memory.gbr", false);
+    streamed = generate("streamed.gbr", true);
+    if (getLine(inMemory, "%TF.CreationDate,") ==
+        getLine(streamed, "%TF.CreationDate,")) {
+      break;
+    }
+  }
+  EXPECT_EQ(inMemory.size(), streamed.size());
+  EXPECT_TRUE(inMemory == streamed);  // avoid printing the whole files
+  EXPECT_EQ(getLine(inMemory, "%TF.MD5,").toStdString(),
+            getLine(streamed, "%TF.MD5,").toStdString());
+  EXPECT_TRUE(streamed.endsWith("G04 --- BOARD END --- *\n" +
+                                getLine(streamed, "%TF.MD5,") + "\nM02*\n"));
+}
+
+TEST_F(GerberGeneratorTest, testChecksum) {
+  QByteArray inMemory = generate("in_memory.gbr", false);
+  QByteArray streamed = generate("streamed.gbr", true);
+  EXPECT_EQ(calcChecksumLine(inMemory).toStdString(),
+            getLine(inMemory, "%TF.MD5,").toStdString());
+  EXPECT_EQ(calcChecksumLine(streamed).toStdString(),
+            getLine(streamed, "%TF.MD5,").toStdString());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,209 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SExpressionTest : public ::testing::Test {
+protected:
+  static SExpression parse(const QByteArray& content) {
+    return SExpression::parse(content, FilePath());
+  }
+
+  /**
+   * @brief Check if finding children by name returns the same nodes as a
+   *        linear scan over all children
+   */
+  static void expectSameAsLinearScan(const SExpression& root) {
+    foreach (const QString& name,
+             QStringList({"netsegment", "plane", "hole", "name", "foo"})) {
+      QList<const SExpression*> expected;
+      foreach (const SExpression& child, root.getChildren()) {
+        if (child.isList() && (child.getName() == name)) {
+          expected.append(&child);
+        }
+      }
+      QList<SExpression> children = root.getChildren(name);
+      ASSERT_EQ(expected.count(), children.count()) << qPrintable(name);
+      for (int i = 0; i < expected.count(); ++i) {
+        EXPECT_EQ(expected.at(i)->toByteArray().toStdString(),
+                  children.at(i).toByteArray().toStdString());
+      }
+      const SExpression* last = expected.isEmpty() ? nullptr : expected.last();
+      EXPECT_EQ(last, root.tryGetChildByPath(name)) << qPrintable(name);
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SExpressionTest, testParseList) {
+  SExpression root = parse("(librepcb_test\n (foo bar \"bar\")\n (empty)\n)\n");
+  EXPECT_TRUE(root.isList());
+  EXPECT_EQ("librepcb_test", root.getName());
+  ASSERT_EQ(2, root.getChildren().count());
+  const SExpression& foo = root.getChildByIndex(0);
+  EXPECT_EQ("foo", foo.getName());
+  ASSERT_EQ(2, foo.getChildren().count());
+  EXPECT_TRUE(foo.getChildByIndex(0).isToken());
+  EXPECT_EQ("bar", foo.getChildByIndex(0).getStringOrToken());
+  EXPECT_TRUE(foo.getChildByIndex(1).isString());
+  EXPECT_EQ("bar", foo.getChildByIndex(1).getStringOrToken());
+  EXPECT_EQ(0, root.getChildByPath("empty").getChildren().count());
+}
+
+TEST_F(SExpressionTest, testParseValues) {
+  SExpression root =
+      parse("(test (int -42) (bool true) (uuid "
+            "c2ceffd2-4cc5-43c6-941c-fc64a341d026))");
+  EXPECT_EQ(-42, root.getValueByPath<int>("int"));
+  EXPECT_EQ(true, root.getValueByPath<bool>("bool"));
+  EXPECT_EQ("c2ceffd2-4cc5-43c6-941c-fc64a341d026",
+            root.getValueByPath<QString>("uuid"));
+}
+
+TEST_F(SExpressionTest, testParseEscapedString) {
+  SExpression root = parse("(test \"a\\\"b\\\\c\\nd\")");
+  EXPECT_EQ("a\"b\\c\nd", root.getChildByIndex(0).getStringOrToken());
+}
+
+TEST_F(SExpressionTest, testParseUtf8String) {
+  QString     value = QString("\u00E4\u00F6\u00FC \u03A9");
+  SExpression root  = parse(QString("(test \"%1\")").arg(value).toUtf8());
+  EXPECT_EQ(value, root.getChildByIndex(0).getStringOrToken());
+}
+
+TEST_F(SExpressionTest, testParseComments) {
+  SExpression root = parse("; comment\n(test ; (foo)\n (bar))\n; comment");
+  ASSERT_EQ(1, root.getChildren().count());
+  EXPECT_EQ("bar", root.getChildByIndex(0).getName());
+}
+
+TEST_F(SExpressionTest, testParseErrors) {
+  EXPECT_THROW(parse(""), FileParseError);
+  EXPECT_THROW(parse("test"), FileParseError);
+  EXPECT_THROW(parse("(test"), FileParseError);
+  EXPECT_THROW(parse("(test))"), FileParseError);
+  EXPECT_THROW(parse("(test) (test)"), FileParseError);
+  EXPECT_THROW(parse("(test ())"), FileParseError);
+  EXPECT_THROW(parse("(test \"foo)"), FileParseError);
+  EXPECT_THROW(parse("(test \"\\x\")"), FileParseError);
+}
+
+TEST_F(SExpressionTest, testSerialize) {
+  SExpression root = SExpression::createList("test");
+  root.appendChild("name", QString("foo"), true);
+  root.appendChild("value", 42, true);
+  EXPECT_EQ("(test\n (name \"foo\")\n (value 42)\n)\n", root.toByteArray());
+}
+
+TEST_F(SExpressionTest, testWriteToDevice) {
+  SExpression root = SExpression::createList("test");
+  for (int i = 0; i < 10000; ++i) {  // bigger than the internal buffer
+    root.appendChild("value", QString("\u00E4 %1").arg(i), true);
+  }
+  QByteArray content;
+  QBuffer    buffer(&content);
+  buffer.open(QIODevice::WriteOnly);
+  root.writeTo(buffer);
+  EXPECT_EQ(root.toByteArray(), content);
+  EXPECT_EQ(10000, parse(content).getChildren("value").count());
+}
+
+TEST_F(SExpressionTest, testSerializeAndParse) {
+  SExpression root = SExpression::createList("test");
+  root.appendChild("token", SExpression::createToken("1.5"), true);
+  root.appendChild("string", QString("foo \"bar\"\n"), true);
+  root.appendList("empty", true);
+  SExpression parsed = parse(root.toByteArray());
+  EXPECT_EQ("1.5", parsed.getValueByPath<QString>("token"));
+  EXPECT_EQ("foo \"bar\"\n", parsed.getValueByPath<QString>("string"));
+  EXPECT_EQ(0, parsed.getChildByPath("empty").getChildren().count());
+}
+
+TEST_F(SExpressionTest, testChildIndex) {
+  SExpression root = SExpression::createList("test");
+  for (int i = 0; i < 100; ++i) {
+    root.appendChild(i % 2 ? "odd" : "even", i, true);
+    EXPECT_EQ(i, root.getValueByPath<int>(i % 2 ? "odd" : "even"));
+  }
+  EXPECT_EQ(50, root.getChildren("odd").count());
+  EXPECT_EQ(50, root.getChildren("even").count());
+  EXPECT_EQ(nullptr, root.tryGetChildByPath("foo"));
+  root.removeLineBreaks();
+  EXPECT_EQ(99, root.getValueByPath<int>("odd"));
+  EXPECT_EQ(98, root.getValueByPath<int>("even"));
+  SExpression parsed = parse(root.toByteArray());
+  EXPECT_EQ(99, parsed.getValueByPath<int>("odd"));
+  EXPECT_EQ(98, parsed.getChildren("even").last().getValueOfFirstChild<int>());
+}
+
+TEST_F(SExpressionTest, testChildIndexMatchesLinearScan) {
+  // wide enough to use the child index, with tokens named like lists
+  QByteArray content = "(librepcb_board\n";
+  for (int i = 0; i < 1000; ++i) {
+    content += " (netsegment " + QByteArray::number(i) + ")\n";
+    if (i % 100 == 0) {
+      content += " (plane " + QByteArray::number(i) + ") netsegment\n";
+    }
+  }
+  content += " (name \"foo\")\n)\n";
+  SExpression root = parse(content);
+  expectSameAsLinearScan(root);
+
+  // append children to the indexed list
+  root.appendChild("plane", 5000, true);
+  root.appendChild("hole", 1, false);
+  root.appendChild(SExpression::createToken("hole"), false);
+  root.appendChild("netsegment", 5001, true);
+  expectSameAsLinearScan(root);
+
+  // the index must also be valid after removing children and copying
+  root.removeLineBreaks();
+  expectSameAsLinearScan(root);
+  SExpression copy = root;
+  copy.appendChild("name", QString("bar"), true);
+  expectSameAsLinearScan(copy);
+  expectSameAsLinearScan(root);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
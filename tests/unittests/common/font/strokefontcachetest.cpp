@@ -0,0 +1,97 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <fontobene/font.h>
+#include <gtest/gtest.h>
+#include <librepcb/common/application.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/font/strokefont.h>
+#include <librepcb/common/font/strokefontcache.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StrokeFontCacheTest : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+  FilePath mFontFilePath;
+
+  virtual void SetUp() override {
+    mTempDir =
+        FilePath::getApplicationTempPath().getPathTo("StrokeFontCacheTest");
+    if (mTempDir.isExistingDir()) {
+      FileUtils::removeDirRecursively(mTempDir);  // can throw
+    }
+    FileUtils::makePath(mTempDir);  // can throw
+    mFontFilePath = qApp->getResourcesFilePath("fontobene")
+                        .getPathTo(qApp->getDefaultStrokeFontName());
+  }
+
+  virtual void TearDown() override {
+    FileUtils::removeDirRecursively(mTempDir);  // can throw
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StrokeFontCacheTest, testSameContentIsLoadedOnce) {
+  // a copy of the font has the same content, thus is loaded only once
+  FilePath copy = mTempDir.getPathTo("copy.bene");
+  FileUtils::copyFile(mFontFilePath, copy);
+  StrokeFontCache cache;
+  EXPECT_TRUE(cache.load(mFontFilePath) == cache.load(copy));
+}
+
+TEST_F(StrokeFontCacheTest, testDifferentCachesLoadSeparately) {
+  StrokeFontCache cache1;
+  StrokeFontCache cache2;
+  EXPECT_FALSE(cache1.load(mFontFilePath) == cache2.load(mFontFilePath));
+  EXPECT_FALSE(StrokeFont::load(mFontFilePath) ==
+               StrokeFont::load(mFontFilePath));
+}
+
+TEST_F(StrokeFontCacheTest, testFontOutlivesCache) {
+  QScopedPointer<StrokeFontCache> cache(new StrokeFontCache());
+  StrokeFont                      font(mFontFilePath, cache.data());
+  cache.reset();
+  Length        spacing;
+  QVector<Path> paths = font.strokeGlyph('A', PositiveLength(1000000), spacing);
+  EXPECT_FALSE(paths.isEmpty());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
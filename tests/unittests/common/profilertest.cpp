@@ -0,0 +1,116 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/profiler.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ProfilerTest : public ::testing::Test {
+protected:
+  virtual void SetUp() override { Profiler::instance().clear(); }
+
+  virtual void TearDown() override {
+    Profiler::instance().setEnabled(false);
+    Profiler::instance().clear();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ProfilerTest, testDisabledByDefault) {
+  EXPECT_FALSE(Profiler::instance().isEnabled());
+  { ProfilerScope scope("test", "Scope"); }
+  Profiler::instance().addCounter("test", "Counter", 42);
+  EXPECT_EQ(0, Profiler::instance().getEvents().count());
+}
+
+TEST_F(ProfilerTest, testScope) {
+  Profiler::instance().setEnabled(true);
+  {
+    ProfilerScope scope("test", "Scope", "details");
+    QThread::msleep(10);
+  }
+  QList<Profiler::Event> events = Profiler::instance().getEvents();
+  ASSERT_EQ(1, events.count());
+  EXPECT_STREQ("test", events.first().category);
+  EXPECT_STREQ("Scope", events.first().name);
+  EXPECT_EQ("details", events.first().details.toStdString());
+  EXPECT_GE(events.first().durationUs, 10000);
+}
+
+TEST_F(ProfilerTest, testCounter) {
+  Profiler::instance().setEnabled(true);
+  Profiler::instance().addCounter("test", "Counter", 42);
+  QList<Profiler::Event> events = Profiler::instance().getEvents();
+  ASSERT_EQ(1, events.count());
+  EXPECT_EQ(-1, events.first().durationUs);
+  EXPECT_EQ(42, events.first().memoryBefore);
+}
+
+TEST_F(ProfilerTest, testThreadIndex) {
+  Profiler::instance().setEnabled(true);
+  { ProfilerScope scope("test", "Main Thread"); }
+  QtConcurrent::run([]() { ProfilerScope scope("test", "Worker Thread"); })
+      .waitForFinished();
+  QList<Profiler::Event> events = Profiler::instance().getEvents();
+  ASSERT_EQ(2, events.count());
+  EXPECT_NE(events.at(0).threadIndex, events.at(1).threadIndex);
+}
+
+TEST_F(ProfilerTest, testChromeTraceJson) {
+  Profiler::instance().setEnabled(true);
+  { ProfilerScope scope("test", "Scope"); }
+  Profiler::instance().addCounter("test", "Counter", 42);
+  QJsonDocument doc =
+      QJsonDocument::fromJson(Profiler::instance().toChromeTraceJson());
+  QJsonArray    events = doc.object().value("traceEvents").toArray();
+  ASSERT_GE(events.count(), 2);
+  QJsonObject scope   = events.first().toObject();
+  QJsonObject counter = events.last().toObject();
+  EXPECT_EQ("Scope", scope.value("name").toString().toStdString());
+  EXPECT_EQ("X", scope.value("ph").toString().toStdString());
+  EXPECT_EQ("Counter", counter.value("name").toString().toStdString());
+  EXPECT_EQ("C", counter.value("ph").toString().toStdString());
+  EXPECT_EQ(42, counter.value("args").toObject().value("value").toInt());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
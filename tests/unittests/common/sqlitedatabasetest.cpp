@@ -164,6 +164,60 @@ TEST_F(SQLiteDatabaseTest, testInsert) {
   }
 }
 
+TEST_F(SQLiteDatabaseTest, testPrepareCachedQuery) {
+  SQLiteDatabase db(mTempDbFilePath);
+  db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
+  QString    sql    = "INSERT INTO test (name) VALUES (:name)";
+  QSqlQuery& cached = db.prepareCachedQuery(sql);
+  EXPECT_EQ(&cached, &db.prepareCachedQuery(sql));
+  for (int i = 0; i < 100; ++i) {
+    QSqlQuery& query = db.prepareCachedQuery(sql);
+    query.bindValue(":name", QString("row %1").arg(i));
+    int id = db.insert(query);
+    EXPECT_EQ(i + 1, id);
+  }
+}
+
+TEST_F(SQLiteDatabaseTest, testPrepareCachedQueryWithManyQueries) {
+  SQLiteDatabase db(mTempDbFilePath);
+  QString        sql    = "SELECT 42";
+  QSqlQuery*     cached = &db.prepareCachedQuery(sql);
+  for (int i = 0; i < 1000; ++i) {  // more than the cache can hold
+    QSqlQuery& query = db.prepareCachedQuery(QString("SELECT %1").arg(i));
+    db.exec(query);
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(i, query.value(0).toInt());
+    // recently used queries are kept in the cache
+    EXPECT_EQ(cached, &db.prepareCachedQuery(sql));
+  }
+}
+
+TEST_F(SQLiteDatabaseTest, testInsertRows) {
+  SQLiteDatabase db(mTempDbFilePath);
+  db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
+  QList<QVariantList> rows;
+  for (int i = 0; i < 1234; ++i) {  // needs multiple queries
+    rows.append(QVariantList{i + 1, QString("row %1").arg(i)});
+  }
+  db.insertRows("test", {"id", "name"}, rows);
+  QSqlQuery query = db.prepareQuery("SELECT id, name FROM test ORDER BY id");
+  db.exec(query);
+  for (int i = 0; i < rows.count(); ++i) {
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(i + 1, query.value(0).toInt());
+    EXPECT_EQ(QString("row %1").arg(i).toStdString(),
+              query.value(1).toString().toStdString());
+  }
+  EXPECT_FALSE(query.next());
+}
+
+TEST_F(SQLiteDatabaseTest, testSetJournalModeAndSynchronous) {
+  SQLiteDatabase db(mTempDbFilePath);
+  EXPECT_NO_THROW(db.setSynchronous(SQLiteDatabase::Synchronous::Normal));
+  EXPECT_NO_THROW(db.setJournalMode(SQLiteDatabase::JournalMode::Delete));
+  EXPECT_NO_THROW(db.setJournalMode(SQLiteDatabase::JournalMode::Wal));
+}
+
 TEST_F(SQLiteDatabaseTest, testClearExistingTable) {
   SQLiteDatabase db(mTempDbFilePath);
   db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
@@ -201,6 +255,24 @@ TEST_F(SQLiteDatabaseTest, testTransactionScopeGuardRollback) {
   EXPECT_THROW(db.clearTable("test"), Exception);
 }
 
+TEST_F(SQLiteDatabaseTest, testFts5Search) {
+  SQLiteDatabase db(mTempDbFilePath);
+  if (!db.isFts5Available()) {
+    qWarning() << "SQLite FTS5 not available, skipping test.";
+    return;
+  }
+  db.exec("CREATE VIRTUAL TABLE test USING fts5(name, prefix='2 3')");
+  db.exec("INSERT INTO test (name) VALUES ('resistor 0603')");
+  db.exec("INSERT INTO test (name) VALUES ('capacitor 0805')");
+  QSqlQuery query =
+      db.prepareQuery("SELECT name FROM test WHERE test MATCH :match");
+  query.bindValue(":match", "\"res\"* \"06\"*");
+  db.exec(query);
+  ASSERT_TRUE(query.next());
+  EXPECT_EQ("resistor 0603", query.value(0).toString().toStdString());
+  EXPECT_FALSE(query.next());
+}
+
 TEST_F(SQLiteDatabaseTest, testMultipleInstancesInSameThread) {
   SQLiteDatabase db1(mTempDbFilePath);
   SQLiteDatabase db2(mTempDbFilePath);
@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/unionfind.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class UnionFindTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(UnionFindTest, testDefaultConstructedIsEmpty) {
+  UnionFind<int> uf;
+  EXPECT_TRUE(uf.isEmpty());
+  EXPECT_EQ(0, uf.getItemCount());
+  EXPECT_EQ(0, uf.getSetCount());
+}
+
+TEST_F(UnionFindTest, testAddedItemsAreNotConnected) {
+  UnionFind<int> uf;
+  uf.add(1);
+  uf.add(2);
+  uf.add(2);
+  EXPECT_TRUE(uf.contains(1));
+  EXPECT_TRUE(uf.contains(2));
+  EXPECT_FALSE(uf.contains(3));
+  EXPECT_EQ(2, uf.getItemCount());
+  EXPECT_EQ(2, uf.getSetCount());
+  EXPECT_FALSE(uf.isConnected(1, 2));
+  EXPECT_TRUE(uf.isConnected(1, 1));
+}
+
+TEST_F(UnionFindTest, testUniteIsTransitive) {
+  UnionFind<int> uf;
+  uf.unite(1, 2);
+  uf.unite(3, 4);
+  EXPECT_EQ(4, uf.getItemCount());
+  EXPECT_EQ(2, uf.getSetCount());
+  EXPECT_TRUE(uf.isConnected(1, 2));
+  EXPECT_TRUE(uf.isConnected(4, 3));
+  EXPECT_FALSE(uf.isConnected(2, 3));
+  uf.unite(2, 4);
+  EXPECT_EQ(1, uf.getSetCount());
+  EXPECT_TRUE(uf.isConnected(1, 3));
+  uf.unite(1, 4);  // already connected
+  EXPECT_EQ(1, uf.getSetCount());
+}
+
+TEST_F(UnionFindTest, testIsConnectedAddsUnknownItems) {
+  UnionFind<int> uf;
+  EXPECT_FALSE(uf.isConnected(1, 2));
+  EXPECT_EQ(2, uf.getItemCount());
+  EXPECT_EQ(2, uf.getSetCount());
+}
+
+TEST_F(UnionFindTest, testClear) {
+  UnionFind<int> uf;
+  uf.unite(1, 2);
+  uf.clear();
+  EXPECT_TRUE(uf.isEmpty());
+  EXPECT_EQ(0, uf.getSetCount());
+  EXPECT_FALSE(uf.isConnected(1, 2));
+}
+
+TEST_F(UnionFindTest, testLongChain) {
+  UnionFind<int> uf;
+  for (int i = 0; i < 10000; ++i) {
+    uf.unite(i, i + 1);
+  }
+  EXPECT_EQ(10001, uf.getItemCount());
+  EXPECT_EQ(1, uf.getSetCount());
+  EXPECT_TRUE(uf.isConnected(0, 10000));
+  EXPECT_FALSE(uf.isConnected(0, 10001));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
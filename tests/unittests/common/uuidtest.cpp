@@ -144,12 +144,32 @@ TEST_P(UuidTest, testOperatorComparisons) {
   }
 }
 
+TEST_P(UuidTest, testQHash) {
+  const UuidTestData& data = GetParam();
+
+  if (data.valid) {
+    Uuid uuid1 = Uuid::fromString(data.uuid);
+    Uuid uuid2 = Uuid::fromString(data.uuid);
+    Uuid uuid3 =
+        Uuid::fromString("d2c30518-5cd1-4ce9-a569-44f783a3f66a");  // valid UUID
+    EXPECT_EQ(qHash(uuid1, 0), qHash(uuid2, 0));
+    EXPECT_EQ(qHash(uuid1, 42), qHash(uuid2, 42));
+    QHash<Uuid, int> hash;
+    hash.insert(uuid1, 1);
+    hash.insert(uuid3, 3);
+    EXPECT_EQ(2, hash.count());
+    EXPECT_EQ(1, hash.value(uuid2));
+    EXPECT_EQ(3, hash.value(uuid3));
+  }
+}
+
 TEST(UuidTest, testCreateRandom) {
   for (int i = 0; i < 1000; i++) {
     Uuid uuid = Uuid::createRandom();
     EXPECT_FALSE(uuid.toStr().isEmpty());
     EXPECT_EQ(QUuid::DCE, QUuid(uuid.toStr()).variant());
     EXPECT_EQ(QUuid::Random, QUuid(uuid.toStr()).version());
+    EXPECT_EQ(uuid, Uuid::fromString(uuid.toStr()));
   }
 }
 
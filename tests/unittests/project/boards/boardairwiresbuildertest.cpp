@@ -0,0 +1,176 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardairwiresbuilder.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardAirWiresBuilderTest : public ::testing::Test {
+protected:
+  static constexpr int sViaCount = 49;
+
+  FilePath                mProjectDir;
+  QScopedPointer<Project> mProject;
+  Board*                  mBoard;
+  NetSignal*              mNetSignal;
+  BI_NetSegment*          mSegment;
+  QList<BI_Via*>          mVias;
+
+  BoardAirWiresBuilderTest() {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject.reset(Project::create(mProjectDir.getPathTo("test.lpp")));
+    mBoard = mProject->createBoard(ElementName("board"));
+    mProject->addBoard(*mBoard);
+    Circuit& circuit = mProject->getCircuit();
+    mNetSignal = new NetSignal(circuit, *circuit.getNetClasses().first(),
+                               CircuitIdentifier("N"), false);
+    circuit.addNetSignal(*mNetSignal);
+    mSegment = new BI_NetSegment(*mBoard, *mNetSignal);
+    mBoard->addNetSegment(*mSegment);
+
+    // unconnected vias spread evenly but irregularly over 100x100mm
+    for (int i = 0; i < sViaCount; ++i) {
+      mVias.append(addVia(Point(
+          Length(qRound(std::fmod(i * 0.6180339887, 1.0) * 100000) * 1000),
+          Length(qRound(std::fmod(i * 0.7548776662, 1.0) * 100000) * 1000))));
+    }
+  }
+
+  virtual ~BoardAirWiresBuilderTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  BI_Via* addVia(const Point& position) {
+    BI_Via* via = new BI_Via(*mSegment, position, BI_Via::Shape::Round,
+                             PositiveLength(700000), PositiveLength(300000));
+    mSegment->addElements({via}, {}, {});
+    return via;
+  }
+
+  std::shared_ptr<BoardAirWiresBuilder> build(
+      const BoardAirWiresBuilder* previous = nullptr) {
+    auto builder = std::make_shared<BoardAirWiresBuilder>(*mBoard, *mNetSignal);
+    mAirWires    = builder->buildAirWires(previous);
+    return builder;
+  }
+
+  /**
+   * @brief Check the airwires of the last build against a full build
+   *
+   * Some vias have the same distance to each other, so the minimum spanning
+   * trees may differ in the chosen airwires, but not in their total length.
+   */
+  void expectSameAirWiresAsFullBuild() {
+    QVector<QPair<Point, Point>> airwires = mAirWires;
+    build();
+    EXPECT_EQ(getTotalLength(mAirWires), getTotalLength(airwires));
+    EXPECT_EQ(mAirWires.count(), airwires.count());
+  }
+
+  static qint64 getTotalLength(const QVector<QPair<Point, Point>>& airwires) {
+    qint64 length = 0;
+    foreach (const auto& airwire, airwires) {
+      length += (airwire.second - airwire.first).getLength().toNm();
+    }
+    return length;
+  }
+
+  QVector<QPair<Point, Point>> mAirWires;
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardAirWiresBuilderTest, testFullBuild) {
+  auto builder = build();
+  EXPECT_EQ(sViaCount, builder->getTriangulatedAnchorCount());
+  EXPECT_EQ(sViaCount - 1, mAirWires.count());
+}
+
+TEST_F(BoardAirWiresBuilderTest, testMoveViaUpdatesOnlyNeighbourhood) {
+  auto previous = build();
+  mVias[24]->setPosition(mVias[24]->getPosition() + Point(1000000, 500000));
+  auto builder = build(previous.get());
+  EXPECT_LT(builder->getTriangulatedAnchorCount(), sViaCount / 2);
+  expectSameAirWiresAsFullBuild();
+
+  // a further move is again based on the updated triangulation
+  mVias[30]->setPosition(mVias[30]->getPosition() - Point(500000, 200000));
+  builder = build(builder.get());
+  EXPECT_LT(builder->getTriangulatedAnchorCount(), sViaCount / 2);
+  expectSameAirWiresAsFullBuild();
+}
+
+TEST_F(BoardAirWiresBuilderTest, testAddViaUpdatesOnlyNeighbourhood) {
+  auto previous = build();
+  addVia(Point(33300000, 66600000));
+  auto builder = build(previous.get());
+  EXPECT_LT(builder->getTriangulatedAnchorCount(), sViaCount / 2);
+  expectSameAirWiresAsFullBuild();
+}
+
+TEST_F(BoardAirWiresBuilderTest, testRemoveViaUpdatesOnlyNeighbourhood) {
+  auto previous = build();
+  mSegment->removeElements({mVias[10]}, {}, {});
+  delete mVias.takeAt(10);
+  auto builder = build(previous.get());
+  EXPECT_LT(builder->getTriangulatedAnchorCount(), sViaCount / 2);
+  expectSameAirWiresAsFullBuild();
+}
+
+TEST_F(BoardAirWiresBuilderTest, testMoveViaOutsideFallsBackToFullBuild) {
+  auto previous = build();
+  mVias[0]->setPosition(Point(200000000, 200000000));
+  auto builder = build(previous.get());
+  EXPECT_EQ(sViaCount, builder->getTriangulatedAnchorCount());
+  expectSameAirWiresAsFullBuild();
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,280 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardgerberexport.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardGerberExportTest : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+
+  virtual void SetUp() override {
+    // copy the test project since the export writes into the project directory
+    mTempDir = FilePath::getApplicationTempPath().getPathTo(
+        "BoardGerberExportTest");
+    if (mTempDir.isExistingDir()) {
+      FileUtils::removeDirRecursively(mTempDir);  // can throw
+    }
+    FileUtils::copyDirRecursively(
+        FilePath(TEST_DATA_DIR
+                 "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest"
+                 "/test_project"),
+        mTempDir);  // can throw
+  }
+
+  virtual void TearDown() override {
+    FileUtils::removeDirRecursively(mTempDir);  // can throw
+  }
+
+  /**
+   * @brief Read all written files, without the lines depending on the time
+   *
+   * The creation date changes between two exports, and so does the MD5
+   * checksum of Gerber files.
+   */
+  static QMap<QString, QByteArray> readFiles(const QVector<FilePath>& files) {
+    QMap<QString, QByteArray> contents;
+    foreach (const FilePath& fp, files) {
+      QByteArray content;
+      foreach (const QByteArray& line, FileUtils::readFile(fp).split('\n')) {
+        if ((!line.contains("CreationDate")) &&
+            (!line.contains("Creation Date")) && (!line.contains("TF.MD5"))) {
+          content += line + '\n';
+        }
+      }
+      contents.insert(fp.getFilename(), content);
+    }
+    return contents;
+  }
+
+  static FilePath findFile(const QVector<FilePath>& files,
+                           const QString&           suffix) noexcept {
+    foreach (const FilePath& fp, files) {
+      if (fp.getFilename().endsWith(suffix)) {
+        return fp;
+      }
+    }
+    return FilePath();
+  }
+
+  /**
+   * @brief Read the lines from the first line starting with `first` up to the
+   *        next line starting with `last`, without the creation date
+   */
+  static std::string readLines(const FilePath& fp, const QString& first,
+                               const QString& last) {
+    QStringList lines;
+    bool        inRange = false;
+    foreach (const QString& line,
+             QString::fromLatin1(FileUtils::readFile(fp)).split('\n')) {
+      inRange = inRange || line.startsWith(first);
+      if (inRange && (!line.startsWith(";Creation Date"))) {
+        lines.append(line);
+      }
+      if (inRange && line.startsWith(last)) {
+        break;
+      }
+    }
+    return lines.join('\n').toStdString();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardGerberExportTest, testParallelExportEqualsSerialExport) {
+  QScopedPointer<Project> project(
+      new Project(mTempDir.getPathTo("test_project.lpp"), true, false));
+  Board*            board = project->getBoards().first();
+  BoardGerberExport exporter(*board);
+
+  // export in parallel
+  exporter.exportAllLayers();
+  QMap<QString, QByteArray> parallel = readFiles(exporter.getWrittenFiles());
+
+  // export again with a single worker thread, i.e. one file after the other
+  QThreadPool* pool           = QThreadPool::globalInstance();
+  int          maxThreadCount = pool->maxThreadCount();
+  pool->setMaxThreadCount(1);
+  exporter.exportAllLayers();
+  pool->setMaxThreadCount(maxThreadCount);
+  QMap<QString, QByteArray> serial = readFiles(exporter.getWrittenFiles());
+
+  EXPECT_GT(parallel.count(), 0);
+  EXPECT_EQ(parallel.keys(), serial.keys());
+  foreach (const QString& filename, parallel.keys()) {
+    EXPECT_EQ(parallel.value(filename).toStdString(),
+              serial.value(filename).toStdString())
+        << qPrintable(filename);
+  }
+}
+
+TEST_F(BoardGerberExportTest, testExportMatchesReference) {
+  // board with three vias of different drill diameters and two traces, all
+  // with fixed UUIDs to get a well-defined order of the items
+  QScopedPointer<Project> project(
+      Project::create(mTempDir.getPathTo("reference/reference.lpp")));
+  Board* board = project->createBoard(ElementName("board"));
+  project->addBoard(*board);
+  Circuit&   circuit   = project->getCircuit();
+  NetSignal* netsignal =
+      new NetSignal(circuit, *circuit.getNetClasses().first(),
+                    CircuitIdentifier("N"), false);
+  circuit.addNetSignal(*netsignal);
+  QString segment =
+      "(netsegment 00000000-0000-4000-8000-000000000000 (net %1)\n"
+      " (via 00000000-0000-4000-8000-000000000001 (position 10.0 20.0)"
+      " (size 0.7) (drill 0.3) (shape round))\n"
+      " (via 00000000-0000-4000-8000-000000000002 (position 30.0 40.0)"
+      " (size 0.7) (drill 0.4) (shape round))\n"
+      " (via 00000000-0000-4000-8000-000000000003 (position 50.5 60.0)"
+      " (size 0.7) (drill 0.5) (shape round))\n"
+      " (trace 00000000-0000-4000-8000-000000000004 (layer top_cu)"
+      " (width 0.25) (from (via 00000000-0000-4000-8000-000000000001))"
+      " (to (via 00000000-0000-4000-8000-000000000002)))\n"
+      " (trace 00000000-0000-4000-8000-000000000005 (layer top_cu)"
+      " (width 0.25) (from (via 00000000-0000-4000-8000-000000000002))"
+      " (to (via 00000000-0000-4000-8000-000000000003)))\n"
+      ")";
+  QByteArray content = segment.arg(netsignal->getUuid().toStr()).toUtf8();
+  board->addNetSegment(
+      *new BI_NetSegment(*board, SExpression::parse(content, FilePath())));
+
+  BoardGerberExport exporter(*board);
+  exporter.exportAllLayers();
+  const QVector<FilePath>& files = exporter.getWrittenFiles();
+
+  // no non-plated holes, so there must be no NPTH drill file
+  EXPECT_FALSE(findFile(files, "_DRILLS-NPTH.drl").isValid());
+
+  FilePath fp = findFile(files, "_DRILLS-PTH.drl");
+  ASSERT_TRUE(fp.isValid());
+  QStringList expected = {
+      "M48",
+      ";DRILL FILE",
+      QString(";Generated by LibrePCB %1").arg(qApp->applicationVersion()),
+      "FMAT,2",
+      "METRIC,TZ",
+      "T1C0.3",
+      "T2C0.4",
+      "T3C0.5",
+      "%",
+      "G90",
+      "G05",
+      "M71",
+      "T1",
+      "X10.0Y20.0",
+      "T2",
+      "X30.0Y40.0",
+      "T3",
+      "X50.5Y60.0",
+      "T0",
+      "M30",
+  };
+  EXPECT_EQ(expected.join('\n').toStdString(), readLines(fp, "M48", "M30"));
+
+  // the default board outline is a 100x80mm rectangle
+  fp = findFile(files, "_OUTLINES.gbr");
+  ASSERT_TRUE(fp.isValid());
+  expected = {
+      "G04 --- APERTURE LIST BEGIN --- *",
+      "%ADD10C,0.001*%",
+      "G04 --- APERTURE LIST END --- *",
+      "G04 --- BOARD BEGIN --- *",
+      "D10*",
+      "X0Y0D02*",
+      "X100000000Y0D01*",
+      "X100000000Y80000000D01*",
+      "X0Y80000000D01*",
+      "X0Y0D01*",
+      "G04 --- BOARD END --- *",
+  };
+  EXPECT_EQ(expected.join('\n').toStdString(),
+            readLines(fp, "G04 --- APERTURE LIST BEGIN", "G04 --- BOARD END"));
+
+  fp = findFile(files, "_COPPER-TOP.gbr");
+  ASSERT_TRUE(fp.isValid());
+  expected = {
+      "G04 --- APERTURE LIST BEGIN --- *",
+      "%ADD10C,0.7*%",
+      "%ADD11C,0.25*%",
+      "G04 --- APERTURE LIST END --- *",
+      "G04 --- BOARD BEGIN --- *",
+      "D10*",
+      "X10000000Y20000000D03*",
+      "X30000000Y40000000D03*",
+      "X50500000Y60000000D03*",
+      "D11*",
+      "X10000000Y20000000D02*",
+      "X30000000Y40000000D01*",
+      "X30000000Y40000000D02*",
+      "X50500000Y60000000D01*",
+      "G04 --- BOARD END --- *",
+  };
+  EXPECT_EQ(expected.join('\n').toStdString(),
+            readLines(fp, "G04 --- APERTURE LIST BEGIN", "G04 --- BOARD END"));
+
+  fp = findFile(files, "_COPPER-BOTTOM.gbr");
+  ASSERT_TRUE(fp.isValid());
+  expected = {
+      "G04 --- APERTURE LIST BEGIN --- *",
+      "%ADD10C,0.7*%",
+      "G04 --- APERTURE LIST END --- *",
+      "G04 --- BOARD BEGIN --- *",
+      "D10*",
+      "X10000000Y20000000D03*",
+      "X30000000Y40000000D03*",
+      "X50500000Y60000000D03*",
+      "G04 --- BOARD END --- *",
+  };
+  EXPECT_EQ(expected.join('\n').toStdString(),
+            readLines(fp, "G04 --- APERTURE LIST BEGIN", "G04 --- BOARD END"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
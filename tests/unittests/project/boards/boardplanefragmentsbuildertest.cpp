@@ -23,7 +23,10 @@
 #include <gtest/gtest.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
 #include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/boards/items/bi_via.h>
 #include <librepcb/project/project.h>
 
 #include <QtCore>
@@ -103,6 +106,49 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expectedPlaneFragments, actualPlaneFragments);
 }
 
+TEST(BoardPlaneFragmentsBuilderTest, testIncrementalRebuild) {
+  FilePath testDataDir(
+      TEST_DATA_DIR
+      "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest");
+
+  // open project from test data directory
+  FilePath projectFp = testDataDir.getPathTo("test_project/test_project.lpp");
+  QScopedPointer<Project> project(new Project(projectFp, true, false));
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+
+  // move some items and rebuild only the affected planes
+  foreach (BI_NetSegment* netsegment, board->getNetSegments()) {
+    foreach (BI_Via* via, netsegment->getVias()) {
+      via->setPosition(via->getPosition() + Point(500000, 200000));
+    }
+    foreach (BI_NetPoint* netpoint, netsegment->getNetPoints()) {
+      netpoint->setPosition(netpoint->getPosition() + Point(-300000, 100000));
+    }
+  }
+  board->rebuildDirtyPlanes();
+  QMap<Uuid, QVector<Path>> incrementalPlaneFragments;
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    incrementalPlaneFragments[plane->getUuid()] = plane->getFragments();
+  }
+
+  // rebuilding only the dirty planes must not change anything now
+  board->rebuildDirtyPlanes();
+  QMap<Uuid, QVector<Path>> unchangedPlaneFragments;
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    unchangedPlaneFragments[plane->getUuid()] = plane->getFragments();
+  }
+  EXPECT_EQ(incrementalPlaneFragments, unchangedPlaneFragments);
+
+  // the result must be identical to a complete rebuild
+  board->rebuildAllPlanes();
+  QMap<Uuid, QVector<Path>> actualPlaneFragments;
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    actualPlaneFragments[plane->getUuid()] = plane->getFragments();
+  }
+  EXPECT_EQ(actualPlaneFragments, incrementalPlaneFragments);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,193 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardspatialindex.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_hole.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardSpatialIndexTest : public ::testing::Test {
+protected:
+  FilePath getProjectFilePath() const noexcept {
+    return FilePath(TEST_DATA_DIR
+                    "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest"
+                    "/test_project/test_project.lpp");
+  }
+
+  static QList<BI_Base*> getItemsInBoardOrder(const Board& board) noexcept {
+    QList<BI_Base*> items;
+    foreach (BI_Plane* plane, board.getPlanes()) { items.append(plane); }
+    foreach (BI_Polygon* polygon, board.getPolygons()) {
+      items.append(polygon);
+    }
+    foreach (BI_Hole* hole, board.getHoles()) { items.append(hole); }
+    return items;
+  }
+
+  /**
+   * @brief Check if all planes, polygons and holes in a query result appear in
+   *        the same order as in the board's item lists
+   *
+   * @return Number of checked items
+   */
+  template <typename T>
+  static int expectBoardOrder(const Board& board, const T& result) noexcept {
+    QList<BI_Base*> boardOrder = getItemsInBoardOrder(board);
+    int             lastIndex  = -1;
+    int             count      = 0;
+    foreach (BI_Base* item, result) {
+      int index = boardOrder.indexOf(item);
+      if (index >= 0) {
+        EXPECT_GT(index, lastIndex);
+        lastIndex = index;
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * @brief Check if netpoints appear in the order of the board's netsegment
+   *        list and the netpoint lists of the netsegments
+   */
+  static void expectNetSegmentOrder(const Board&               board,
+                                    const QList<BI_NetPoint*>& result) {
+    QPair<int, int> last(-1, -1);
+    foreach (BI_NetPoint* netpoint, result) {
+      BI_NetSegment&  segment = netpoint->getNetSegment();
+      QPair<int, int> key(board.getNetSegments().indexOf(&segment),
+                          segment.getNetPoints().indexOf(netpoint));
+      EXPECT_LT(last, key);
+      last = key;
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardSpatialIndexTest, testGetItemsInRectReturnsBoardOrder) {
+  QScopedPointer<Project> project(
+      new Project(getProjectFilePath(), true, false));
+  Board* board = project->getBoards().first();
+  int    count = 0;
+  foreach (BI_Base* item, getItemsInBoardOrder(*board)) {
+    QRectF            rect = item->getGrabAreaScenePx().boundingRect();
+    QVector<BI_Base*> result = board->getSpatialIndex().getItemsInRect(rect);
+    count += expectBoardOrder(*board, result);
+    // the result must not change between queries
+    EXPECT_EQ(result, board->getSpatialIndex().getItemsInRect(rect));
+  }
+  EXPECT_GT(count, 0);
+}
+
+TEST_F(BoardSpatialIndexTest, testGetItemsAtScenePosReturnsBoardOrder) {
+  QScopedPointer<Project> project(
+      new Project(getProjectFilePath(), true, false));
+  Board* board = project->getBoards().first();
+  int    count = 0;
+  foreach (BI_Base* item, getItemsInBoardOrder(*board)) {
+    QRectF          rect   = item->getGrabAreaScenePx().boundingRect();
+    Point           pos    = Point::fromPx(rect.center());
+    QList<BI_Base*> result = board->getItemsAtScenePos(pos);
+    count += expectBoardOrder(*board, result);
+    EXPECT_EQ(result, board->getItemsAtScenePos(pos));
+  }
+  EXPECT_GT(count, 0);
+}
+
+TEST_F(BoardSpatialIndexTest, testGetNetPointsAtScenePosReturnsBoardOrder) {
+  QScopedPointer<Project> project(
+      new Project(getProjectFilePath(), true, false));
+  Board* board = project->getBoards().first();
+
+  // find a netpoint with netlines in one netsegment, and any netpoint of
+  // another netsegment
+  BI_NetPoint* start  = nullptr;
+  BI_NetPoint* target = nullptr;
+  foreach (BI_NetSegment* segment, board->getNetSegments()) {
+    foreach (BI_NetPoint* netpoint, segment->getNetPoints()) {
+      if (!netpoint->getLayerOfLines()) {
+        continue;
+      } else if (!start) {
+        start = netpoint;
+      } else if (segment != &start->getNetSegment()) {
+        target = netpoint;
+      }
+    }
+  }
+  ASSERT_TRUE(start && target);
+
+  // add a netpoint at the position of the target netpoint to the netsegment
+  // of the start netpoint, i.e. it is inserted into the spatial index after
+  // the target
+  BI_NetSegment& startSegment = start->getNetSegment();
+  Point          pos          = target->getPosition();
+  BI_NetPoint*   netpoint     = new BI_NetPoint(startSegment, pos);
+  BI_NetLine*    netline      = new BI_NetLine(
+      startSegment, *start, *netpoint, *start->getLayerOfLines(),
+      PositiveLength(100000));
+  startSegment.addElements({}, {netpoint}, {netline});
+
+  // the added netpoint must still be returned before the target
+  QList<BI_NetPoint*> result =
+      board->getNetPointsAtScenePos(pos, nullptr, nullptr);
+  ASSERT_TRUE(result.contains(netpoint));
+  ASSERT_TRUE(result.contains(target));
+  EXPECT_LT(result.indexOf(netpoint), result.indexOf(target));
+  expectNetSegmentOrder(*board, result);
+  foreach (BI_NetSegment* segment, board->getNetSegments()) {
+    foreach (BI_NetPoint* np, segment->getNetPoints()) {
+      expectNetSegmentOrder(*board, board->getNetPointsAtScenePos(
+                                        np->getPosition(), nullptr, nullptr));
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,155 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BI_NetSegmentTest : public ::testing::Test {
+protected:
+  FilePath                mProjectDir;
+  QScopedPointer<Project> mProject;
+  Board*                  mBoard;
+  BI_NetSegment*          mSegment;
+
+  BI_NetSegmentTest() {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject.reset(Project::create(mProjectDir.getPathTo("test.lpp")));
+    mBoard = mProject->createBoard(ElementName("board"));
+    mProject->addBoard(*mBoard);
+    Circuit&   circuit   = mProject->getCircuit();
+    NetSignal* netsignal =
+        new NetSignal(circuit, *circuit.getNetClasses().first(),
+                      CircuitIdentifier("N"), false);
+    circuit.addNetSignal(*netsignal);
+    mSegment = new BI_NetSegment(*mBoard, *netsignal);
+    mBoard->addNetSegment(*mSegment);
+  }
+
+  virtual ~BI_NetSegmentTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  BI_NetPoint* newNetPoint() {
+    return new BI_NetPoint(*mSegment, Point(0, 0));
+  }
+
+  BI_NetLine* newNetLine(BI_NetPoint* start, BI_NetPoint* end) {
+    GraphicsLayer* layer =
+        mBoard->getLayerStack().getLayer(GraphicsLayer::sTopCopper);
+    return new BI_NetLine(*mSegment, *start, *end, *layer,
+                          PositiveLength(100000));
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BI_NetSegmentTest, testAddConnectedElements) {
+  BI_NetPoint* np1 = newNetPoint();
+  BI_NetPoint* np2 = newNetPoint();
+  BI_NetPoint* np3 = newNetPoint();
+  mSegment->addElements({}, {np1, np2}, {newNetLine(np1, np2)});
+  mSegment->addElements({}, {np3}, {newNetLine(np2, np3)});
+  EXPECT_EQ(3, mSegment->getNetPoints().count());
+  EXPECT_EQ(2, mSegment->getNetLines().count());
+}
+
+TEST_F(BI_NetSegmentTest, testAddUnconnectedElementsIsRolledBack) {
+  BI_NetPoint* np1 = newNetPoint();
+  BI_NetPoint* np2 = newNetPoint();
+  mSegment->addElements({}, {np1, np2}, {newNetLine(np1, np2)});
+
+  // np3 gets connected incrementally, but np4 is not connected
+  BI_NetPoint* np3 = newNetPoint();
+  BI_NetPoint* np4 = newNetPoint();
+  BI_NetLine*  nl  = newNetLine(np2, np3);
+  EXPECT_THROW(mSegment->addElements({}, {np3, np4}, {nl}), LogicError);
+  EXPECT_EQ(2, mSegment->getNetPoints().count());
+  EXPECT_EQ(1, mSegment->getNetLines().count());
+
+  // the connection of np3 must have been rolled back as well
+  EXPECT_THROW(mSegment->addElements({}, {np3}, {}), LogicError);
+  EXPECT_EQ(2, mSegment->getNetPoints().count());
+
+  // connected elements can still be added
+  mSegment->addElements({}, {np3}, {nl});
+  EXPECT_EQ(3, mSegment->getNetPoints().count());
+  EXPECT_EQ(2, mSegment->getNetLines().count());
+  delete np4;
+}
+
+TEST_F(BI_NetSegmentTest, testRemoveElements) {
+  BI_NetPoint* np1 = newNetPoint();
+  BI_NetPoint* np2 = newNetPoint();
+  BI_NetPoint* np3 = newNetPoint();
+  BI_NetLine*  nl1 = newNetLine(np1, np2);
+  BI_NetLine*  nl2 = newNetLine(np2, np3);
+  mSegment->addElements({}, {np1, np2, np3}, {nl1, nl2});
+
+  // removing a netline in the middle splits the segment
+  EXPECT_THROW(mSegment->removeElements({}, {}, {nl1}), LogicError);
+  EXPECT_EQ(3, mSegment->getNetPoints().count());
+  EXPECT_EQ(2, mSegment->getNetLines().count());
+
+  // removing a netline at the end together with its netpoint is fine
+  mSegment->removeElements({}, {np3}, {nl2});
+  EXPECT_EQ(2, mSegment->getNetPoints().count());
+  EXPECT_EQ(1, mSegment->getNetLines().count());
+
+  // the removed connection of np3 must not be remembered
+  EXPECT_THROW(mSegment->addElements({}, {np3}, {}), LogicError);
+  EXPECT_EQ(2, mSegment->getNetPoints().count());
+  mSegment->addElements({}, {np3}, {nl2});
+  EXPECT_EQ(3, mSegment->getNetPoints().count());
+  EXPECT_EQ(2, mSegment->getNetLines().count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -117,6 +117,37 @@ TEST_F(ProjectLibraryTest, testLoadSymbol) {
             mExistingSymbolFile.size());  // not upgraded
 }
 
+TEST_F(ProjectLibraryTest, testLoadManySymbols) {
+  QSet<Uuid> uuids = {Uuid::fromString(mExistingSymbolFile.dir().dirName())};
+  for (int i = 0; i < 20; ++i) {
+    library::Symbol sym(Uuid::createRandom(), Version::fromString("1"), "",
+                        ElementName("Symbol"), "", "");
+    sym.saveIntoParentDirectory(mLibDir.getPathTo("sym"));
+    uuids.insert(sym.getUuid());
+  }
+  ProjectLibrary lib(mLibDir, false, false);
+  EXPECT_TRUE(uuids == lib.getSymbols().keys().toSet());
+  foreach (const library::Symbol* sym, lib.getSymbols()) {
+    EXPECT_EQ(QThread::currentThread(), sym->thread());
+  }
+}
+
+TEST_F(ProjectLibraryTest, testLoadSymbolInPlace) {
+  ProjectLibrary lib(mLibDir, false, false);
+  EXPECT_EQ(FilePath(mExistingSymbolFile.absolutePath()),
+            getFirstSymbol(lib)->getFilePath());  // not copied
+}
+
+TEST_F(ProjectLibraryTest, testRemoveSymbol_SaveToOriginal_DetachesSymbol) {
+  ProjectLibrary   lib(mLibDir, false, false);
+  library::Symbol* sym = getFirstSymbol(lib);
+  lib.removeSymbol(*sym);
+  saveToOriginal(lib);
+  EXPECT_FALSE(mExistingSymbolFile.exists());
+  EXPECT_FALSE(sym->getFilePath().isLocatedInDir(mLibDir));
+  EXPECT_TRUE(sym->getFilePath().getPathTo("symbol.lp").isExistingFile());
+}
+
 TEST_F(ProjectLibraryTest, testAddSymbol) {
   {
     ProjectLibrary lib(mLibDir, false, false);
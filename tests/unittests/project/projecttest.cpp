@@ -21,8 +21,11 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/project/boards/board.h>
 #include <librepcb/project/metadata/projectmetadata.h>
 #include <librepcb/project/project.h>
+#include <librepcb/project/schematics/schematic.h>
 
 #include <QtCore>
 
@@ -182,6 +185,101 @@ TEST_F(ProjectTest, testSettersGetters) {
   EXPECT_EQ(version, project->getMetadata().getVersion());
 }
 
+TEST_F(ProjectTest, testOpenHeadless) {
+  // create new project with a schematic and a board
+  QScopedPointer<Project> project(Project::create(mProjectFile));
+  EXPECT_FALSE(project->isHeadless());
+  project->addSchematic(*project->createSchematic(ElementName("schematic")));
+  project->addBoard(*project->createBoard(ElementName("board")));
+  project->save(true);
+
+  // close and re-open project (headless)
+  project.reset();
+  project.reset(new Project(mProjectFile, true, false, true));
+  EXPECT_TRUE(project->isHeadless());
+  EXPECT_EQ(1, project->getSchematics().count());
+  EXPECT_EQ(1, project->getBoards().count());
+  EXPECT_THROW(project->exportSchematicsAsPdf(
+                   mProjectDir.getPathTo("output/schematics.pdf")),
+               LogicError);
+}
+
+TEST_F(ProjectTest, testOpenMultipleSchematicsAndBoards) {
+  // create new project with several schematics and boards
+  QScopedPointer<Project> project(Project::create(mProjectFile));
+  QList<Uuid>             schematics;
+  QList<Uuid>             boards;
+  for (int i = 0; i < 5; ++i) {
+    Schematic* schematic =
+        project->createSchematic(ElementName(QString("schematic %1").arg(i)));
+    project->addSchematic(*schematic);
+    schematics.append(schematic->getUuid());
+    Board* board =
+        project->createBoard(ElementName(QString("board %1").arg(i)));
+    project->addBoard(*board);
+    boards.append(board->getUuid());
+  }
+  project->save(true);
+
+  // close and re-open project (files are parsed in parallel)
+  project.reset();
+  project.reset(new Project(mProjectFile, false, false, true));
+  ASSERT_EQ(schematics.count(), project->getSchematics().count());
+  ASSERT_EQ(boards.count(), project->getBoards().count());
+  for (int i = 0; i < schematics.count(); ++i) {
+    EXPECT_EQ(schematics.at(i), project->getSchematics().at(i)->getUuid());
+    EXPECT_EQ(QString("schematic %1").arg(i),
+              *project->getSchematics().at(i)->getName());
+  }
+  for (int i = 0; i < boards.count(); ++i) {
+    EXPECT_EQ(boards.at(i), project->getBoards().at(i)->getUuid());
+    EXPECT_EQ(QString("board %1").arg(i),
+              *project->getBoards().at(i)->getName());
+  }
+
+  // the files opened in the worker threads must be usable for saving
+  project->save(false);
+  project->save(true);
+  project.reset();
+  project.reset(new Project(mProjectFile, true, false, true));
+  EXPECT_EQ(schematics.count(), project->getSchematics().count());
+  EXPECT_EQ(boards.count(), project->getBoards().count());
+}
+
+TEST_F(ProjectTest, testOpenWithInvalidSchematicOrBoardFile) {
+  // create new project with several schematics and boards
+  QScopedPointer<Project> project(Project::create(mProjectFile));
+  QList<FilePath>         files;
+  for (int i = 0; i < 3; ++i) {
+    Schematic* schematic =
+        project->createSchematic(ElementName(QString("schematic %1").arg(i)));
+    project->addSchematic(*schematic);
+    files.append(schematic->getFilePath());
+    Board* board =
+        project->createBoard(ElementName(QString("board %1").arg(i)));
+    project->addBoard(*board);
+    files.append(board->getFilePath());
+  }
+  project->save(true);
+  project.reset();
+
+  // opening must fail if any file can't be parsed in its worker thread
+  foreach (const FilePath& fp, files) {
+    QByteArray content = FileUtils::readFile(fp);
+    FileUtils::writeFile(fp, QByteArray("(invalid"));
+    EXPECT_THROW(project.reset(new Project(mProjectFile, false, false, true)),
+                 Exception)
+        << qPrintable(fp.toNative());
+    EXPECT_TRUE(project.isNull());
+    FileUtils::writeFile(fp, content);
+  }
+
+  // afterwards the project can still be opened (e.g. not locked anymore)
+  project.reset(new Project(mProjectFile, false, false, true));
+  EXPECT_EQ(3, project->getSchematics().count());
+  EXPECT_EQ(3, project->getBoards().count());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,151 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/schematics/items/si_netline.h>
+#include <librepcb/project/schematics/items/si_netpoint.h>
+#include <librepcb/project/schematics/items/si_netsegment.h>
+#include <librepcb/project/schematics/schematic.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SI_NetSegmentTest : public ::testing::Test {
+protected:
+  FilePath                mProjectDir;
+  QScopedPointer<Project> mProject;
+  Schematic*              mSchematic;
+  SI_NetSegment*          mSegment;
+
+  SI_NetSegmentTest() {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject.reset(Project::create(mProjectDir.getPathTo("test.lpp")));
+    mSchematic = mProject->createSchematic(ElementName("schematic"));
+    mProject->addSchematic(*mSchematic);
+    Circuit&   circuit   = mProject->getCircuit();
+    NetSignal* netsignal =
+        new NetSignal(circuit, *circuit.getNetClasses().first(),
+                      CircuitIdentifier("N"), false);
+    circuit.addNetSignal(*netsignal);
+    mSegment = new SI_NetSegment(*mSchematic, *netsignal);
+    mSchematic->addNetSegment(*mSegment);
+  }
+
+  virtual ~SI_NetSegmentTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  SI_NetPoint* newNetPoint() {
+    return new SI_NetPoint(*mSegment, Point(0, 0));
+  }
+
+  SI_NetLine* newNetLine(SI_NetPoint* start, SI_NetPoint* end) {
+    return new SI_NetLine(*mSegment, *start, *end, UnsignedLength(158750));
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SI_NetSegmentTest, testAddConnectedElements) {
+  SI_NetPoint* np1 = newNetPoint();
+  SI_NetPoint* np2 = newNetPoint();
+  SI_NetPoint* np3 = newNetPoint();
+  mSegment->addNetPointsAndNetLines({np1, np2}, {newNetLine(np1, np2)});
+  mSegment->addNetPointsAndNetLines({np3}, {newNetLine(np2, np3)});
+  EXPECT_EQ(3, mSegment->getNetPoints().count());
+  EXPECT_EQ(2, mSegment->getNetLines().count());
+}
+
+TEST_F(SI_NetSegmentTest, testAddUnconnectedElementsIsRolledBack) {
+  SI_NetPoint* np1 = newNetPoint();
+  SI_NetPoint* np2 = newNetPoint();
+  mSegment->addNetPointsAndNetLines({np1, np2}, {newNetLine(np1, np2)});
+
+  // np3 gets connected incrementally, but np4 is not connected
+  SI_NetPoint* np3 = newNetPoint();
+  SI_NetPoint* np4 = newNetPoint();
+  SI_NetLine*  nl  = newNetLine(np2, np3);
+  EXPECT_THROW(mSegment->addNetPointsAndNetLines({np3, np4}, {nl}),
+               LogicError);
+  EXPECT_EQ(2, mSegment->getNetPoints().count());
+  EXPECT_EQ(1, mSegment->getNetLines().count());
+
+  // the connection of np3 must have been rolled back as well
+  EXPECT_THROW(mSegment->addNetPointsAndNetLines({np3}, {}), LogicError);
+  EXPECT_EQ(2, mSegment->getNetPoints().count());
+
+  // connected elements can still be added
+  mSegment->addNetPointsAndNetLines({np3}, {nl});
+  EXPECT_EQ(3, mSegment->getNetPoints().count());
+  EXPECT_EQ(2, mSegment->getNetLines().count());
+  delete np4;
+}
+
+TEST_F(SI_NetSegmentTest, testRemoveElements) {
+  SI_NetPoint* np1 = newNetPoint();
+  SI_NetPoint* np2 = newNetPoint();
+  SI_NetPoint* np3 = newNetPoint();
+  SI_NetLine*  nl1 = newNetLine(np1, np2);
+  SI_NetLine*  nl2 = newNetLine(np2, np3);
+  mSegment->addNetPointsAndNetLines({np1, np2, np3}, {nl1, nl2});
+
+  // removing a netline in the middle splits the segment
+  EXPECT_THROW(mSegment->removeNetPointsAndNetLines({}, {nl1}), LogicError);
+  EXPECT_EQ(3, mSegment->getNetPoints().count());
+  EXPECT_EQ(2, mSegment->getNetLines().count());
+
+  // removing a netline at the end together with its netpoint is fine
+  mSegment->removeNetPointsAndNetLines({np3}, {nl2});
+  EXPECT_EQ(2, mSegment->getNetPoints().count());
+  EXPECT_EQ(1, mSegment->getNetLines().count());
+
+  // the removed connection of np3 must not be remembered
+  EXPECT_THROW(mSegment->addNetPointsAndNetLines({np3}, {}), LogicError);
+  EXPECT_EQ(2, mSegment->getNetPoints().count());
+  mSegment->addNetPointsAndNetLines({np3}, {nl2});
+  EXPECT_EQ(3, mSegment->getNetPoints().count());
+  EXPECT_EQ(2, mSegment->getNetLines().count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -32,6 +32,7 @@ LIBS += \
 
 INCLUDEPATH += \
     ../../libs \
+    ../../libs/fontobene \
     ../../libs/googletest/googletest/include \
     ../../libs/googletest/googlemock/include \
     ../../libs/parseagle \
@@ -65,19 +66,24 @@ SOURCES += \
     common/angletest.cpp \
     common/applicationtest.cpp \
     common/attributes/attributesubstitutortest.cpp \
+    common/cam/gerbergeneratortest.cpp \
     common/directorylocktest.cpp \
     common/filedownloadtest.cpp \
     common/fileio/serializableobjectlisttest.cpp \
+    common/fileio/sexpressiontest.cpp \
     common/filepathtest.cpp \
+    common/font/strokefontcachetest.cpp \
     common/lengthsnaptest.cpp \
     common/lengthtest.cpp \
     common/networkrequesttest.cpp \
     common/pointtest.cpp \
+    common/profilertest.cpp \
     common/ratiotest.cpp \
     common/scopeguardtest.cpp \
     common/sqlitedatabasetest.cpp \
     common/systeminfotest.cpp \
     common/toolboxtest.cpp \
+    common/utils/unionfindtest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     eagleimport/deviceconvertertest.cpp \
@@ -87,9 +93,16 @@ SOURCES += \
     library/componentsymbolvariantitemtest.cpp \
     library/librarybaseelementtest.cpp \
     main.cpp \
+    project/boards/boardairwiresbuildertest.cpp \
+    project/boards/boardgerberexporttest.cpp \
     project/boards/boardplanefragmentsbuildertest.cpp \
+    project/boards/boardspatialindextest.cpp \
+    project/boards/items/bi_netsegmenttest.cpp \
     project/library/projectlibrarytest.cpp \
     project/projecttest.cpp \
+    project/schematics/items/si_netsegmenttest.cpp \
+    workspace/library/workspacelibrarydbtest.cpp \
+    workspace/library/workspacelibraryscannertest.cpp \
     workspace/workspacetest.cpp \
 
 HEADERS += \
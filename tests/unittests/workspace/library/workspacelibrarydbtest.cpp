@@ -0,0 +1,206 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/workspace.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryDbTest : public ::testing::Test {
+protected:
+  FilePath                       mWsDir;
+  QScopedPointer<Workspace>      mWs;
+  QScopedPointer<SQLiteDatabase> mDb;
+  Uuid                           mResistor;   ///< Named "Resistor"
+  Uuid                           mCapacitor;  ///< Description has "resistor"
+  Uuid                           mVaristor;   ///< Named "Unresistor"
+  Uuid                           mDiode;      ///< Device named "Zener Diode"
+
+  WorkspaceLibraryDbTest()
+    : mResistor(Uuid::createRandom()),
+      mCapacitor(Uuid::createRandom()),
+      mVaristor(Uuid::createRandom()),
+      mDiode(Uuid::createRandom()) {
+    mWsDir = FilePath::getRandomTempPath();
+    Workspace::createNewWorkspace(mWsDir);  // can throw
+    mWs.reset(new Workspace(mWsDir));       // can throw
+    mDb.reset(new SQLiteDatabase(mWs->getLibraryDb().getFilePath()));
+
+    addComponent(mResistor, "Resistor", "", "0603,smd");
+    addComponent(mCapacitor, "Capacitor", "Not a resistor, a capacitor", "");
+    addComponent(mVaristor, "Unresistor", "", "");
+    addComponent(mDiode, "Diode", "", "");
+    addDevice(mDiode, "Zener Diode", "sod-123");
+    // some unrelated elements to get reasonable BM25 scores
+    for (int i = 0; i < 5; ++i) {
+      addComponent(Uuid::createRandom(), QString("Transistor %1").arg(i), "",
+                   "");
+    }
+  }
+
+  virtual ~WorkspaceLibraryDbTest() {
+    mDb.reset();
+    mWs.reset();
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  void addComponent(const Uuid& uuid, const QString& name,
+                    const QString& description, const QString& keywords) {
+    QSqlQuery query = mDb->prepareQuery(
+        "INSERT INTO components "
+        "(lib_id, filepath, file_mtime, file_size, file_hash, uuid, version) "
+        "VALUES (0, :filepath, 0, 0, '', :uuid, '0.1')");
+    query.bindValue(":filepath", uuid.toStr());
+    query.bindValue(":uuid", uuid.toStr());
+    int id = mDb->insert(query);
+    addTranslation("components", "component_id", id, name, description,
+                   keywords);
+  }
+
+  void addDevice(const Uuid& component, const QString& name,
+                 const QString& keywords) {
+    Uuid      uuid  = Uuid::createRandom();
+    QSqlQuery query = mDb->prepareQuery(
+        "INSERT INTO devices "
+        "(lib_id, filepath, file_mtime, file_size, file_hash, uuid, version, "
+        "component_uuid, package_uuid) "
+        "VALUES (0, :filepath, 0, 0, '', :uuid, '0.1', :component, :package)");
+    query.bindValue(":filepath", uuid.toStr());
+    query.bindValue(":uuid", uuid.toStr());
+    query.bindValue(":component", component.toStr());
+    query.bindValue(":package", Uuid::createRandom().toStr());
+    int id = mDb->insert(query);
+    addTranslation("devices", "device_id", id, name, "", keywords);
+  }
+
+  void addTranslation(const QString& table, const QString& idColumn, int id,
+                      const QString& name, const QString& description,
+                      const QString& keywords) {
+    QSqlQuery query = mDb->prepareQuery(
+        "INSERT INTO " % table % "_tr (" % idColumn %
+        ", locale, name, description, keywords) "
+        "VALUES (:id, '', :name, :description, :keywords)");
+    query.bindValue(":id", id);
+    query.bindValue(":name", name);
+    query.bindValue(":description", description);
+    query.bindValue(":keywords", keywords);
+    mDb->insert(query);
+  }
+
+  bool hasFullTextIndex() {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT COUNT(*) FROM sqlite_master WHERE name = 'components_fts'");
+    mDb->exec(query);
+    return query.next() && (query.value(0).toInt() > 0);
+  }
+
+  void dropFullTextIndex() {
+    foreach (const QString& table, QStringList{"components", "devices"}) {
+      mDb->exec("DROP TRIGGER IF EXISTS " % table % "_tr_ai");
+      mDb->exec("DROP TRIGGER IF EXISTS " % table % "_tr_ad");
+      mDb->exec("DROP TRIGGER IF EXISTS " % table % "_tr_au");
+      mDb->exec("DROP TABLE IF EXISTS " % table % "_fts");
+    }
+  }
+
+  static QSet<Uuid> toSet(const QList<Uuid>& list) noexcept {
+    return QSet<Uuid>::fromList(list);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testToFullTextQuery) {
+  EXPECT_EQ("", WorkspaceLibraryDb::toFullTextQuery({}).toStdString());
+  EXPECT_EQ("\"res\"* \"06\"*",
+            WorkspaceLibraryDb::toFullTextQuery({"res", "06"}).toStdString());
+  // FTS5 query syntax must be escaped
+  EXPECT_EQ("\"a\"\"b\"* \"OR\"* \"NEAR(\"*",
+            WorkspaceLibraryDb::toFullTextQuery({"a\"b", "OR", "NEAR("})
+                .toStdString());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchEmpty) {
+  const WorkspaceLibraryDb& db = mWs->getLibraryDb();
+  EXPECT_EQ(QList<Uuid>(), db.searchComponents(""));
+  EXPECT_EQ(QList<Uuid>(), db.searchComponents(" ,;- "));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchRanking) {
+  if (!hasFullTextIndex()) {
+    qWarning() << "SQLite FTS5 not available, skipping test.";
+    return;
+  }
+  const WorkspaceLibraryDb& db = mWs->getLibraryDb();
+  // name matches are ranked higher than description matches
+  EXPECT_EQ(QList<Uuid>({mResistor, mCapacitor}),
+            db.searchComponents("resistor"));
+  EXPECT_EQ(QList<Uuid>({mResistor}), db.searchComponents("resistor", 1));
+  EXPECT_EQ(QList<Uuid>({mResistor}), db.searchComponents("res 06"));
+  EXPECT_EQ(QList<Uuid>({mDiode}), db.searchComponents("zener"));
+  EXPECT_EQ(QList<Uuid>(), db.searchComponents("ener"));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchIgnoresPunctuation) {
+  const WorkspaceLibraryDb& db = mWs->getLibraryDb();
+  EXPECT_EQ(QList<Uuid>({mResistor}), db.searchComponents("res, (0603)"));
+  EXPECT_EQ(QList<Uuid>({mResistor}), db.searchComponents("\"res\" 06*"));
+  EXPECT_EQ(QList<Uuid>({mDiode}), db.searchComponents("zener-sod"));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testSearchWithoutFullTextIndex) {
+  dropFullTextIndex();
+  WorkspaceLibraryDb db(*mWs);
+  // same results as with the index, except the order
+  EXPECT_EQ(toSet({mResistor, mCapacitor}),
+            toSet(db.searchComponents("resistor")));
+  EXPECT_EQ(1, db.searchComponents("resistor", 1).count());
+  EXPECT_EQ(QList<Uuid>({mResistor}), db.searchComponents("res 06"));
+  EXPECT_EQ(QList<Uuid>({mResistor}), db.searchComponents("res, (0603)"));
+  EXPECT_EQ(QList<Uuid>({mDiode}), db.searchComponents("zener"));
+  EXPECT_EQ(QList<Uuid>({mDiode}), db.searchComponents("ZENER sod"));
+  EXPECT_EQ(QList<Uuid>(), db.searchComponents("ener"));
+  EXPECT_EQ(QList<Uuid>(), db.searchComponents("resistor zener"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb
@@ -0,0 +1,203 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/library/cat/componentcategory.h>
+#include <librepcb/library/library.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/workspace.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+namespace tests {
+
+using namespace library;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryScannerTest : public ::testing::Test {
+protected:
+  FilePath                       mWsDir;
+  QScopedPointer<Workspace>      mWs;
+  QScopedPointer<SQLiteDatabase> mDb;
+  FilePath                       mLibDir;
+  FilePath                       mCatDir;
+  Uuid                           mCat;
+
+  WorkspaceLibraryScannerTest() : mCat(Uuid::createRandom()) {
+    mWsDir = FilePath::getRandomTempPath();
+    Workspace::createNewWorkspace(mWsDir);  // can throw
+    mWs.reset(new Workspace(mWsDir));       // can throw
+    mDb.reset(new SQLiteDatabase(mWs->getLibraryDb().getFilePath()));
+
+    Library lib(Uuid::createRandom(), Version::fromString("0.1"), "test",
+                ElementName("Library"), "", "");
+    mLibDir = mWs->getLocalLibrariesPath().getPathTo("Test.lplib");
+    lib.saveTo(mLibDir);  // can throw
+    ComponentCategory cat(mCat, Version::fromString("0.1"), "test",
+                          ElementName("Category"), "", "");
+    cat.saveIntoParentDirectory(
+        mLibDir.getPathTo(ComponentCategory::getShortElementName()));
+    mCatDir = mLibDir.getPathTo(ComponentCategory::getShortElementName())
+                  .getPathTo(mCat.toStr());
+  }
+
+  virtual ~WorkspaceLibraryScannerTest() {
+    mDb.reset();
+    mWs.reset();
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  bool rescan() {
+    bool       succeeded = false;
+    QEventLoop loop;
+    QObject::connect(&mWs->getLibraryDb(), &WorkspaceLibraryDb::scanSucceeded,
+                     &loop, [&succeeded]() { succeeded = true; });
+    QObject::connect(&mWs->getLibraryDb(), &WorkspaceLibraryDb::scanFinished,
+                     &loop, &QEventLoop::quit);
+    QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+    mWs->getLibraryDb().startLibraryRescan();
+    loop.exec();
+    return succeeded;
+  }
+
+  int getRowCount(const QString& table) {
+    QSqlQuery query = mDb->prepareQuery("SELECT COUNT(*) FROM " % table);
+    mDb->exec(query);
+    return query.next() ? query.value(0).toInt() : -1;
+  }
+
+  int getCategoryId() {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT id FROM component_categories WHERE uuid = :uuid");
+    query.bindValue(":uuid", mCat.toStr());
+    mDb->exec(query);
+    return query.next() ? query.value(0).toInt() : -1;
+  }
+
+  QString getCategoryName(int id) {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT name FROM component_categories_tr WHERE cat_id = :id");
+    query.bindValue(":id", id);
+    mDb->exec(query);
+    return query.next() ? query.value(0).toString() : QString();
+  }
+
+  void setCategoryName(int id, const QString& name) {
+    QSqlQuery query = mDb->prepareQuery(
+        "UPDATE component_categories_tr SET name = :name WHERE cat_id = :id");
+    query.bindValue(":name", name);
+    query.bindValue(":id", id);
+    mDb->exec(query);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryScannerTest, testAddElement) {
+  ASSERT_TRUE(rescan());
+  EXPECT_EQ(1, getRowCount("libraries"));
+  int id = getCategoryId();
+  ASSERT_GE(id, 0);
+  EXPECT_EQ("Category", getCategoryName(id).toStdString());
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testUnchangedElementIsNotRewritten) {
+  ASSERT_TRUE(rescan());
+  int id = getCategoryId();
+  ASSERT_GE(id, 0);
+
+  // the row would be overwritten with the name from the file if the element
+  // was written to the database again
+  setCategoryName(id, "Marker");
+  ASSERT_TRUE(rescan());
+  EXPECT_EQ(id, getCategoryId());
+  EXPECT_EQ("Marker", getCategoryName(id).toStdString());
+
+  // if only the fingerprint differs, the content hash prevents a rewrite
+  mDb->exec("UPDATE component_categories SET file_mtime = 0");
+  ASSERT_TRUE(rescan());
+  EXPECT_EQ(id, getCategoryId());
+  EXPECT_EQ("Marker", getCategoryName(id).toStdString());
+  QSqlQuery query =
+      mDb->prepareQuery("SELECT file_mtime FROM component_categories");
+  mDb->exec(query);
+  ASSERT_TRUE(query.next());
+  EXPECT_NE(0, query.value(0).toLongLong());
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testModifiedElementIsUpdated) {
+  ASSERT_TRUE(rescan());
+  int id = getCategoryId();
+  ASSERT_GE(id, 0);
+
+  {
+    ComponentCategory cat(mCatDir, false);  // can throw
+    cat.setNames(LocalizedNameMap(ElementName("Renamed Category")));
+    cat.save();  // can throw
+  }
+  ASSERT_TRUE(rescan());
+  EXPECT_EQ(id, getCategoryId());  // the row is updated, not replaced
+  EXPECT_EQ("Renamed Category", getCategoryName(id).toStdString());
+  EXPECT_EQ(1, getRowCount("component_categories_tr"));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testRemovedElementIsDeleted) {
+  ASSERT_TRUE(rescan());
+  ASSERT_EQ(1, getRowCount("component_categories"));
+
+  ASSERT_TRUE(QDir(mCatDir.toStr()).removeRecursively());
+  ASSERT_TRUE(rescan());
+  EXPECT_EQ(1, getRowCount("libraries"));
+  EXPECT_EQ(0, getRowCount("component_categories"));
+  EXPECT_EQ(0, getRowCount("component_categories_tr"));
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testRemovedLibraryIsDeleted) {
+  ASSERT_TRUE(rescan());
+  ASSERT_EQ(1, getRowCount("libraries"));
+  ASSERT_EQ(1, getRowCount("component_categories"));
+
+  ASSERT_TRUE(QDir(mLibDir.toStr()).removeRecursively());
+  ASSERT_TRUE(rescan());
+  EXPECT_EQ(0, getRowCount("libraries"));
+  EXPECT_EQ(0, getRowCount("component_categories"));
+  EXPECT_EQ(0, getRowCount("component_categories_tr"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace workspace
+}  // namespace librepcb